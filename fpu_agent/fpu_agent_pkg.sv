@@ -32,9 +32,11 @@ package fpu_agent_pkg;
     import uvm_pkg::*;
     import fpu_common_pkg::*;
     import ariane_pkg::*;
+    import fpu_refmodel_pkg::*;
     `include "uvm_macros.svh"
 
    `include "fpu_txn.svh" 
+   `include "fpu_cov_steering.svh"
    `include "fpu_driver.svh"
    `include "fpu_sequencer.svh"
    `include "fpu_monitor.svh"
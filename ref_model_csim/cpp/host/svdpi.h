@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Minimal svdpi.h for the host build (TOOL=host), without simulator
+ *  History       :
+ */
+
+#ifndef INCLUDED_SVDPI
+#define INCLUDED_SVDPI
+
+#include <stdint.h>
+
+// Only the types of IEEE 1800 annex I used by dpiheader.h and fpu_dpi.h are defined, the model calls no service of the simulator
+
+#define DPI_DLLISPEC
+#define DPI_DLLESPEC
+
+typedef uint8_t svScalar;
+typedef svScalar svBit;
+typedef svScalar svLogic;
+
+#define sv_0 0
+#define sv_1 1
+#define sv_z 2
+#define sv_x 3
+
+typedef uint32_t svBitVecVal; /**< packed bit vector, 32 bits per element, LSB first */
+
+typedef struct
+{
+    uint32_t aval;
+    uint32_t bval;
+} svLogicVecVal;
+
+#define SV_PACKED_DATA_NELEMS(WIDTH) (((WIDTH) + 31) >> 5)
+
+typedef void* svScope;
+typedef void* svOpenArrayHandle;
+
+#endif // INCLUDED_SVDPI
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the evaluation of an operation in every rounding mode
+ *  History       :
+ */
+
+#ifndef FPU_ALL_RM_H_INCLUDED
+#define FPU_ALL_RM_H_INCLUDED
+
+#include <cstdint>
+#include "fpu_exec.h"
+
+/**
+ * \brief   Return true if \e op rounds its result, i.e. rm is a rounding mode and not a function selector
+ */
+bool fpu_all_rm_supported(int op);
+
+/**
+ * \brief   Compute the raw results and flags of a handler of fpu_exec in the five rounding modes
+ * \details When the operands and the result are finite, the operation is computed once by MPFR, with two more bits than
+ *          the destination precision, rounded toward zero then to odd, and with an unbounded exponent range. Each mode
+ *          is then rounded from this value with intfp_round. Otherwise (special operands, zero, infinite or NaN
+ *          results, and FCVT_F2I whose flags are the ones of the MPFR integer conversions), the handler is called for
+ *          RNE, RTZ, RDN and RUP, and RMM is deduced from them : it only differs from RNE on ties.
+ * \param   raw     Output variable. Raw results of the handler, indexed by rounding mode.
+ * \param   flags   Output variable. Exception flags, indexed by rounding mode.
+ * \param   op      Operation, fpu_all_rm_supported must be true
+ * \param   fmt     Destination format
+ * \param   ctx     Context of the handler, rm is ignored
+ */
+void fpu_all_rm_compute(uint64_t* raw, int* flags, int op, int fmt, const uint32_t* op1, const uint32_t* op2,
+                        const uint32_t* op3, const fpu_exec_ctx* ctx);
+
+/**
+ * \brief   Find the exact ties of a handler of fpu_exec, to check its results in RMM
+ * \details The operation is computed exactly by MPFR. It is a tie if it is the midpoint of \e down and \e up, the raw
+ *          results of the handler in RDN and RUP, or for FCVT_F2I whose results saturate, an odd multiple of 1/2.
+ *          Independent of intfp_round, see fpu_exec_rmm_expected.
+ * \param   down    Raw result of the handler in RDN
+ * \param   up      Raw result of the handler in RUP
+ * \param   ctx     Context of the handler, rm is ignored
+ * \return  RDN or RUP, the rounding mode which rounds the tie away from zero, or -1 if the result is not a tie
+ */
+int fpu_all_rm_tie(int op, uint64_t down, uint64_t up, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3,
+                   const fpu_exec_ctx* ctx);
+
+#endif // FPU_ALL_RM_H_INCLUDED
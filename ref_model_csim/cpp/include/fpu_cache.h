@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the in-process result cache of the reference model
+ *  History       :
+ */
+
+#ifndef FPU_CACHE_H_INCLUDED
+#define FPU_CACHE_H_INCLUDED
+
+#include <cstdint>
+
+#define FPU_CACHE_ENV_VAR       "REFMODEL_CACHE" /**< environment variable giving the number of entries of the cache */
+#define FPU_CACHE_MAX_PROBES    8                /**< number of slots visited before evicting the home slot of a key */
+
+/**
+ * \brief Key of the cache : every input of fpu_exec
+ */
+typedef struct
+{
+    uint64_t operand_a;
+    uint64_t operand_b;
+    uint64_t imm;
+    uint32_t ctrl;      /**< op[7:0], fmt[11:8], rm[15:12], xlen/32[19:16], flen/32[23:20] */
+} fpu_cache_key;
+
+/**
+ * \brief Counters of the cache, cumulated over all threads
+ */
+typedef struct
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+} fpu_cache_stats;
+
+/**
+ * \brief   Build the cache key of a request, see fpu_exec
+ */
+fpu_cache_key fpu_cache_make_key(int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int rm, int xlen, int flen);
+
+/**
+ * \brief   Hash of a cache key, also used by the persistent store
+ */
+uint64_t fpu_cache_key_hash(const fpu_cache_key* key);
+
+/**
+ * \brief   Enable the cache
+ * \details Each thread owns a table of \e entries slots (rounded up to a power of two), allocated on its first lookup.
+ *          Calling it again resizes and clears the tables. Also called at load time when REFMODEL_CACHE is set.
+ * \param   entries   Number of entries of the cache, 0 disables it
+ */
+void fpu_cache_enable(uint32_t entries);
+
+/**
+ * \brief   Return the number of entries of the cache, 0 if it is disabled
+ */
+uint32_t fpu_cache_capacity();
+
+/**
+ * \brief   Look a request up in the cache of the calling thread
+ * \param   key     Key of the request
+ * \param   result  Output variable. Cached result, written on hit only.
+ * \param   flags   Output variable. Cached flags, written on hit only.
+ * \return  true on hit
+ */
+bool fpu_cache_lookup(const fpu_cache_key* key, uint64_t* result, int* flags);
+
+/**
+ * \brief   Insert a computed request in the cache of the calling thread, evicting an entry if the probed slots are full
+ */
+void fpu_cache_insert(const fpu_cache_key* key, uint64_t result, int flags);
+
+/**
+ * \brief   Read the counters of the cache
+ */
+void fpu_cache_get_stats(fpu_cache_stats* stats);
+
+/**
+ * \brief   Clear the counters of the cache
+ */
+void fpu_cache_reset_stats();
+
+#endif // FPU_CACHE_H_INCLUDED
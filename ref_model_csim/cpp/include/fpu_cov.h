@@ -0,0 +1,242 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the functional coverage collector of the reference model
+ *  History       :
+ */
+
+#ifndef FPU_COV_H_INCLUDED
+#define FPU_COV_H_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include "fpu_exec.h"
+
+#define FPU_COV_ENV_VAR         "REFMODEL_COV"        /**< environment variable giving the path of the coverage database */
+#define FPU_COV_MAGIC           0x4244564F43555046ULL /**< "FPUCOVDB" */
+#define FPU_COV_VERSION         1
+#define FPU_COV_GROUP_NUM       (FPU_OP_NUM * FPU_DST_FMT_NUM) /**< one group of bins per (operation, destination format) pair */
+
+/*
+ * Every request evaluated through the DPI is sampled in the group of its (operation, destination format) pair. A
+ * group has the coverpoints of fpu_cov_point_e, each one a dense array of counters indexed by its bin. The sources
+ * of an operation are its floating point or integer operands in the order of the operation : operand_b and imm for
+ * FADD and FSUB, operand_a, operand_b and imm for the others. Operations which do not round (FCLASS, FMV_F2X,
+ * FMV_X2F) are sampled with rm 0 in the crosses with rm.
+ *
+ * Goals are the bins which can be hit by a request of the testbench (rounding modes RNE to RUP or legal function
+ * selectors, classes and flags that the operation can produce, ...). Closure is the fraction of the goals that were
+ * hit.
+ */
+
+/**
+ * \brief Classes of the operands and results
+ * \details Floating point classes are in the order of the FCLASS result bits. Integer classes are used by the integer
+ *          operand of FCVT_I2F and the integer results. INT_EXTREME is the minimum or maximum of the integer type,
+ *          the saturation values of FCVT_F2I.
+ */
+typedef enum
+{
+    FPU_COV_NEG_INF = 0,
+    FPU_COV_NEG_NORMAL,
+    FPU_COV_NEG_SUBNORMAL,
+    FPU_COV_NEG_ZERO,
+    FPU_COV_POS_ZERO,
+    FPU_COV_POS_SUBNORMAL,
+    FPU_COV_POS_NORMAL,
+    FPU_COV_POS_INF,
+    FPU_COV_SNAN,
+    FPU_COV_QNAN,
+    FPU_COV_INT_ZERO,
+    FPU_COV_INT_POS,
+    FPU_COV_INT_NEG,
+    FPU_COV_INT_EXTREME,
+    FPU_COV_CLASS_NUM = 16      /**< stride of the classes in the bins */
+} fpu_cov_class_e;
+
+/**
+ * \brief Rounding events, several events can be hit by a request
+ */
+typedef enum
+{
+    FPU_COV_EXACT = 0,          /**< NX clear, the result is not a NaN */
+    FPU_COV_INEXACT_EVEN,       /**< NX set, finite result with an even significand */
+    FPU_COV_INEXACT_ODD,        /**< NX set, finite result with an odd significand */
+    FPU_COV_BINADE,             /**< NX set, normal result with a zero trailing significand (rounded to a power of two) */
+    FPU_COV_MAX_FINITE,         /**< NX set, result is the largest finite magnitude */
+    FPU_COV_OVERFLOW_INF,       /**< OF set, result is an infinity */
+    FPU_COV_MIN_NORMAL,         /**< NX set, result is the smallest normal magnitude */
+    FPU_COV_TINY,               /**< NX set, result is subnormal or zero */
+    FPU_COV_ROUND_NUM
+} fpu_cov_round_e;
+
+#define FPU_COV_EXP_NUM     16   /**< exponent buckets : zero or subnormal, emin, 12 linear buckets, emax, infinity or NaN */
+#define FPU_COV_ALIGN_NUM   128  /**< exponent differences -63 to 64 */
+#define FPU_COV_ALIGN_ZERO  63   /**< bin of a zero exponent difference */
+#define FPU_COV_MAX_BINS    4096 /**< number of bins of the largest coverpoint, SOURCES */
+
+/**
+ * \brief Coverpoints of a group
+ */
+typedef enum
+{
+    FPU_COV_RM = 0,             /**< rm field, 8 bins */
+    FPU_COV_SOURCES,            /**< cross of the source classes, bin class0 + 16 * class1 + 256 * class2 */
+    FPU_COV_RESULT,             /**< cross of rm and the result class, bin rm * 16 + class */
+    FPU_COV_FLAGS,              /**< cross of rm and the exception flags, bin rm * 32 + flags */
+    FPU_COV_EXPONENT,           /**< exponent bucket of each floating point source and of the result, bin slot * 16 +
+                                     bucket, the result is slot 3 */
+    FPU_COV_ALIGNMENT,          /**< exponent difference of the addends of FADD, FSUB and the fused operations (product
+                                     minus addend), bin difference + 63, saturated */
+    FPU_COV_ROUNDING,           /**< cross of rm and the rounding events, bin rm * 8 + event */
+    FPU_COV_POINT_NUM
+} fpu_cov_point_e;
+
+/**
+ * \brief Hits of the goals of a set of groups and coverpoints
+ */
+typedef struct
+{
+    uint64_t goals;             /**< number of goal bins */
+    uint64_t hits;              /**< number of goal bins hit at least once */
+    uint64_t samples;           /**< number of sampled requests of the groups */
+} fpu_cov_closure;
+
+extern std::atomic<bool> fpu_cov_on;
+
+/**
+ * \brief   Enable or disable the sampling
+ * \details Also enabled by fpu_cov_open. Disabled coverage costs a load per call.
+ */
+void fpu_cov_enable(bool enable);
+
+/**
+ * \brief   Return true if the requests are sampled
+ */
+static inline bool fpu_cov_enabled()
+{
+    return fpu_cov_on.load(std::memory_order_relaxed);
+}
+
+/**
+ * \brief   Sample an evaluated request in the counters of the calling thread
+ * \details Operands narrower than \e xlen are NaN-box checked as fpu_exec does, unsupported requests are not sampled.
+ * \param   op, operand_a, operand_b, imm, fmt, rm  Fields of the request, see fpu_exec
+ * \param   xlen    Integer register width, 0 if the operands are not NaN-boxed
+ * \param   result  Result of the request, only the bits of the destination format or integer are read
+ * \param   flags   Exception flags, -1 if the request is not supported
+ */
+void fpu_cov_record(int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int rm, int xlen,
+                    uint64_t result, int flags);
+
+/**
+ * \brief   Return the name of a coverpoint
+ */
+const char* fpu_cov_point_name(int point);
+
+/**
+ * \brief   Return the number of bins of a coverpoint
+ */
+int fpu_cov_point_size(int point);
+
+/**
+ * \brief   Return true if \e bin of \e point is a goal of the group of (\e op, \e fmt)
+ */
+bool fpu_cov_goal(int op, int fmt, int point, int bin);
+
+/**
+ * \brief   Write the description of a bin, "rm=1 result=+subnormal" for instance
+ * \return  \e out
+ */
+const char* fpu_cov_bin_name(char* out, size_t size, int op, int point, int bin);
+
+/**
+ * \brief   Return the hit count of a bin, summed over all threads and the loaded databases
+ */
+uint64_t fpu_cov_count(int op, int fmt, int point, int bin);
+
+/**
+ * \brief   Read the closure of a set of groups and coverpoints
+ * \param   op, fmt, point   Selection, -1 selects every value
+ */
+void fpu_cov_get_closure(fpu_cov_closure* closure, int op, int fmt, int point);
+
+/**
+ * \brief   Return the first goal of \e point in the group of (\e op, \e fmt) that was not hit, starting at \e bin
+ * \return  Bin, or -1 if every goal from \e bin on was hit
+ */
+int fpu_cov_next_unhit(int op, int fmt, int point, int bin);
+
+/**
+ * \brief   List the goals of \e point in the group of (\e op, \e fmt) that were not hit
+ * \details Reads the counters once, where walking the bins with fpu_cov_next_unhit reads them for every bin.
+ * \param   bins    Output array. Unhit bins in increasing order, at most \e size of them.
+ * \return  Number of bins written
+ */
+int fpu_cov_unhit_bins(int op, int fmt, int point, int* bins, int size);
+
+/**
+ * \brief   Clear the counters of all threads, the loaded databases are kept
+ */
+void fpu_cov_reset();
+
+/**
+ * \brief   Enable the sampling and select the database written by fpu_cov_save
+ * \details Also called at load time when REFMODEL_COV is set, the database is then saved at exit. The file is only
+ *          accessed by fpu_cov_save.
+ * \return  0
+ */
+int fpu_cov_open(const char* path);
+
+/**
+ * \brief   Add the counts sampled since the previous save to the database
+ * \details The database is a file mapped in memory, a header followed by the counters of every group. It is created
+ *          if needed, and locked while the counts are added so that the parallel simulations of a regression can
+ *          share it. A process counts as one run of the database, nothing is written if no request was sampled.
+ * \return  0, -1 if no database is opened or it cannot be written
+ */
+int fpu_cov_save();
+
+/**
+ * \brief   Add the counts of a database to the counts read by the queries
+ * \details Lets a simulation see the coverage of the previous ones, the loaded counts are never saved.
+ * \return  0, -1 if the file is not a coverage database
+ */
+int fpu_cov_load(const char* path);
+
+/**
+ * \brief   Add the counts of the database \e src to the database \e dst, created if needed
+ * \return  0, -1 if a file cannot be read or written
+ */
+int fpu_cov_merge(const char* dst, const char* src);
+
+/**
+ * \brief   Print the closure of every group sampled at least once, then the closure of all the groups
+ * \param   out         Stream of the table, NULL to only write the JSON file
+ * \param   json_path   JSON file written with one object per group, listing the bins that were not hit, NULL or
+ *                      empty to skip it
+ * \return  0, -1 if the JSON file cannot be written
+ */
+int fpu_cov_report(FILE* out, const char* json_path);
+
+#endif // FPU_COV_H_INCLUDED
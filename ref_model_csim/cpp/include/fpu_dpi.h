@@ -0,0 +1,374 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the DPI entries of the model which are not in the Questa-generated dpiheader.h
+ *  History       :
+ */
+
+#ifndef FPU_DPI_H_INCLUDED
+#define FPU_DPI_H_INCLUDED
+
+#include "dpiheader.h"
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_fpu_exec(
+    int64_t operation,
+    int64_t operand_a,
+    int64_t operand_b,
+    int64_t imm,
+    int64_t fmt,
+    int64_t rm,
+    int xlen,
+    int flen,
+    int* flags);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_fpu_exec_all_rm(
+    int64_t operation,
+    int64_t operand_a,
+    int64_t operand_b,
+    int64_t imm,
+    int64_t fmt,
+    int xlen,
+    int flen,
+    int64_t* result,
+    int* flags);
+
+DPI_LINK_DECL DPI_DLLESPEC
+void
+dpi_refmodel_cache_enable(
+    int entries);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_cache_capacity();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_cache_hits();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_cache_misses();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_cache_evictions();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_store_open(
+    const char* path,
+    int entries);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_store_enabled();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_store_hits();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_store_misses();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_store_inserts();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_store_evictions();
+
+DPI_LINK_DECL DPI_DLLESPEC
+void
+dpi_refmodel_stats_enable(
+    int enable);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_stats_enabled();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_report(
+    const char* json_path);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_trace_open(
+    const char* path,
+    int compress);
+
+DPI_LINK_DECL DPI_DLLESPEC
+void
+dpi_refmodel_trace_close();
+
+DPI_LINK_DECL DPI_DLLESPEC
+void
+dpi_refmodel_trace_context(
+    int64_t trans_id,
+    int64_t sim_time);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_cov_open(
+    const char* path);
+
+DPI_LINK_DECL DPI_DLLESPEC
+void
+dpi_refmodel_cov_enable(
+    int enable);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_cov_enabled();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_cov_save();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_cov_load(
+    const char* path);
+
+DPI_LINK_DECL DPI_DLLESPEC
+double
+dpi_refmodel_cov_closure(
+    int op,
+    int fmt,
+    int point);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_cov_count(
+    int op,
+    int fmt,
+    int point,
+    int bin);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_cov_next_unhit(
+    int op,
+    int fmt,
+    int point,
+    int bin);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_cov_unhit(
+    int op,
+    int fmt,
+    int point);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_cov_unhit_bins(
+    int op,
+    int fmt,
+    int point,
+    int* bins);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_cov_report(
+    const char* json_path);
+
+DPI_LINK_DECL DPI_DLLESPEC
+void
+dpi_fpu_gen_seed(
+    int64_t seed);
+
+DPI_LINK_DECL DPI_DLLESPEC
+void
+dpi_fpu_gen_weights(
+    const int* class_w,
+    const int* mant_w,
+    const int* int_w);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_fpu_gen_float(
+    const env_t* env);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_fpu_gen_float_of(
+    const env_t* env,
+    int cls,
+    int mant);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_fpu_gen_corner(
+    const env_t* env,
+    int corner);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_fpu_gen_int();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_fpu_hard_operands(
+    int op,
+    const env_t* env,
+    int hard,
+    int64_t* operand_a,
+    int64_t* operand_b,
+    int64_t* imm);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_fpu_golden_open(
+    const char* path,
+    int xlen,
+    int flen);
+
+DPI_LINK_DECL DPI_DLLESPEC
+void
+dpi_fpu_golden_close();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_fpu_golden_count();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_fpu_golden_request(
+    int64_t index,
+    int* op,
+    int64_t* operand_a,
+    int64_t* operand_b,
+    int64_t* imm,
+    int* fmt,
+    int* rm,
+    int* delay);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_fpu_golden_expected(
+    int64_t index,
+    int64_t* result,
+    int* flags);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_fpu_golden_recorded();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_fpu_golden_trans_id(
+    int64_t index);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_fpu_golden_record_open(
+    const char* path,
+    int xlen,
+    int flen);
+
+DPI_LINK_DECL DPI_DLLESPEC
+void
+dpi_fpu_golden_record(
+    int op,
+    int64_t operand_a,
+    int64_t operand_b,
+    int64_t imm,
+    int fmt,
+    int rm,
+    int64_t trans_id,
+    int delay);
+
+DPI_LINK_DECL DPI_DLLESPEC
+void
+dpi_fpu_golden_record_close();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_novelty_open(
+    const char* path,
+    int64_t entries);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_refmodel_novelty_enabled();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_fpu_novelty_resample(
+    int op,
+    int64_t operand_a,
+    int64_t operand_b,
+    int64_t imm,
+    int fmt,
+    int rm,
+    int xlen,
+    int flen,
+    int percent);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int
+dpi_fpu_novelty_insert(
+    int op,
+    int64_t operand_a,
+    int64_t operand_b,
+    int64_t imm,
+    int fmt,
+    int rm,
+    int xlen,
+    int flen);
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_novelty_lookups();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_novelty_hits();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_novelty_resamples();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_novelty_inserts();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_novelty_novel();
+
+DPI_LINK_DECL DPI_DLLESPEC
+int64_t
+dpi_refmodel_novelty_count();
+
+DPI_LINK_DECL DPI_DLLESPEC
+double
+dpi_refmodel_novelty_fill();
+
+#endif // FPU_DPI_H_INCLUDED
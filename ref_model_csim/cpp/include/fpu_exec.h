@@ -0,0 +1,213 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the opcode-dispatched entry point of the reference model
+ *  History       :
+ */
+
+#ifndef FPU_EXEC_H_INCLUDED
+#define FPU_EXEC_H_INCLUDED
+
+#include <gmp.h>
+#include <mpfr.h>
+#include <cstdint>
+#include "memory.h"
+
+//########## OPCODES AND FORMATS #######################################################################################
+
+/**
+ * \brief Operations of the reference model
+ * \details Mirrored by fpu_op_e in fpu_refmodel_pkg.sv, both lists must be kept in the same order
+ */
+typedef enum
+{
+    FPU_OP_FADD = 0,
+    FPU_OP_FSUB,
+    FPU_OP_FMUL,
+    FPU_OP_FDIV,
+    FPU_OP_FMADD,
+    FPU_OP_FNMADD,
+    FPU_OP_FMSUB,
+    FPU_OP_FNMSUB,
+    FPU_OP_FCMP,
+    FPU_OP_FSQRT,
+    FPU_OP_FMIN_MAX,
+    FPU_OP_FSGNJ,
+    FPU_OP_FCVT_F2I,
+    FPU_OP_FCVT_I2F,
+    FPU_OP_FCVT_F2F,
+    FPU_OP_FCLASS,
+    FPU_OP_FMV_F2X,
+    FPU_OP_FMV_X2F,
+    FPU_OP_NUM
+} fpu_op_e;
+
+/**
+ * \brief Floating point formats, encoded as the fmt field of the FPU request (fpnew_pkg::fp_format_e)
+ * \details The source format of FCVT_F2F is read from imm[2:0], where FP16ALT is encoded as 3'b110
+ */
+typedef enum
+{
+    FPU_FMT_FP32    = 0,
+    FPU_FMT_FP64    = 1,
+    FPU_FMT_FP16    = 2,
+    FPU_FMT_FP8     = 3,
+    FPU_FMT_FP16ALT = 6,
+    FPU_FMT_NUM     = 8 /**< size of the 3-bit format code space */
+} fpu_fmt_e;
+
+#define FPU_DST_FMT_NUM 4 /**< number of destination formats, fmt field is 2 bits wide */
+
+#define FP8_ENV_INITIALIZER     { .bis = 8-1, .es = 5-1 }  /**< Initialise an environment to the 8 bits format of the FPU : 5 bits for the exponent and 2 explicit bits of significand */
+#define FP16ALT_ENV_INITIALIZER { .bis = 16-1, .es = 8-1 } /**< Initialise an environment to the 16 bits alternative format of the FPU (bfloat16) : 8 bits for the exponent and 7 explicit bits of significand */
+
+/**
+ * \brief Description of a floating point format code
+ */
+typedef struct
+{
+    bool        valid; /**< false if the code does not encode a supported format */
+    uint8_t     width; /**< bit size of the format */
+    environment env;   /**< variable precision environment of the format */
+} fpu_fmt_desc;
+
+/**
+ * \brief   Return the description of the format encoded by \e fmt
+ * \param   fmt   3-bit format code, see fpu_fmt_e
+ */
+const fpu_fmt_desc* fpu_fmt_get_desc(int fmt);
+
+/**
+ * \brief   Return the format code of \e env, or -1 if \e env is not a format of the FPU
+ */
+int fpu_fmt_from_env(environment env);
+
+/**
+ * \brief   Return the name of the operation \e op
+ */
+const char* fpu_op_name(int op);
+
+/**
+ * \brief   Return the name of the format encoded by \e fmt
+ */
+const char* fpu_fmt_name(int fmt);
+
+//########## ROUNDING MODES ############################################################################################
+
+/**
+ * \brief   Align RTL rounding mode with that of MPFR
+ * \details RTL encoding is the RISC-V one : RNE, RTZ, RDN, RUP, RMM. RMM gives MPFR_RNDNA, which the operations of
+ *          operations.h do not support : fpu_exec never passes it to them.
+ */
+mpfr_rnd_t rnd_rtl_to_c(int rnd_rtl);
+
+//########## DISPATCH ##################################################################################################
+
+/**
+ * \brief Operation context, decoded from the FPU request once per call
+ */
+typedef struct
+{
+    environment dst_env;    /**< environment of the destination format (fmt) */
+    environment src_env;    /**< environment of the source format (imm[2:0]), used by FCVT_F2F */
+    int         rm;         /**< RTL rounding mode, also used as an operation modifier (FCMP, FMIN_MAX, FSGNJ) */
+    int         is_signed;  /**< integer conversions : 1 if the integer is signed */
+    int         int_format; /**< integer conversions : 0 for INT32, 1 for INT64 */
+    int         nchunks;    /**< number of 32-bits chunks in an integer register */
+} fpu_exec_ctx;
+
+/**
+ * \brief   Handler of an (operation, destination format) pair
+ * \param   result  Output variable. Raw result of the operation, before NaN-boxing. Cleared by the caller.
+ * \param   op1     First operand, operand_a of the request after the NaN-box check
+ * \param   op2     Second operand, operand_b of the request after the NaN-box check
+ * \param   op3     Third operand, imm of the request after the NaN-box check
+ * \param   ctx     Operation context
+ * \return  Exception flags
+ */
+typedef int (*fpu_exec_fn)(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+
+/**
+ * \brief   Return the handler of \e op for the destination format \e fmt, NULL if the pair is not supported
+ */
+fpu_exec_fn fpu_exec_get_handler(int op, int fmt);
+
+/**
+ * \brief   Compute the expected response of the FPU to a request
+ * \details Performs the whole checking flow of the testbench on the raw fields of the request : NaN-box check
+ *          of the operands (replaced by the canonical NaN of the source format when not boxed), decoding of the
+ *          environments and of the integer conversion modifiers, dispatch on the (operation, format) handler,
+ *          then NaN-boxing or sign extension of the result. Operations which round are rounded to RMM by
+ *          fpu_all_rm, with intfp_round, in every format. Results are looked up in the cache then in the persistent
+ *          store first when they are enabled, see fpu_cache.h and fpu_store.h.
+ * \param   result      Output variable. Expected result, as read on the FLen-bit result port.
+ * \param   op          Operation, see fpu_op_e
+ * \param   operand_a   operand_a field of the request
+ * \param   operand_b   operand_b field of the request
+ * \param   imm         imm field of the request
+ * \param   fmt         fmt field of the request (2 bits)
+ * \param   rm          rm field of the request (3 bits)
+ * \param   xlen        Integer register width of the core, 32 or 64
+ * \param   flen        Floating point register width of the core, 32 or 64
+ * \return  Exception flags, -1 if the request is not supported
+ */
+int fpu_exec(uint64_t* result, int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int rm, int xlen, int flen);
+
+/**
+ * \brief   Same as fpu_exec, without going through the cache and the store
+ */
+int fpu_exec_compute(uint64_t* result, int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int rm, int xlen, int flen);
+
+//########## ALL ROUNDING MODES ########################################################################################
+
+#define FPU_RM_NUM 5 /**< rounding modes RNE, RTZ, RDN, RUP and RMM, indexed by their RTL encoding */
+
+/**
+ * \brief Results of a request in every rounding mode
+ */
+typedef struct
+{
+    uint64_t result[FPU_RM_NUM];
+    int      flags[FPU_RM_NUM];
+} fpu_all_rm_record;
+
+/**
+ * \brief   Execute a request in the five rounding modes
+ * \details The operation is computed once, rounded to odd with two extra bits, then rounded to each mode (see
+ *          fpu_all_rm.h). Results and flags are the ones of fpu_exec_compute with the corresponding rm. Not cached.
+ * \param   record  Output variable. Results and flags indexed by rounding mode.
+ * \return  0, or -1 if the request is not supported or \e op does not round (FCMP, FMIN_MAX, FSGNJ, ... use rm as a
+ *          function selector)
+ */
+int fpu_exec_all_rm(fpu_all_rm_record* record, int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int xlen, int flen);
+
+/**
+ * \brief   Compute the expected RMM response of the FPU to a request, to check fpu_exec_compute
+ * \details RMM gives the result and the flags of RNE, except on the exact ties where it gives the ones of RDN or RUP,
+ *          away from zero. The handler is called in RNE, RDN and RUP and ties are found with fpu_all_rm_tie,
+ *          independently of intfp_round. Not cached.
+ * \param   result  Output variable. Expected result in RMM.
+ * \return  Exception flags, -1 if the request is not supported or \e op does not round
+ */
+int fpu_exec_rmm_expected(uint64_t* result, int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int xlen, int flen);
+
+#endif // FPU_EXEC_H_INCLUDED
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the exhaustive tables of the FP8 binary operations
+ *  History       :
+ */
+
+#ifndef FPU_FP8_TABLE_H_INCLUDED
+#define FPU_FP8_TABLE_H_INCLUDED
+
+#include <cstdint>
+#include "fpu_exec.h"
+
+#define FPU_FP8_TABLE_ENV_VAR   "REFMODEL_FP8_TABLES" /**< environment variable giving the path of a precomputed table file */
+#define FPU_FP8_TABLE_RM_NUM    4                     /**< rounding modes of the arithmetic tables : RNE, RTZ, RDN, RUP */
+#define FPU_FP8_TABLE_SIZE      (1 << 16)             /**< entries of a table, indexed by op1 | op2 << 8 */
+
+/**
+ * \brief Tables, an arithmetic operation has one table per rounding mode
+ */
+typedef enum
+{
+    FP8_TABLE_ADD = 0,
+    FP8_TABLE_SUB = FP8_TABLE_ADD + FPU_FP8_TABLE_RM_NUM,
+    FP8_TABLE_MUL = FP8_TABLE_SUB + FPU_FP8_TABLE_RM_NUM,
+    FP8_TABLE_DIV = FP8_TABLE_MUL + FPU_FP8_TABLE_RM_NUM,
+    FP8_TABLE_MIN = FP8_TABLE_DIV + FPU_FP8_TABLE_RM_NUM,
+    FP8_TABLE_MAX,
+    FP8_TABLE_LEQ,
+    FP8_TABLE_LT,
+    FP8_TABLE_EQ,
+    FP8_TABLE_NUM
+} fpu_fp8_table_e;
+
+#define FP8_TABLE_ENTRY(result, flags)  ((uint16_t) (((result) & 0xFF) | ((flags) << 8))) /**< result[7:0], flags[12:8] */
+#define FP8_TABLE_RESULT(entry)         ((entry) & 0xFF)
+#define FP8_TABLE_FLAGS(entry)          ((entry) >> 8)
+
+/**
+ * \brief   Return the name of a table, e.g. "ADD.RNE"
+ */
+const char* fpu_fp8_table_name(int table);
+
+/**
+ * \brief   Compute an entry with the MPFR operations of operations.h
+ */
+uint16_t fpu_fp8_table_mpfr(int table, uint8_t op1, uint8_t op2);
+
+/**
+ * \brief   Compute an entry with the integer operations of intfp.h
+ */
+uint16_t fpu_fp8_table_intfp(int table, uint8_t op1, uint8_t op2);
+
+/**
+ * \brief   Return the FPU_FP8_TABLE_SIZE entries of \e table
+ * \details The table is computed on its first use, with MPFR, unless it was loaded from a file.
+ *          Thread-safe.
+ */
+const uint16_t* fpu_fp8_table_get(int table);
+
+/**
+ * \brief   Load every table from a file written by fpu_fp8_table_save
+ * \details The file is rejected if it was written by another model (see fpu_store_model_hash). Also called at load time
+ *          when REFMODEL_FP8_TABLES is set.
+ * \return  0 on success, -1 otherwise (the tables are then computed on first use)
+ */
+int fpu_fp8_table_load(const char* path);
+
+/**
+ * \brief   Compute every table and write them to a file
+ * \return  0 on success, -1 otherwise
+ */
+int fpu_fp8_table_save(const char* path);
+
+/**
+ * \brief   FP8 handlers of fpu_exec, see fpu_exec_fn
+ * \details Additions, subtractions, multiplications, divisions, minimum, maximum and comparisons read the tables,
+ *          the fused operations use intfp.h. RMM is not handled here, fpu_exec rounds it with fpu_all_rm.
+ */
+int fpu_fp8_exec_fadd    (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+int fpu_fp8_exec_fsub    (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+int fpu_fp8_exec_fmul    (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+int fpu_fp8_exec_fdiv    (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+int fpu_fp8_exec_fmadd   (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+int fpu_fp8_exec_fnmadd  (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+int fpu_fp8_exec_fmsub   (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+int fpu_fp8_exec_fnmsub  (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+int fpu_fp8_exec_fcmp    (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+int fpu_fp8_exec_fmin_max(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+
+#endif // FPU_FP8_TABLE_H_INCLUDED
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the operand generator of the reference model
+ *  History       :
+ */
+
+#ifndef FPU_GEN_H_INCLUDED
+#define FPU_GEN_H_INCLUDED
+
+#include <cstdint>
+#include "memory.h"
+
+/*
+ * The generator draws the operands of the testbench without the constraint solver. It follows the distributions of
+ * fpu_txn : a class per floating point operand, a mantissa configuration for subnormal and normal operands, and a
+ * type per integer operand, each one drawn with its weight. The classes are exact, a QNAN operand is a quiet NaN, an
+ * SNAN operand a signaling NaN and a NORMAL operand has a normal exponent. The sign is uniform. The random numbers
+ * are a xoshiro256** sequence, a generator seeded with the same value draws the same operands.
+ */
+
+/**
+ * \brief Classes of the floating point operands, in the order of fp_op_type_e of fpu_txn, followed by the corner values
+ */
+typedef enum
+{
+    FPU_GEN_INF = 0,
+    FPU_GEN_ZERO,
+    FPU_GEN_SNAN,
+    FPU_GEN_QNAN,
+    FPU_GEN_SUBNORMAL,
+    FPU_GEN_NORMAL,
+    FPU_GEN_CORNER,             /**< one of the corner values of the format, see fpu_gen_corner_e */
+    FPU_GEN_CLASS_NUM
+} fpu_gen_class_e;
+
+/**
+ * \brief Trailing significand of the subnormal and normal operands, in the order of mant_cfg_e of fpu_txn
+ */
+typedef enum
+{
+    FPU_GEN_ALL_ZEROS = 0,
+    FPU_GEN_ALL_ONES,
+    FPU_GEN_WALKING_ONE,        /**< a single bit set */
+    FPU_GEN_WALKING_ZERO,       /**< a single bit clear */
+    FPU_GEN_RANDOM,
+    FPU_GEN_MANT_NUM
+} fpu_gen_mant_e;
+
+/**
+ * \brief Integer operands, in the order of int_type_cfg_e of fpu_txn
+ */
+typedef enum
+{
+    FPU_GEN_BOUND_VALUES = 0,   /**< minimum or maximum of the 32 and 64 bits integers, or zero */
+    FPU_GEN_RANDOM_INT,
+    FPU_GEN_INT_NUM
+} fpu_gen_int_e;
+
+/**
+ * \brief Corner values of a format, positive
+ */
+typedef enum
+{
+    FPU_GEN_MIN_SUBNORMAL = 0,
+    FPU_GEN_MAX_SUBNORMAL,
+    FPU_GEN_MIN_NORMAL,
+    FPU_GEN_MIN_NORMAL_PLUS_ULP,
+    FPU_GEN_MAX_NORMAL_MINUS_ULP,
+    FPU_GEN_MAX_NORMAL,
+    FPU_GEN_ONE_MINUS_ULP,
+    FPU_GEN_ONE,
+    FPU_GEN_ONE_PLUS_ULP,
+    FPU_GEN_CORNER_NUM
+} fpu_gen_corner_e;
+
+/**
+ * \brief State of a generator : random sequence and weights of the distributions
+ */
+typedef struct
+{
+    uint64_t s[4];                          /**< xoshiro256** state */
+    uint32_t class_w[FPU_GEN_CLASS_NUM];    /**< weight of each class of fpu_gen_class_e */
+    uint32_t mant_w[FPU_GEN_MANT_NUM];      /**< weight of each mantissa configuration of fpu_gen_mant_e */
+    uint32_t int_w[FPU_GEN_INT_NUM];        /**< weight of each integer type of fpu_gen_int_e */
+} fpu_gen;
+
+/**
+ * \brief   Seed a generator and set the default weights of fpu_txn, no corner value
+ */
+void fpu_gen_init(fpu_gen* gen, uint64_t seed);
+
+/**
+ * \brief   Set the weights of the distributions
+ * \param   class_w, mant_w, int_w  Arrays of FPU_GEN_CLASS_NUM, FPU_GEN_MANT_NUM and FPU_GEN_INT_NUM weights, NULL
+ *                                  keeps the current ones. A distribution with only zero weights draws its first value.
+ */
+void fpu_gen_set_weights(fpu_gen* gen, const uint32_t* class_w, const uint32_t* mant_w, const uint32_t* int_w);
+
+/**
+ * \brief   Return the next 64 random bits of a generator
+ */
+uint64_t fpu_gen_next(fpu_gen* gen);
+
+/**
+ * \brief   Return the positive corner value \e corner of the format \e env
+ */
+uint64_t fpu_gen_corner(environment env, int corner);
+
+/**
+ * \brief   Draw a floating point operand of a given class and mantissa configuration
+ * \details \e mant is only read for the subnormal and normal classes. An ALL_ZEROS subnormal is a zero, as in
+ *          fpu_txn.
+ * \param   env     Format of the operand, up to 64 bits
+ * \param   cls     Class, see fpu_gen_class_e
+ * \param   mant    Mantissa configuration, see fpu_gen_mant_e
+ * \return  Encoding of the operand in the low bits
+ */
+uint64_t fpu_gen_float_of(fpu_gen* gen, environment env, int cls, int mant);
+
+/**
+ * \brief   Draw a floating point operand, its class and mantissa configuration drawn with the weights of \e gen
+ */
+uint64_t fpu_gen_float(fpu_gen* gen, environment env);
+
+/**
+ * \brief   Draw an integer operand of a given type
+ */
+uint64_t fpu_gen_int_of(fpu_gen* gen, int type);
+
+/**
+ * \brief   Draw an integer operand, its type drawn with the weights of \e gen
+ */
+uint64_t fpu_gen_int(fpu_gen* gen);
+
+#endif // FPU_GEN_H_INCLUDED
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the golden-vector files of the testbench
+ *  History       :
+ */
+
+#ifndef FPU_GOLDEN_H_INCLUDED
+#define FPU_GOLDEN_H_INCLUDED
+
+#include <cstdint>
+
+#define FPU_GOLDEN_MAGIC    0x4E444C4F47555046ULL     /**< "FPUGOLDN" */
+#define FPU_GOLDEN_VERSION  1
+#define FPU_GOLDEN_RECORDED 0x1                       /**< header flag : stream recorded by a simulation, see below */
+#define FPU_GOLDEN_OPEN     (~0ULL)                   /**< nrecords of a recording that was not closed */
+
+/*
+ * A golden-vector file is a header followed by its records. A record holds the fields of a request of the testbench
+ * and the response expected from the model, so that a simulation replaying the file neither randomizes nor calls the
+ * model. The file is read through a read-only mapping.
+ *
+ * A recorded stream has the same layout and the FPU_GOLDEN_RECORDED flag. Its records are the transactions driven
+ * by a simulation, in order, with their transaction id and delay; their result and flags are not set. A recording
+ * that did not end has FPU_GOLDEN_OPEN records, every complete record of the file is then read.
+ */
+
+/**
+ * \brief Header of a golden-vector file
+ */
+typedef struct
+{
+    uint64_t magic;             /**< FPU_GOLDEN_MAGIC */
+    uint32_t version;           /**< FPU_GOLDEN_VERSION */
+    uint32_t record_size;       /**< sizeof(fpu_golden_record) */
+    uint64_t nrecords;
+    uint16_t xlen;              /**< integer register width the expectations were computed for */
+    uint16_t flen;              /**< floating point register width the expectations were computed for */
+    uint32_t flags;             /**< FPU_GOLDEN_RECORDED */
+    uint64_t seed;              /**< seed of the generator, informative only */
+    uint64_t model_hash;        /**< fpu_store_model_hash of the generating library */
+    char     model[32];         /**< fpu_store_model_version */
+    char     mpfr[16];          /**< MPFR version */
+    char     gmp[16];           /**< GMP version */
+    uint8_t  reserved[144];
+} fpu_golden_header;
+
+/**
+ * \brief A request and its expected response
+ */
+typedef struct
+{
+    uint64_t operand_a;         /**< operand_a field */
+    uint64_t operand_b;         /**< operand_b field */
+    uint64_t imm;               /**< imm field */
+    uint64_t result;            /**< expected result, as read on the FLen-bit result port */
+    uint8_t  op;                /**< fpu_op_e */
+    uint8_t  fmt;               /**< fmt field */
+    uint8_t  rm;                /**< rm field */
+    uint8_t  flags;             /**< expected exception flags */
+    uint32_t delay;             /**< clock cycles before the request is driven */
+    uint64_t trans_id;          /**< recorded streams : transaction id of the request */
+} fpu_golden_record;
+
+static_assert(sizeof(fpu_golden_record) == 48, "golden record size is part of the format");
+static_assert(sizeof(fpu_golden_header) == 256, "golden header size is part of the format");
+
+/**
+ * \brief   Write a golden-vector file
+ * \details The header is filled with the widths, the seed and the version of the model.
+ * \param   path       Path of the file
+ * \param   records    Records of the file, their expectations computed by fpu_exec with \e xlen and \e flen
+ * \param   nrecords   Number of records
+ * \return  0 on success, -1 otherwise
+ */
+int fpu_golden_write(const char* path, const fpu_golden_record* records, uint64_t nrecords, int xlen, int flen,
+                     uint64_t seed);
+
+/**
+ * \brief   Create a recorded stream and start recording
+ * \details A recording already opened is closed first. The records are buffered, the stream is closed at exit.
+ * \param   path       Path of the file
+ * \param   xlen       Integer register width of the core
+ * \param   flen       Floating point register width of the core
+ * \return  0 on success, -1 otherwise
+ */
+int fpu_golden_record_open(const char* path, int xlen, int flen);
+
+/**
+ * \brief   Append a record to the recorded stream, ignored when no stream is recorded
+ */
+void fpu_golden_record_write(const fpu_golden_record* record);
+
+/**
+ * \brief   Write the buffered records and the number of records, and close the recorded stream
+ */
+void fpu_golden_record_close();
+
+/**
+ * \brief   Return true if a stream is recorded
+ */
+bool fpu_golden_recording();
+
+/**
+ * \brief   Map a golden-vector file for reading
+ * \details A file already mapped is unmapped first.
+ * \param   path       Path of the file
+ * \param   xlen       Integer register width of the core, the file must have been generated for it, 0 for any
+ * \param   flen       Floating point register width of the core, the file must have been generated for it, 0 for any
+ * \return  0 on success, 1 if the expectations of the file were computed by another version of the model (it is
+ *          mapped, its expectations may be stale), -1 otherwise
+ */
+int fpu_golden_open(const char* path, int xlen, int flen);
+
+/**
+ * \brief   Unmap the golden-vector file
+ */
+void fpu_golden_close();
+
+/**
+ * \brief   Return the header of the mapped file, NULL if no file is mapped
+ */
+const fpu_golden_header* fpu_golden_get_header();
+
+/**
+ * \brief   Return the number of records of the mapped file, 0 if no file is mapped
+ */
+uint64_t fpu_golden_count();
+
+/**
+ * \brief   Return the record \e index of the mapped file, NULL if it is out of range
+ */
+const fpu_golden_record* fpu_golden_get(uint64_t index);
+
+#endif // FPU_GOLDEN_H_INCLUDED
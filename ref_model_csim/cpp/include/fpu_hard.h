@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the hard-case operand generator of the reference model
+ *  History       :
+ */
+
+#ifndef FPU_HARD_H_INCLUDED
+#define FPU_HARD_H_INCLUDED
+
+#include <cstdint>
+#include "memory.h"
+#include "fpu_gen.h"
+
+/*
+ * The hard-case generator builds the operands of an arithmetic request from the exact result it must have, instead of
+ * drawing them and hoping. The significands are integers of up to 2p+2 bits (p the precision of the format), the
+ * constructions take a constant expected number of steps whatever the format :
+ * - additions : the addend of lower exponent carries the rounding pattern below the last bit of the other one,
+ * - products : the low bits of the product are set through the inverse of the first factor modulo a power of two,
+ * - fused operations : the addend is the difference between the target and the exact product,
+ * - quotients and square roots : the target is solved modulo a power of two so that the target times the divisor, or
+ *   the squared target, is a few units away from an operand of p bits.
+ * The exponents are drawn so that the operands are normal when the property allows it, and the result lands where
+ * the property requires it. The sign of the result is uniform, except for the square root.
+ */
+
+/**
+ * \brief Properties of the exact result of a hard case
+ */
+typedef enum
+{
+    FPU_HARD_TIE = 0,           /**< midpoint of two consecutive floating point numbers */
+    FPU_HARD_ABOVE_TIE,         /**< midpoint plus a fraction of ulp, as small as the operation allows */
+    FPU_HARD_BELOW_TIE,         /**< midpoint minus a fraction of ulp, as small as the operation allows */
+    FPU_HARD_UNDERFLOW,         /**< between the largest subnormal and the smallest normal number */
+    FPU_HARD_OVERFLOW,          /**< largest normal number plus half an ulp */
+    FPU_HARD_CANCELLATION,      /**< sum of two terms of opposite signs that cancel all but a few bits */
+    FPU_HARD_NUM
+} fpu_hard_e;
+
+/**
+ * \brief   Build the operands of a request whose exact result has a property
+ * \details Some properties cannot be reached by every operation, the closest reachable case is built instead :
+ *          - a quotient or a square root is never a midpoint, TIE builds ABOVE_TIE, and a quotient never gets close
+ *            to the overflow midpoint, OVERFLOW builds a quotient of 2^(emax+1),
+ *          - an exact sum is a multiple of the smallest subnormal, UNDERFLOW builds the largest subnormal,
+ *          - a product lands on the overflow midpoint when p+1 is not prime (all the FPU formats), just below it
+ *            otherwise, and on ABOVE_TIE or BELOW_TIE when p is 4 or more, TIE otherwise,
+ *          - a square root never leaves the normal range, UNDERFLOW and OVERFLOW give the smallest subnormal and the
+ *            largest normal operands,
+ *          - CANCELLATION only applies to the additions and the fused operations, the others build TIE.
+ * \param   gen         Random sequence, see fpu_gen.h
+ * \param   op          FADD, FSUB, FMUL, FDIV, FMADD, FNMADD, FMSUB, FNMSUB or FSQRT, see fpu_op_e
+ * \param   env         Format of the operands, up to 64 bits with a precision of at least 3 bits
+ * \param   hard        Property of the exact result, see fpu_hard_e
+ * \param   operand_a   Output variable. operand_a field of the request, 0 when unused (FADD, FSUB)
+ * \param   operand_b   Output variable. operand_b field of the request, 0 when unused (FSQRT)
+ * \param   imm         Output variable. imm field of the request, 0 when unused (FMUL, FDIV, FSQRT)
+ * \return  0, or -1 if \e op or \e hard is not supported
+ */
+int fpu_hard_operands(fpu_gen* gen, int op, environment env, int hard, uint64_t* operand_a, uint64_t* operand_b,
+                      uint64_t* imm);
+
+/**
+ * \brief   Return the name of the property \e hard
+ */
+const char* fpu_hard_name(int hard);
+
+#endif // FPU_HARD_H_INCLUDED
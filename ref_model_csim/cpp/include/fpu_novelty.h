@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the novelty filter of the stimuli, a persistent blocked Bloom filter
+ *  History       :
+ */
+
+#ifndef FPU_NOVELTY_H_INCLUDED
+#define FPU_NOVELTY_H_INCLUDED
+
+#include <cstdint>
+#include "fpu_cache.h"
+
+#define FPU_NOVELTY_ENV_VAR           "REFMODEL_NOVELTY"          /**< environment variable giving the path of the filter */
+#define FPU_NOVELTY_ENTRIES_ENV_VAR   "REFMODEL_NOVELTY_ENTRIES"  /**< environment variable giving the capacity of a new filter */
+#define FPU_NOVELTY_DEFAULT_ENTRIES   (1u << 23)                  /**< default capacity of a new filter (16 MiB) */
+#define FPU_NOVELTY_BITS_PER_ENTRY    16                          /**< filter bits per tuple of the capacity */
+
+/*
+ * The novelty filter remembers the requests verified by every simulation opening it, keyed as the cache (operation,
+ * format, rounding mode, operands and register widths), so that the generator can draw again the tuples verified by
+ * earlier runs. It is a split block Bloom filter : a tuple sets one bit in each 64-bit word of a 512-bit block, the
+ * block is a cache line and a lookup reads a single one. Its false positive rate is about 0.1% at capacity, a new
+ * tuple is then taken for a seen one and drawn again with the resampling probability. Tuples are never removed.
+ */
+
+/**
+ * \brief Counters of the filter, for the calling process
+ */
+typedef struct
+{
+    uint64_t lookups;       /**< tuples drawn by the generator and looked up */
+    uint64_t hits;          /**< looked up tuples found in the filter */
+    uint64_t resamples;     /**< found tuples drawn again */
+    uint64_t inserts;       /**< verified tuples */
+    uint64_t novel;         /**< verified tuples that were not in the filter */
+} fpu_novelty_stats;
+
+/**
+ * \brief   Open or create the filter
+ * \details The filter is a file mapped in memory and shared by every simulation opening it, bits are set atomically.
+ *          The size of an existing filter is kept, an invalid file is replaced (see fpu_shared_file_open). Also called at load time when REFMODEL_NOVELTY is set.
+ * \param   path      Path of the file
+ * \param   entries   Capacity of the filter if it is created, 0 for the default (REFMODEL_NOVELTY_ENTRIES or
+ *                    FPU_NOVELTY_DEFAULT_ENTRIES)
+ * \return  0 on success, -1 otherwise (the filter is then disabled)
+ */
+int fpu_novelty_open(const char* path, uint64_t entries);
+
+/**
+ * \brief   Unmap the filter
+ */
+void fpu_novelty_close();
+
+/**
+ * \brief   Return true if a filter is opened
+ */
+bool fpu_novelty_enabled();
+
+/**
+ * \brief   Return true if a tuple is in the filter, false if no filter is opened
+ */
+bool fpu_novelty_lookup(const fpu_cache_key* key);
+
+/**
+ * \brief   Decide whether a drawn tuple must be drawn again
+ * \param   key       Key of the tuple
+ * \param   percent   Probability to draw again a tuple found in the filter, in percent
+ * \param   random    Random value deciding the draw
+ * \return  true if the tuple is in the filter and is drawn again
+ */
+bool fpu_novelty_resample(const fpu_cache_key* key, uint32_t percent, uint64_t random);
+
+/**
+ * \brief   Insert a verified tuple in the filter
+ * \return  true if the tuple was not in the filter
+ */
+bool fpu_novelty_insert(const fpu_cache_key* key);
+
+/**
+ * \brief   Read the counters of the filter
+ */
+void fpu_novelty_get_stats(fpu_novelty_stats* stats);
+
+/**
+ * \brief   Return the number of tuples inserted in the filter by every simulation, 0 if no filter is opened
+ */
+uint64_t fpu_novelty_count();
+
+/**
+ * \brief   Return the fraction of the bits set in the filter, 0 if no filter is opened
+ * \details Reads the whole filter. A tuple not in the filter is found with a probability of about fill^8.
+ */
+double fpu_novelty_fill();
+
+#endif // FPU_NOVELTY_H_INCLUDED
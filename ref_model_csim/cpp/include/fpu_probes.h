@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Static user-level tracepoints (USDT) of the reference model
+ *  History       :
+ */
+
+#ifndef FPU_PROBES_H_INCLUDED
+#define FPU_PROBES_H_INCLUDED
+
+/*
+ * Probes of the provider "refmodel", compiled in when <sys/sdt.h> (systemtap-sdt-dev, header only) is found and
+ * REFMODEL_NO_PROBES is not defined. A probe is a NOP in the code and a note in the library, it only fires when a
+ * tracer is attached :
+ *   bpftrace -l 'usdt:<path>/refmodel_csim_lib.so:refmodel:*'
+ *   perf buildid-cache --add <path>/refmodel_csim_lib.so && perf record -e 'sdt_refmodel:*' ...
+ *
+ *   dpi_entry(entry, op, fmt, rm)          entry of a dpi_* function : fpu_stats_entry_e, fpu_op_e, fpu_fmt_e (-1 if
+ *                                          the environment is not a format of the FPU), rm field (-1 if none)
+ *   dpi_return(entry, op, fmt, rm, flags)  return of a dpi_* function, flags is -1 if the request is not supported
+ *   subnormal(bis, es, exponent, rm)       mpfr2IEEElike_subnormal, environment and MPFR exponent of the result
+ *   overflow(bis, es, exponent, rm)        IEEElike_exponent_fits, result rounded to infinity
+ *   underflow(bis, es, exponent, rm)       IEEElike_exponent_fits, result flushed to zero
+ *   nan_operand(bis, es)                   IEEElike2mpfr, NaN operand
+ *   nan_result(bis, es)                    mpfr2IEEElike, NaN result
+ *   nan_box(op, fmt, operand)              fpu_exec, operand (0, 1 or 2) replaced by the canonical NaN
+ * rm is the RTL encoding in dpi_* probes, the mpfr_rnd_t value in the others.
+ */
+
+#if !defined(REFMODEL_NO_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define FPU_PROBES_ENABLED 1
+#endif
+#endif
+
+#ifdef FPU_PROBES_ENABLED
+#define FPU_PROBE2(name, a, b)              DTRACE_PROBE2(refmodel, name, a, b)
+#define FPU_PROBE3(name, a, b, c)           DTRACE_PROBE3(refmodel, name, a, b, c)
+#define FPU_PROBE4(name, a, b, c, d)        DTRACE_PROBE4(refmodel, name, a, b, c, d)
+#define FPU_PROBE5(name, a, b, c, d, e)     DTRACE_PROBE5(refmodel, name, a, b, c, d, e)
+#else
+#define FPU_PROBE2(name, a, b)              do {} while (0)
+#define FPU_PROBE3(name, a, b, c)           do {} while (0)
+#define FPU_PROBE4(name, a, b, c, d)        do {} while (0)
+#define FPU_PROBE5(name, a, b, c, d, e)     do {} while (0)
+#endif
+
+#endif // FPU_PROBES_H_INCLUDED
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the per-entry call statistics of the DPI interface
+ *  History       :
+ */
+
+#ifndef FPU_STATS_H_INCLUDED
+#define FPU_STATS_H_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+#include "fpu_exec.h"
+
+#define FPU_STATS_ENV_VAR       "REFMODEL_STATS" /**< environment variable enabling the statistics when set and not 0 */
+#define FPU_STATS_LATENCY_NUM   32               /**< number of buckets of the latency histograms */
+#define FPU_STATS_OUTCOME_NUM   7                /**< flags NX, UF, OF, DZ, NV, then no flag and unsupported request */
+#define FPU_STATS_FMT_OTHER     FPU_FMT_NUM      /**< format index of the environments that are not a format of the FPU */
+
+/**
+ * \brief DPI entries, the operation and the format of a call are recorded separately
+ */
+typedef enum
+{
+    FPU_STATS_DPI = 0,          /**< per-operation entries dpi_fadd, dpi_fsub, ... */
+    FPU_STATS_EXEC,             /**< dpi_fpu_exec */
+    FPU_STATS_EXEC_ALL_RM,      /**< dpi_fpu_exec_all_rm */
+    FPU_STATS_ENTRY_NUM
+} fpu_stats_entry_e;
+
+/**
+ * \brief Counters of an (entry, operation, format) triple, cumulated over all threads
+ */
+typedef struct
+{
+    uint64_t calls;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t latency[FPU_STATS_LATENCY_NUM];  /**< bucket k counts the calls of [2^k, 2^(k+1)) ns, bucket 0 also counts 0 ns */
+    uint64_t outcomes[FPU_STATS_OUTCOME_NUM]; /**< calls raising each flag, calls without flag, unsupported requests */
+} fpu_stats_counters;
+
+extern std::atomic<bool> fpu_stats_on;
+
+/**
+ * \brief   Enable or disable the statistics
+ * \details Also enabled at load time when REFMODEL_STATS is set. Disabled statistics cost a load per call. The first
+ *          enable calibrates the time stamp counter against the monotonic clock, for about 10 ms.
+ */
+void fpu_stats_enable(bool enable);
+
+/**
+ * \brief   Return true if the statistics are enabled
+ */
+bool fpu_stats_enabled();
+
+/**
+ * \brief   Return the current time in clock ticks
+ * \details The time stamp counter on x86-64, converted to ns when the call is recorded, else the monotonic clock in ns.
+ */
+static inline uint64_t fpu_stats_now()
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+/**
+ * \brief   Record a call in the counters of the calling thread
+ * \param   entry   DPI entry, see fpu_stats_entry_e
+ * \param   op      Operation, see fpu_op_e, out of range values are recorded as FPU_OP_NUM
+ * \param   fmt     Format code, see fpu_fmt_e, -1 or out of range values are recorded as FPU_STATS_FMT_OTHER
+ * \param   flags   Exception flags returned by the call, -1 if the request is not supported
+ * \param   start   Time of the start of the call, see fpu_stats_begin
+ */
+void fpu_stats_record(int entry, int64_t op, int64_t fmt, int flags, uint64_t start);
+
+/**
+ * \brief   Start timing a call, return 0 when the statistics are disabled
+ */
+static inline uint64_t fpu_stats_begin()
+{
+    return fpu_stats_on.load(std::memory_order_acquire) ? fpu_stats_now() : 0;
+}
+
+/**
+ * \brief   Record a call started by fpu_stats_begin, see fpu_stats_record
+ */
+static inline void fpu_stats_end(uint64_t start, int entry, int64_t op, int64_t fmt, int flags)
+{
+    if (start != 0)
+        fpu_stats_record(entry, op, fmt, flags, start);
+}
+
+/**
+ * \brief   Read the counters of an (entry, operation, format) triple, summed over all threads
+ * \param   fmt   Format code, or FPU_STATS_FMT_OTHER
+ */
+void fpu_stats_get(fpu_stats_counters* counters, int entry, int op, int fmt);
+
+/**
+ * \brief   Clear the counters of all threads
+ */
+void fpu_stats_reset();
+
+/**
+ * \brief   Print the counters of every triple called at least once, by decreasing total time
+ * \details Percentiles are the upper bounds of the latency buckets, so they are rounded up to a power of two.
+ * \param   out         Stream of the table, NULL to only write the JSON file
+ * \param   json_path   JSON file written with one object per triple, NULL or empty to skip it
+ * \return  0, -1 if the JSON file cannot be written
+ */
+int fpu_stats_report(FILE* out, const char* json_path);
+
+#endif // FPU_STATS_H_INCLUDED
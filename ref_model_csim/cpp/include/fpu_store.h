@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the persistent result store of the reference model
+ *  History       :
+ */
+
+#ifndef FPU_STORE_H_INCLUDED
+#define FPU_STORE_H_INCLUDED
+
+#include <cstdint>
+#include "fpu_cache.h"
+
+#define FPU_STORE_ENV_VAR           "REFMODEL_STORE"         /**< environment variable giving the path of the store */
+#define FPU_STORE_ENTRIES_ENV_VAR   "REFMODEL_STORE_ENTRIES" /**< environment variable giving the number of entries of a new store */
+#define FPU_STORE_DEFAULT_ENTRIES   (1u << 20)               /**< default number of entries of a new store (64 MiB) */
+#define FPU_STORE_WAYS              4                        /**< number of entries of a bucket */
+
+/**
+ * \brief Counters of the store, for the calling process
+ */
+typedef struct
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t inserts;
+    uint64_t evictions;
+} fpu_store_stats;
+
+/**
+ * \brief   Open or create the store
+ * \details The store is a file mapped in memory and shared by every simulation opening it. It is a set-associative
+ *          hash table of FPU_STORE_WAYS-way buckets, entries are protected by a sequence lock so that concurrent
+ *          readers and writers of parallel simulations never observe a partially written entry. Every entry is
+ *          tagged with the hash of the model, entries of another model are ignored and evicted first. The size of
+ *          an existing store is kept. Also called at load time when REFMODEL_STORE is set.
+ *          A process opens one store, which stays mapped until it exits : fpu_store_lookup and fpu_store_insert
+ *          read it without lock. Opening the same path again does nothing, another path is refused.
+ * \param   path      Path of the file
+ * \param   entries   Number of entries of the store if it is created, 0 for the default (REFMODEL_STORE_ENTRIES or
+ *                    FPU_STORE_DEFAULT_ENTRIES)
+ * \return  0 on success, -1 otherwise (the store is then disabled unless it was already opened)
+ */
+int fpu_store_open(const char* path, uint64_t entries);
+
+/**
+ * \brief   Open a file shared by the simulations of a regression, and lock it
+ * \details The file is created if needed. If \e valid rejects it, a new file is written by \e init in a temporary file
+ *          which is then renamed in place : the simulations which mapped the former file keep it and are never
+ *          truncated under. The file returned is locked (LOCK_EX), the caller maps it then closes it. Used by the
+ *          store and the novelty filter.
+ * \param   path    Path of the file
+ * \param   valid   Return true if the file opened by \e fd can be used
+ * \param   init    Initialise the new file opened by \e fd, return false on error
+ * \param   arg     Argument of \e valid and \e init
+ * \return  File descriptor, -1 on error
+ */
+int fpu_shared_file_open(const char* path, bool (*valid)(int fd, void* arg), bool (*init)(int fd, void* arg), void* arg);
+
+/**
+ * \brief   Return true if a store is opened
+ */
+bool fpu_store_enabled();
+
+/**
+ * \brief   Return the version of the results computed by the model
+ * \details "fpu_exec-" followed by a hash of the sources which compute the results (operations, memory, intfp,
+ *          fpu_exec, fpu_all_rm and the tables), computed at build time by the Makefile (FPU_MODEL_SOURCE_HASH). A
+ *          modification of the model changes it, so that the results written by older libraries are no longer used,
+ *          while changes of the trace, statistics or coverage code keep them. Without the Makefile, the build time
+ *          is used instead of the hash.
+ */
+const char* fpu_store_model_version();
+
+/**
+ * \brief   Return the hash of the model tagging the entries written by this library
+ * \details Hash of fpu_store_model_version and of the versions of MPFR and GMP the library runs with. Also checked by
+ *          the precomputed tables, the traces and the golden-vector files.
+ */
+uint64_t fpu_store_model_hash();
+
+/**
+ * \brief   Look a request up in the store
+ * \param   key     Key of the request
+ * \param   result  Output variable. Stored result, written on hit only.
+ * \param   flags   Output variable. Stored flags, written on hit only.
+ * \return  true on hit
+ */
+bool fpu_store_lookup(const fpu_cache_key* key, uint64_t* result, int* flags);
+
+/**
+ * \brief   Insert a computed request in the store, evicting the oldest entry of its bucket if it is full
+ */
+void fpu_store_insert(const fpu_cache_key* key, uint64_t result, int flags);
+
+/**
+ * \brief   Read the counters of the store
+ */
+void fpu_store_get_stats(fpu_store_stats* stats);
+
+#endif // FPU_STORE_H_INCLUDED
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the reader and writer of test vectors in the text format of Berkeley TestFloat
+ *  History       :
+ */
+
+#ifndef FPU_TESTFLOAT_H_INCLUDED
+#define FPU_TESTFLOAT_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * A TestFloat vector is a line of hexadecimal fields separated by spaces : the operands, the result and the exception
+ * flags, e.g. "3F800000 BF800000 00000000 00" for f32_add. Operands and results are written on the digits of their
+ * width, results of comparisons as 0 or 1, flags on 2 digits. The rounding mode is not part of the line, it is given
+ * to the generator and to the checker.
+ *
+ * Functions are named as in TestFloat (f32_add, f16_to_i64, ui32_to_f64, f32_mulAdd, f64_le, ...), with f8 for the
+ * 8-bit format of the FPU and bf16 for FP16ALT. The operations TestFloat does not have are named after their RISC-V
+ * mnemonic (f32_fmsub, f32_fnmadd, f32_fnmsub, f32_min, f32_max, f32_class, f32_sgnj, f32_sgnjn, f32_sgnjx). Integer
+ * conversions always raise the inexact flag, as with the -exact option of TestFloat.
+ */
+
+#define FPU_TESTFLOAT_LINE_MAX  96   /**< upper bound of the length of a line written by fpu_testfloat_format */
+#define FPU_TESTFLOAT_RM_FIXED  0xFF /**< rm of the functions which round with the rounding mode of the vectors */
+
+/**
+ * \brief A function of the vectors, i.e. a request of the FPU of which some fields are the operands
+ */
+typedef struct
+{
+    char    name[24];       /**< TestFloat name */
+    uint8_t op;             /**< fpu_op_e */
+    uint8_t fmt;            /**< fmt field */
+    uint8_t rm;             /**< rm field of the functions that use it as a selector, FPU_TESTFLOAT_RM_FIXED otherwise */
+    uint8_t imm;            /**< imm field of the conversions : source format of FCVT_F2F, modifiers of FCVT_F2I/I2F */
+    uint8_t noperands;      /**< number of operands, 1 to 3 */
+    uint8_t fields[3];      /**< request field of each operand : 0 operand_a, 1 operand_b, 2 imm */
+    uint8_t operand_fmt;    /**< format code of the operands, 0xFF for integers */
+    uint8_t operand_bits;   /**< width of the operands */
+    uint8_t result_bits;    /**< width of the result, 1 for the comparisons */
+} fpu_testfloat_function;
+
+/**
+ * \brief A test vector, flags are in the encoding of the model
+ */
+typedef struct
+{
+    uint64_t operands[3];
+    uint64_t result;
+    int      flags;
+} fpu_testfloat_vector;
+
+/**
+ * \brief   Return the functions supported by the model
+ * \param   num   Output variable. Number of functions.
+ */
+const fpu_testfloat_function* fpu_testfloat_functions(int* num);
+
+/**
+ * \brief   Return the function named \e name, NULL if the model does not support it
+ */
+const fpu_testfloat_function* fpu_testfloat_find(const char* name);
+
+/**
+ * \brief   Convert TestFloat exception flags (inexact, underflow, overflow, infinite, invalid) to the flags of the model
+ */
+int fpu_testfloat_flags_to_model(int flags);
+
+/**
+ * \brief   Convert exception flags of the model to TestFloat ones
+ */
+int fpu_testfloat_flags_from_model(int flags);
+
+/**
+ * \brief   Parse the line starting at \e p
+ * \details Fields are separated by spaces or tabs, the line ends with a line feed, an optional carriage return
+ *          before it, or \e end. Digits are not limited to the width of the fields, values are masked to it.
+ * \param   vector  Output variable. Operands, result and flags of the line.
+ * \return  Start of the next line, NULL if the line is malformed
+ */
+const char* fpu_testfloat_parse(const char* p, const char* end, const fpu_testfloat_function* function,
+                                fpu_testfloat_vector* vector);
+
+/**
+ * \brief   Write a vector as a line, ended by a line feed
+ * \param   out   Output variable. At least FPU_TESTFLOAT_LINE_MAX bytes.
+ * \return  End of the line
+ */
+char* fpu_testfloat_format(char* out, const fpu_testfloat_function* function, const fpu_testfloat_vector* vector);
+
+/**
+ * \brief   Compute the result and the flags of the operands of a vector
+ * \details The operands are NaN-boxed and sent through fpu_exec_compute with XLEN = FLEN = 64. The result is read on
+ *          the width of the function.
+ * \param   vector  Input and output variable. Operands, then result and flags.
+ * \param   rm      Rounding mode, RTL encoding. Ignored by the functions that do not round.
+ * \return  0, -1 if the request is not supported
+ */
+int fpu_testfloat_exec(const fpu_testfloat_function* function, int rm, fpu_testfloat_vector* vector);
+
+#endif // FPU_TESTFLOAT_H_INCLUDED
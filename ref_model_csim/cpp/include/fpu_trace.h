@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the binary trace recorder of the DPI calls
+ *  History       :
+ */
+
+#ifndef FPU_TRACE_H_INCLUDED
+#define FPU_TRACE_H_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+
+#define FPU_TRACE_ENV_VAR           "REFMODEL_TRACE"          /**< environment variable giving the path of the trace */
+#define FPU_TRACE_COMPRESS_ENV_VAR  "REFMODEL_TRACE_COMPRESS" /**< environment variable enabling the block compression when set and not 0 */
+#define FPU_TRACE_MAGIC             0x4543415254555046ULL     /**< "FPUTRACE" */
+#define FPU_TRACE_VERSION           2
+#define FPU_TRACE_BLOCK_RECORDS     16384                     /**< records buffered by a thread before a block is written (1 MiB) */
+#define FPU_TRACE_COMPRESSED        0x1                       /**< header flag : block payloads are encoded, see fpu_trace_decode */
+
+/*
+ * A trace is a header followed by blocks. A block is a block header followed by its payload : nrecords records, or
+ * their encoding if the trace is compressed. Each thread fills its own block, so records of a block are in call order
+ * but blocks of different threads are interleaved.
+ */
+
+/**
+ * \brief Header of a trace file
+ */
+typedef struct
+{
+    uint64_t magic;             /**< FPU_TRACE_MAGIC */
+    uint32_t version;           /**< FPU_TRACE_VERSION */
+    uint32_t record_size;       /**< sizeof(fpu_trace_record) */
+    uint32_t flags;             /**< FPU_TRACE_COMPRESSED */
+    uint32_t block_records;     /**< maximum number of records of a block */
+    uint64_t model_hash;        /**< fpu_store_model_hash of the recording library */
+    char     model[32];         /**< fpu_store_model_version */
+    char     mpfr[16];          /**< MPFR version */
+    char     gmp[16];           /**< GMP version */
+    char     build[128];        /**< compiler and date of the recording library */
+    uint8_t  reserved[32];
+} fpu_trace_header;
+
+/**
+ * \brief Header of a block
+ */
+typedef struct
+{
+    uint32_t nrecords;          /**< number of records of the block */
+    uint32_t nbytes;            /**< size of the payload */
+    uint32_t thread;            /**< index of the recording thread, in order of their first record */
+    uint32_t reserved;
+} fpu_trace_block;
+
+/**
+ * \brief A recorded call
+ * \details Opcode entries (dpi_fpu_exec, dpi_fpu_exec_all_rm) record the raw fields of the request. Per-operation
+ *          entries (dpi_fadd, ...) record their environments and their operands and result read on the width of the
+ *          format, or of the integer. dpi_fpu_exec_all_rm records one call per rounding mode.
+ */
+typedef struct
+{
+    uint64_t operand_a;         /**< operand_a field, or op1 */
+    uint64_t operand_b;         /**< operand_b field, or op2 */
+    uint64_t imm;               /**< imm field, or op3 */
+    uint64_t result;
+    uint64_t trans_id;          /**< transaction id given by the simulator, see fpu_trace_set_context */
+    uint64_t sim_time;          /**< simulation time given by the simulator */
+    uint16_t dst_bis;           /**< per-operation entries : environment of the result */
+    uint16_t src_bis;           /**< per-operation entries : environment of the operands */
+    uint8_t  dst_es;
+    uint8_t  src_es;
+    uint8_t  entry;             /**< fpu_stats_entry_e */
+    uint8_t  op;                /**< fpu_op_e */
+    uint8_t  fmt;               /**< opcode entries : fmt field */
+    uint8_t  rm;                /**< rm field, or rounding mode of a dpi_fpu_exec_all_rm record */
+    int8_t   flags;             /**< exception flags, -1 if the request is not supported */
+    uint8_t  aux;               /**< opcode entries : xlen/32 | flen/32 << 4, per-operation entries : is_signed |
+                                     int_format << 1 of the conversions, nchunks of FMV_F2X */
+    uint32_t thread;            /**< index of the recording thread */
+} fpu_trace_record;
+
+static_assert(sizeof(fpu_trace_record) == 64, "trace records must fill a cache line");
+static_assert(sizeof(fpu_trace_header) == 256, "trace header size is part of the format");
+
+extern std::atomic<bool> fpu_trace_on;
+
+/**
+ * \brief   Create a trace file and start recording
+ * \details Also called at load time when REFMODEL_TRACE is set. A trace already opened is closed first.
+ * \param   path       Path of the file
+ * \param   compress   Encode the blocks, records are XORed with the previous one and their zero bytes are dropped
+ * \return  0 on success, -1 otherwise (recording is then disabled)
+ */
+int fpu_trace_open(const char* path, bool compress);
+
+/**
+ * \brief   Write the blocks of every thread and close the trace
+ * \details Called at exit. No call must be in flight in another thread.
+ */
+void fpu_trace_close();
+
+/**
+ * \brief   Return true if a trace is recorded
+ */
+static inline bool fpu_trace_enabled()
+{
+    return fpu_trace_on.load(std::memory_order_relaxed);
+}
+
+/**
+ * \brief   Set the transaction id and simulation time of the next records of the calling thread
+ */
+void fpu_trace_set_context(uint64_t trans_id, uint64_t sim_time);
+
+/**
+ * \brief   Append a record to the block of the calling thread, the context and thread fields are filled
+ */
+void fpu_trace_write(const fpu_trace_record* record);
+
+/**
+ * \brief   Encode the records of a block
+ * \param   out       Output variable. At least nrecords * (sizeof(fpu_trace_record) + 8) bytes.
+ * \return  Size of the encoding
+ */
+uint32_t fpu_trace_encode(uint8_t* out, const fpu_trace_record* records, uint32_t nrecords);
+
+/**
+ * \brief   Decode the payload of a compressed block
+ * \param   records   Output variable. nrecords records.
+ * \return  0, -1 if the payload is truncated
+ */
+int fpu_trace_decode(fpu_trace_record* records, uint32_t nrecords, const uint8_t* in, uint32_t nbytes);
+
+#endif // FPU_TRACE_H_INCLUDED
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the tables of the unary operations on the 16-bits and 8-bits formats
+ *  History       :
+ */
+
+#ifndef FPU_UNARY_TABLE_H_INCLUDED
+#define FPU_UNARY_TABLE_H_INCLUDED
+
+#include <cstdint>
+#include "fpu_exec.h"
+
+#define FPU_UNARY_TABLE_ENV_VAR         "REFMODEL_UNARY_TABLES"      /**< environment variable giving the mode : off, lazy or background */
+#define FPU_UNARY_TABLE_FILE_ENV_VAR    "REFMODEL_UNARY_TABLES_FILE" /**< environment variable giving the path of a precomputed table file */
+#define FPU_UNARY_TABLE_RM_NUM          4                            /**< rounding modes : RNE, RTZ, RDN, RUP */
+
+/**
+ * \brief Source formats of the tables : FP16, FP16ALT (65536 inputs) and FP8 (256 inputs)
+ */
+typedef enum
+{
+    UNARY_SRC_FP16 = 0,
+    UNARY_SRC_FP16ALT,
+    UNARY_SRC_FP8,
+    UNARY_SRC_NUM
+} fpu_unary_src_e;
+
+/**
+ * \brief Operations, each one has a table per source format and rounding mode
+ */
+typedef enum
+{
+    UNARY_SQRT = 0,
+    UNARY_FCLASS,       /**< one table, rounding mode independent */
+    UNARY_F2F_FP32,
+    UNARY_F2F_FP64,
+    UNARY_F2F_FP16,
+    UNARY_F2F_FP8,
+    UNARY_F2F_FP16ALT,
+    UNARY_F2I32,
+    UNARY_F2U32,
+    UNARY_F2I64,
+    UNARY_F2U64,
+    UNARY_KIND_NUM
+} fpu_unary_kind_e;
+
+/**
+ * \brief When the tables are built
+ */
+typedef enum
+{
+    UNARY_TABLE_OFF = 0,    /**< no table, every operation uses MPFR */
+    UNARY_TABLE_LAZY,       /**< a table is built on its first use (default) */
+    UNARY_TABLE_BACKGROUND  /**< every table is built by a background thread, MPFR serves the calls until then */
+} fpu_unary_table_mode_e;
+
+/**
+ * \brief   Return the name of a table, e.g. "FP16.SQRT.RNE"
+ */
+const char* fpu_unary_table_name(int src, int kind, int rm);
+
+/**
+ * \brief   Return the source index of a format (see fpu_fmt_e), -1 if it has no table
+ */
+int fpu_unary_table_src(int fmt);
+
+/**
+ * \brief   Return true if the table exists
+ * \details F2F has no table to its own format. RMM has no table, fpu_exec rounds it with fpu_all_rm.
+ */
+bool fpu_unary_table_supported(int src, int kind, int rm);
+
+/**
+ * \brief   Select the mode of the tables
+ * \details The background mode needs a thread-safe MPFR (see mpfr_buildopt_tls_p), the lazy mode is used otherwise.
+ *          Also called at load time with the value of REFMODEL_UNARY_TABLES.
+ */
+void fpu_unary_table_set_mode(int mode);
+
+/**
+ * \brief   Return the mode of the tables
+ */
+int fpu_unary_table_get_mode();
+
+/**
+ * \brief   Compute an entry with the MPFR operations of the model
+ * \return  Exception flags
+ */
+int fpu_unary_table_compute(uint64_t* result, int src, int kind, int rm, uint32_t input);
+
+/**
+ * \brief   Look an entry up
+ * \details In lazy mode, the table is built if needed. Thread-safe.
+ * \return  false if the table does not exist, is disabled, or is not yet built by the background thread
+ */
+bool fpu_unary_table_lookup(uint64_t* result, int* flags, int src, int kind, int rm, uint32_t input);
+
+/**
+ * \brief   Build every table, in the calling thread
+ */
+void fpu_unary_table_build_all();
+
+/**
+ * \brief   Load every table from a file written by fpu_unary_table_save
+ * \details The file is rejected if it was written by another model (see fpu_store_model_hash). Also called at load
+ *          time when REFMODEL_UNARY_TABLES_FILE is set.
+ * \return  0 on success, -1 otherwise
+ */
+int fpu_unary_table_load(const char* path);
+
+/**
+ * \brief   Build every table and write them to a file
+ * \return  0 on success, -1 otherwise
+ */
+int fpu_unary_table_save(const char* path);
+
+/**
+ * \brief   Handlers of fpu_exec, see fpu_exec_fn
+ * \details Operations on a format or rounding mode without table use MPFR.
+ */
+int fpu_unary_exec_fsqrt    (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+int fpu_unary_exec_fclass   (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+int fpu_unary_exec_fcvt_f2i (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+int fpu_unary_exec_fcvt_f2f (uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx);
+
+#endif // FPU_UNARY_TABLE_H_INCLUDED
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the helpers shared by the library and the tools
+ *  History       :
+ */
+
+#ifndef FPU_UTIL_H_INCLUDED
+#define FPU_UTIL_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#define FPU_DEFAULT_PROGRESS 10 /**< seconds between two progress lines of the long-running tools */
+
+/**
+ * \brief Progress lines of a long-running tool, see fpu_progress_report
+ */
+typedef struct
+{
+    std::chrono::steady_clock::time_point start;
+    double                                last;     /**< elapsed seconds at the last line */
+    long                                  interval; /**< seconds between two lines, 0 for none */
+} fpu_progress;
+
+/**
+ * \brief   Mask of the \e n low bits of a 64-bit value, n up to 64
+ */
+static inline uint64_t fpu_low_mask(int n)
+{
+    return n >= 64 ? ~0ULL : (1ULL << n) - 1;
+}
+
+/**
+ * \brief   Add to a counter only written by the calling thread
+ * \details The per-thread counters of the statistics and of the coverage are relaxed atomics, so that the reports can
+ *          read them while the simulation runs : a relaxed load and store compile to plain memory accesses, without the
+ *          locked instruction of fetch_add.
+ */
+static inline void fpu_add_relaxed(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+/**
+ * \brief   Next value of a SplitMix64 generator
+ * \details Used to seed the generators and to draw the random inputs of the tools.
+ * \param   state   State of the generator, advanced
+ * \return  Random 64-bit value
+ */
+static inline uint64_t fpu_splitmix64(uint64_t* state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * \brief   Write a whole buffer to a file, after short writes
+ * \param   fd      File descriptor
+ * \param   data    Buffer
+ * \param   size    Size of the buffer in bytes
+ * \return  false on error
+ */
+bool fpu_write_all(int fd, const void* data, size_t size);
+
+/**
+ * \brief   Number of threads which can run the MPFR operations
+ * \details The exponent range and the flags of MPFR are global unless it is built thread-safe
+ *          (mpfr_buildopt_tls_p) : a warning is printed and one thread is used then.
+ * \param   threads Number of threads requested
+ * \return  Number of threads to run
+ */
+int fpu_mpfr_threads(int threads);
+
+/**
+ * \brief   Parse a name of a table, or a decimal code below \e num
+ * \param   s       Name, compared without case, or code
+ * \param   name_of Name of a code, NULL for the codes without a name
+ * \param   num     Number of codes
+ * \return  Code, or -1 if \e s is neither a name nor a code of the table
+ */
+int fpu_parse_code(const char* s, const char* (*name_of)(int), int num);
+
+/**
+ * \brief   Start the progress lines of a tool
+ * \param   progress    Progress to initialise
+ * \param   interval    Seconds between two lines, 0 for none
+ */
+void fpu_progress_init(fpu_progress* progress, long interval);
+
+/**
+ * \brief   Return the seconds elapsed since fpu_progress_init
+ */
+double fpu_progress_elapsed(const fpu_progress* progress);
+
+/**
+ * \brief   Print a progress line when its interval elapsed : percentage done, rate and estimated time left
+ * \param   progress    Progress of the tool
+ * \param   done        Units processed
+ * \param   total       Units to process
+ * \param   unit        Name of the units in the rate, e.g. "inputs"
+ */
+void fpu_progress_report(fpu_progress* progress, uint64_t done, uint64_t total, const char* unit);
+
+#endif // FPU_UTIL_H_INCLUDED
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Declare the integer implementation of the arithmetic operations, for formats up to 32 bits
+ *  History       :
+ */
+
+#ifndef INTFP_H_INCLUDED
+#define INTFP_H_INCLUDED
+
+#include <cstdint>
+#include "memory.h"
+
+/**
+ * \details The operations below compute exactly with integers then round once, with the semantics of the MPFR based
+ *          operations of operations.h : tininess detected after rounding, underflow raised only when inexact, NaN
+ *          results set to the canonical quiet NaN, and NV raised by 0 x Inf + qNaN in the fused operations.
+ *          They do not use MPFR, which makes them an independent implementation to check the MPFR path against,
+ *          and a fast path for the small formats.
+ *          Operands and results are the IEEE-like encodings in the low bits of a 64-bits word.
+ *          Rounding modes use the RTL encoding : 0 RNE, 1 RTZ, 2 RDN, 3 RUP, 4 RMM.
+ */
+
+#define INTFP_MAX_BIS   (32-1) /**< largest supported format, one-based bit size */
+
+/**
+ * \brief   Return true if the operations below support \e env
+ * \details intfp_round supports every format up to 64 bits.
+ */
+bool intfp_supported(environment env);
+
+int intfp_add (uint64_t* result, uint64_t op1, uint64_t op2, int rm, environment env);
+int intfp_sub (uint64_t* result, uint64_t op1, uint64_t op2, int rm, environment env);
+int intfp_mul (uint64_t* result, uint64_t op1, uint64_t op2, int rm, environment env);
+int intfp_div (uint64_t* result, uint64_t op1, uint64_t op2, int rm, environment env);
+int intfp_sqrt(uint64_t* result, uint64_t op1, int rm, environment env);
+
+/**
+ * \brief   Fused multiply-add family : op1*op2+op3, op1*op2-op3, -(op1*op2)-op3 and -(op1*op2)+op3
+ */
+int intfp_fma (uint64_t* result, uint64_t op1, uint64_t op2, uint64_t op3, int rm, environment env);
+int intfp_fms (uint64_t* result, uint64_t op1, uint64_t op2, uint64_t op3, int rm, environment env);
+int intfp_fnma(uint64_t* result, uint64_t op1, uint64_t op2, uint64_t op3, int rm, environment env);
+int intfp_fnms(uint64_t* result, uint64_t op1, uint64_t op2, uint64_t op3, int rm, environment env);
+
+/**
+ * \brief   Minimum and maximum, -0 is lower than +0 and a NaN operand is ignored
+ */
+int intfp_fmin(uint64_t* result, uint64_t op1, uint64_t op2, environment env);
+int intfp_fmax(uint64_t* result, uint64_t op1, uint64_t op2, environment env);
+
+/**
+ * \brief   Comparisons, result is 1 if true else 0. NV is raised by any NaN for FLE and FLT, by sNaN only for FEQ.
+ */
+int intfp_cmp_leq(uint64_t* result, uint64_t op1, uint64_t op2, environment env);
+int intfp_cmp_lt (uint64_t* result, uint64_t op1, uint64_t op2, environment env);
+int intfp_cmp_eq (uint64_t* result, uint64_t op1, uint64_t op2, environment env);
+
+/**
+ * \brief   Round (-1)^sign * sig * 2^exp to \e env
+ * \details sig must not be null. It is either exact, or rounded to odd with at least two bits more than the precision of
+ *          the format, which gives the same result as rounding the exact value once.
+ * \return  Exception flags NX, UF and OF
+ */
+int intfp_round(uint64_t* result, bool sign, uint64_t sig, int exp, int rm, environment env);
+
+#endif // INTFP_H_INCLUDED
@@ -26,31 +26,153 @@
 
 #include "operations.h"
 #include "memory.h"
-#include "dpiheader.h"
+#include "fpu_exec.h"
+#include "fpu_cache.h"
+#include "fpu_store.h"
+#include "fpu_stats.h"
+#include "fpu_probes.h"
+#include "fpu_trace.h"
+#include "fpu_cov.h"
+#include "fpu_gen.h"
+#include "fpu_hard.h"
+#include "fpu_golden.h"
+#include "fpu_novelty.h"
+// The DPI entries are the only symbols exported by the library when it is built with -fvisibility=hidden
+#pragma GCC visibility push(default)
+#include "fpu_dpi.h"
+#pragma GCC visibility pop
 #include <stdio.h>
+#include <string.h>
 
-// Align RTL rounding mode with that of MPFR
-// structure
-mpfr_rnd_t rnd_rtl_to_c(int rnd_rtl) {
-    mpfr_rnd_t rnd_c;
-    if (rnd_rtl == 2)
+static inline int env_width(environment env)
+{
+    return env.bis + 1;
+}
+
+// Value of a DPI bit vector of width bits, vectors of 32 bits or less have a single chunk
+static inline uint64_t sv_value(const svBitVecVal* v, int width)
+{
+    if (v == NULL)
+        return 0;
+    return width > 32 ? ((uint64_t) v[1] << 32) | v[0] : v[0];
+}
+
+// Record a call of a per-operation entry, operands are width bits wide
+static void trace_dpi(int op, environment dst_env, environment src_env, int width, const svBitVecVal* op1,
+                      const svBitVecVal* op2, const svBitVecVal* op3, int result_width, const svBitVecVal* result,
+                      int rm, int aux, int flags)
+{
+    fpu_trace_record r;
+    memset(&r, 0, sizeof(r));
+    r.operand_a = sv_value(op1, width);
+    r.operand_b = sv_value(op2, width);
+    r.imm       = sv_value(op3, width);
+    r.result    = sv_value(result, result_width);
+    r.dst_bis   = dst_env.bis;
+    r.dst_es    = dst_env.es;
+    r.src_bis   = src_env.bis;
+    r.src_es    = src_env.es;
+    r.entry     = FPU_STATS_DPI;
+    r.op        = op;
+    r.rm        = rm;
+    r.flags     = flags;
+    r.aux       = aux;
+    fpu_trace_write(&r);
+}
+
+// Record a call of an opcode entry
+static void trace_exec(int entry, int64_t operation, int64_t operand_a, int64_t operand_b, int64_t imm, int64_t fmt,
+                       int64_t rm, int xlen, int flen, uint64_t result, int flags)
+{
+    fpu_trace_record r;
+    memset(&r, 0, sizeof(r));
+    r.operand_a = operand_a;
+    r.operand_b = operand_b;
+    r.imm       = imm;
+    r.result    = result;
+    r.entry     = entry;
+    r.op        = operation;
+    r.fmt       = fmt;
+    r.rm        = rm;
+    r.flags     = flags;
+    r.aux       = (xlen / 32) | (flen / 32) << 4;
+    fpu_trace_write(&r);
+}
+
+// Sample a call of a per-operation entry in the coverage, the call is mapped on the fields of an opcode request
+static void cov_dpi(int op, environment dst_env, environment src_env, int width, const svBitVecVal* op1,
+                    const svBitVecVal* op2, const svBitVecVal* op3, int result_width, const svBitVecVal* result,
+                    int rm, int aux, int flags)
+{
+    int      fmt     = fpu_fmt_from_env(dst_env);
+    int      src_fmt = fpu_fmt_from_env(src_env);
+    uint64_t a = sv_value(op1, width), b = sv_value(op2, width), c = sv_value(op3, width);
+
+    if (fmt < 0 || fmt >= FPU_DST_FMT_NUM || src_fmt < 0)
+        return;
+    if (op == FPU_OP_FADD || op == FPU_OP_FSUB)
     {
-        rnd_c = MPFR_RNDD;
+        c = b;
+        b = a;
+        a = 0;
     }
-    else if (rnd_rtl == 3) {
-        rnd_c = MPFR_RNDU;
-    }
-    else if (rnd_rtl == 4) {
-        rnd_c = MPFR_RNDNA;
+    else if (op == FPU_OP_FCVT_F2F)
+        c = src_fmt;
+    else if (op == FPU_OP_FCVT_F2I || op == FPU_OP_FCVT_I2F)
+        c = aux ^ 0x1; // imm[0] is set for unsigned integers
+    fpu_cov_record(op, a, b, c, fmt, rm, 0, sv_value(result, result_width), flags);
+}
+
+// Statistics, probes, trace and coverage of a per-operation entry. It is built first in the entry so that the time of
+// the call runs until done, which records the result. Widths of 0 are the widths of the formats.
+struct dpi_hooks
+{
+    uint64_t           start;
+    int                op, fmt, rm, aux, width, result_width;
+    environment        dst_env, src_env;
+    const svBitVecVal* op1;
+    const svBitVecVal* op2;
+    const svBitVecVal* op3;
+    const svBitVecVal* result;
+
+    dpi_hooks(int entry_op, const env_t* dst, const env_t* src, int operand_width, const svBitVecVal* a,
+              const svBitVecVal* b, const svBitVecVal* c, int res_width, const svBitVecVal* res, int entry_rm,
+              int entry_aux)
+    {
+        start        = fpu_stats_begin();
+        op           = entry_op;
+        rm           = entry_rm;
+        aux          = entry_aux;
+        op1          = a;
+        op2          = b;
+        op3          = c;
+        result       = res;
+        dst_env.bis  = dst->bis;
+        dst_env.es   = dst->es;
+        src_env.bis  = src->bis;
+        src_env.es   = src->es;
+        fmt          = fpu_fmt_from_env(dst_env);
+        width        = operand_width != 0 ? operand_width : env_width(src_env);
+        result_width = res_width != 0 ? res_width : env_width(dst_env);
+        FPU_PROBE4(dpi_entry, FPU_STATS_DPI, op, fmt, rm);
     }
-    else {
-        rnd_c = static_cast<mpfr_rnd_t>(rnd_rtl);
+
+    // Record the call, flags is returned by the entry
+    int done(int flags)
+    {
+        if (fpu_trace_enabled())
+            trace_dpi(op, dst_env, src_env, width, op1, op2, op3, result_width, result, rm < 0 ? 0 : rm, aux, flags);
+        if (fpu_cov_enabled())
+            cov_dpi(op, dst_env, src_env, width, op1, op2, op3, result_width, result, rm < 0 ? 0 : rm, aux, flags);
+        FPU_PROBE5(dpi_return, FPU_STATS_DPI, op, fmt, rm, flags);
+        fpu_stats_end(start, FPU_STATS_DPI, op, fmt, flags);
+        return flags;
     }
-    return rnd_c;    
-}
+};
 
 int dpi_fadd(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2, int rounding_mode, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FADD, env, env, 0, op1, op2, NULL, 0, result, rounding_mode, 0);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -64,11 +186,12 @@ int dpi_fadd(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2
     
     int res = add(result, op1_cast, op2_cast, rnd_cast, env_c);
 	
-	return res;
+	return hooks.done(res);
 }
 
 int dpi_fsub(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2, int rounding_mode, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FSUB, env, env, 0, op1, op2, NULL, 0, result, rounding_mode, 0);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -82,11 +205,12 @@ int dpi_fsub(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2
     
     int res = sub(result, op1_cast, op2_cast, rnd_cast, env_c);
 	
-	return res;
+	return hooks.done(res);
 }
 
 int dpi_fmul(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2, int rounding_mode, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FMUL, env, env, 0, op1, op2, NULL, 0, result, rounding_mode, 0);
     environment env_c;
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -103,11 +227,12 @@ int dpi_fmul(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2
     
     int res = mul(result, op1_cast, op2_cast, rnd_cast, env_c);
 	
-	return res;
+	return hooks.done(res);
 }
 
 int dpi_fdiv(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2, int rounding_mode, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FDIV, env, env, 0, op1, op2, NULL, 0, result, rounding_mode, 0);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -123,11 +248,12 @@ int dpi_fdiv(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2
     
     int res = div(result, op1_cast, op2_cast, rnd_cast, env_c);
 	
-	return res;
+	return hooks.done(res);
 }
 
 int dpi_fma(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2, const svBitVecVal *op3, int rounding_mode, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FMADD, env, env, 0, op1, op2, op3, 0, result, rounding_mode, 0);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -142,11 +268,12 @@ int dpi_fma(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2,
     mpfr_rnd_t rnd_cast = rnd_rtl_to_c(rounding_mode);
 
     int res = fma(result, op1_cast, op2_cast, op3_cast, rnd_cast, env_c);
-	return res;
+	return hooks.done(res);
 }
 
 int dpi_fms(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2, const svBitVecVal *op3, int rounding_mode, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FMSUB, env, env, 0, op1, op2, op3, 0, result, rounding_mode, 0);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -161,11 +288,12 @@ int dpi_fms(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2,
     mpfr_rnd_t rnd_cast = rnd_rtl_to_c(rounding_mode);
     
     int res = fms(result, op1_cast, op2_cast, op3_cast, rnd_cast, env_c);
-	return res;
+	return hooks.done(res);
 }
 
 int dpi_fnma(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2, const svBitVecVal *op3, int rounding_mode, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FNMADD, env, env, 0, op1, op2, op3, 0, result, rounding_mode, 0);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -181,11 +309,12 @@ int dpi_fnma(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2
     
     int res = fnma(result, op1_cast, op2_cast, op3_cast, rnd_cast, env_c);
 
-    return res;
+    return hooks.done(res);
 }
 
 int dpi_fnms(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2, const svBitVecVal *op3, int rounding_mode, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FNMSUB, env, env, 0, op1, op2, op3, 0, result, rounding_mode, 0);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -201,11 +330,12 @@ int dpi_fnms(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2
     
     int res = fnms(result, op1_cast, op2_cast, op3_cast, rnd_cast, env_c);
     
-    return res;
+    return hooks.done(res);
 }
 
 int dpi_fsqrt(svBitVecVal *result, const svBitVecVal *op, int rounding_mode, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FSQRT, env, env, 0, op, NULL, NULL, 0, result, rounding_mode, 0);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -217,11 +347,12 @@ int dpi_fsqrt(svBitVecVal *result, const svBitVecVal *op, int rounding_mode, con
     mpfr_rnd_t rnd_cast = rnd_rtl_to_c(rounding_mode);
     
     int res = sqrt(result, op_cast, rnd_cast, env_c);    
-	return res;
+	return hooks.done(res);
 }
 
 int dpi_fcmp(svBitVecVal* result, const svBitVecVal *op1, const svBitVecVal *op2, int rounding_mode, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FCMP, env, env, 0, op1, op2, NULL, 32, result, rounding_mode, 0);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -235,19 +366,20 @@ int dpi_fcmp(svBitVecVal* result, const svBitVecVal *op1, const svBitVecVal *op2
     switch (rounding_mode)
     {
     case 0:
-        return cmp_leq(result, op1_cast, op2_cast, env_c);
+        return hooks.done(cmp_leq(result, op1_cast, op2_cast, env_c));
         break;
     case 1:
-        return cmp_lt(result, op1_cast, op2_cast, env_c);
+        return hooks.done(cmp_lt(result, op1_cast, op2_cast, env_c));
         break;    
     default:
-        return cmp_eq(result, op1_cast, op2_cast, env_c);
+        return hooks.done(cmp_eq(result, op1_cast, op2_cast, env_c));
         break;
     }
 }
 
 int dpi_fmin_max(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2, int rounding_mode, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FMIN_MAX, env, env, 0, op1, op2, NULL, 0, result, rounding_mode, 0);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -262,16 +394,17 @@ int dpi_fmin_max(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal
     switch (rounding_mode)
     {
     case 0:
-        return fmin(result, op1_cast, op2_cast, rnd_cast, env_c);
+        return hooks.done(fmin(result, op1_cast, op2_cast, rnd_cast, env_c));
         break;
     default:
-        return fmax(result, op1_cast, op2_cast, rnd_cast, env_c);
+        return hooks.done(fmax(result, op1_cast, op2_cast, rnd_cast, env_c));
         break;
     }
 }
 
 int dpi_fsgnj(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op2, int rounding_mode, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FSGNJ, env, env, 0, op1, op2, NULL, 0, result, rounding_mode, 0);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -283,11 +416,12 @@ int dpi_fsgnj(svBitVecVal *result, const svBitVecVal *op1, const svBitVecVal *op
     uint32_t* op2_cast  = const_cast<uint32_t*>(op2);
     mpfr_rnd_t rnd_cast = rnd_rtl_to_c(rounding_mode);
     
-    return fsgnj(result, op1_cast, op2_cast, rnd_cast, env_c);
+    return hooks.done(fsgnj(result, op1_cast, op2_cast, rnd_cast, env_c));
 }
 
 int dpi_fmv_f2x(svBitVecVal *result, const svBitVecVal *op1, const env_t* env, int nchunks)
 {
+    dpi_hooks hooks(FPU_OP_FMV_F2X, env, env, 0, op1, NULL, NULL, 32 * nchunks, result, -1, nchunks);
     environment env_c;
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -297,10 +431,11 @@ int dpi_fmv_f2x(svBitVecVal *result, const svBitVecVal *op1, const env_t* env, i
 
     uint32_t* op1_cast  = const_cast<uint32_t*>(op1);
     
-    return fmv_f2x(result, op1_cast, env_c, nchunks);
+    return hooks.done(fmv_f2x(result, op1_cast, env_c, nchunks));
 }
 int dpi_fclass(svBitVecVal *result, const svBitVecVal *op1, const env_t* env)
 {
+    dpi_hooks hooks(FPU_OP_FCLASS, env, env, 0, op1, NULL, NULL, 32, result, -1, 0);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -311,11 +446,13 @@ int dpi_fclass(svBitVecVal *result, const svBitVecVal *op1, const env_t* env)
     uint32_t* op1_cast  = const_cast<uint32_t*>(op1);
 
     int res = fclass(result, op1_cast, env_c);
-    return res;
+    return hooks.done(res);
 }
 
 int dpi_fcvt_f2i(svBitVecVal *result, const svBitVecVal *op1, int rounding_mode, const env_t* env, int is_signed, int int_format)
 {
+    dpi_hooks hooks(FPU_OP_FCVT_F2I, env, env, 0, op1, NULL, NULL, int_format ? 64 : 32, result, rounding_mode,
+                    is_signed | int_format << 1);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -329,16 +466,18 @@ int dpi_fcvt_f2i(svBitVecVal *result, const svBitVecVal *op1, int rounding_mode,
     switch (int_format)
     {
     case 1: // INT64
-        return fcvt_f2i64(result, op1_cast, is_signed, rnd_cast, env_c);
+        return hooks.done(fcvt_f2i64(result, op1_cast, is_signed, rnd_cast, env_c));
         break;
     default: // INT32
-        return fcvt_f2i32(result, op1_cast, is_signed, rnd_cast, env_c);
+        return hooks.done(fcvt_f2i32(result, op1_cast, is_signed, rnd_cast, env_c));
         break;
     }
 }
 
 int dpi_fcvt_i2f(svBitVecVal *result, const svBitVecVal *op1, int rounding_mode, const env_t* env, int is_signed, int int_format)
 {
+    dpi_hooks hooks(FPU_OP_FCVT_I2F, env, env, int_format ? 64 : 32, op1, NULL, NULL, 0, result, rounding_mode,
+                    is_signed | int_format << 1);
     environment env_c; 
 
     env_t* env_cast = const_cast<env_t*>(env);
@@ -349,11 +488,12 @@ int dpi_fcvt_i2f(svBitVecVal *result, const svBitVecVal *op1, int rounding_mode,
     uint32_t* op1_cast  = const_cast<uint32_t*>(op1);
     mpfr_rnd_t rnd_cast = rnd_rtl_to_c(rounding_mode);
     
-    return fcvt_i2f(result, op1_cast, is_signed, int_format, rnd_cast, env_c);
+    return hooks.done(fcvt_i2f(result, op1_cast, is_signed, int_format, rnd_cast, env_c));
 }
 
 int dpi_fcvt_f2f(svBitVecVal *result, const svBitVecVal *op1, int rounding_mode, const env_t* src_env, const env_t* dst_env)
 {
+    dpi_hooks hooks(FPU_OP_FCVT_F2F, dst_env, src_env, 0, op1, NULL, NULL, 0, result, rounding_mode, 0);
     environment src_env_c, dst_env_c; 
 
     env_t* src_env_cast = const_cast<env_t*>(src_env);
@@ -368,5 +508,426 @@ int dpi_fcvt_f2f(svBitVecVal *result, const svBitVecVal *op1, int rounding_mode,
     uint32_t* op1_cast  = const_cast<uint32_t*>(op1);
     mpfr_rnd_t rnd_cast = rnd_rtl_to_c(rounding_mode);
     
-    return fcvt_f2f(result, op1_cast, rnd_cast, src_env_c, dst_env_c);
+    return hooks.done(fcvt_f2f(result, op1_cast, rnd_cast, src_env_c, dst_env_c));
+}
+
+int64_t dpi_fpu_exec(int64_t operation, int64_t operand_a, int64_t operand_b, int64_t imm, int64_t fmt, int64_t rm, int xlen, int flen,
+                     int* flags)
+{
+    uint64_t start = fpu_stats_begin();
+    uint64_t result;
+    FPU_PROBE4(dpi_entry, FPU_STATS_EXEC, operation, fmt, rm);
+    *flags = fpu_exec(&result, (int) operation, (uint64_t) operand_a, (uint64_t) operand_b, (uint64_t) imm, (int) fmt,
+                      (int) rm, xlen, flen);
+    FPU_PROBE5(dpi_return, FPU_STATS_EXEC, operation, fmt, rm, *flags);
+    if (fpu_trace_enabled())
+        trace_exec(FPU_STATS_EXEC, operation, operand_a, operand_b, imm, fmt, rm, xlen, flen, result, *flags);
+    if (fpu_cov_enabled())
+        fpu_cov_record((int) operation, operand_a, operand_b, imm, (int) fmt, (int) rm, xlen, result, *flags);
+    fpu_stats_end(start, FPU_STATS_EXEC, operation, fmt, *flags);
+    return (int64_t) result;
+}
+
+int dpi_fpu_exec_all_rm(int64_t operation, int64_t operand_a, int64_t operand_b, int64_t imm, int64_t fmt, int xlen, int flen,
+                        int64_t* result, int* flags)
+{
+    uint64_t start = fpu_stats_begin();
+    FPU_PROBE4(dpi_entry, FPU_STATS_EXEC_ALL_RM, operation, fmt, -1);
+    fpu_all_rm_record record;
+    int status = fpu_exec_all_rm(&record, (int) operation, (uint64_t) operand_a, (uint64_t) operand_b, (uint64_t) imm,
+                                 (int) fmt, xlen, flen);
+
+    int any_flags = 0;
+    for (int rm = 0; rm < FPU_RM_NUM; rm++)
+    {
+        any_flags |= status == 0 ? record.flags[rm] : 0;
+        result[rm] = (int64_t) record.result[rm];
+        flags[rm]  = status == 0 ? record.flags[rm] : -1;
+    }
+    FPU_PROBE5(dpi_return, FPU_STATS_EXEC_ALL_RM, operation, fmt, -1, status == 0 ? any_flags : -1);
+    if (fpu_trace_enabled())
+        for (int rm = 0; rm < FPU_RM_NUM; rm++)
+            trace_exec(FPU_STATS_EXEC_ALL_RM, operation, operand_a, operand_b, imm, fmt, rm, xlen, flen, result[rm], flags[rm]);
+    if (fpu_cov_enabled())
+        for (int rm = 0; rm < FPU_RM_NUM; rm++)
+            fpu_cov_record((int) operation, operand_a, operand_b, imm, (int) fmt, (int) rm, xlen, result[rm], flags[rm]);
+    fpu_stats_end(start, FPU_STATS_EXEC_ALL_RM, operation, fmt, status == 0 ? any_flags : -1);
+    return status;
+}
+
+void dpi_refmodel_cache_enable(int entries)
+{
+    fpu_cache_enable(entries > 0 ? entries : 0);
+}
+
+int dpi_refmodel_cache_capacity()
+{
+    return fpu_cache_capacity();
+}
+
+int64_t dpi_refmodel_cache_hits()
+{
+    fpu_cache_stats stats;
+    fpu_cache_get_stats(&stats);
+    return stats.hits;
+}
+
+int64_t dpi_refmodel_cache_misses()
+{
+    fpu_cache_stats stats;
+    fpu_cache_get_stats(&stats);
+    return stats.misses;
+}
+
+int64_t dpi_refmodel_cache_evictions()
+{
+    fpu_cache_stats stats;
+    fpu_cache_get_stats(&stats);
+    return stats.evictions;
+}
+
+int dpi_refmodel_store_open(const char* path, int entries)
+{
+    return fpu_store_open(path, entries > 0 ? entries : 0);
+}
+
+int dpi_refmodel_store_enabled()
+{
+    return fpu_store_enabled();
+}
+
+int64_t dpi_refmodel_store_hits()
+{
+    fpu_store_stats stats;
+    fpu_store_get_stats(&stats);
+    return stats.hits;
+}
+
+int64_t dpi_refmodel_store_misses()
+{
+    fpu_store_stats stats;
+    fpu_store_get_stats(&stats);
+    return stats.misses;
+}
+
+int64_t dpi_refmodel_store_inserts()
+{
+    fpu_store_stats stats;
+    fpu_store_get_stats(&stats);
+    return stats.inserts;
+}
+
+int64_t dpi_refmodel_store_evictions()
+{
+    fpu_store_stats stats;
+    fpu_store_get_stats(&stats);
+    return stats.evictions;
+}
+
+void dpi_refmodel_stats_enable(int enable)
+{
+    fpu_stats_enable(enable != 0);
+}
+
+int dpi_refmodel_stats_enabled()
+{
+    return fpu_stats_enabled();
+}
+
+int dpi_refmodel_report(const char* json_path)
+{
+    return fpu_stats_report(stdout, json_path);
+}
+
+int dpi_refmodel_trace_open(const char* path, int compress)
+{
+    return fpu_trace_open(path, compress != 0);
+}
+
+void dpi_refmodel_trace_close()
+{
+    fpu_trace_close();
+}
+
+void dpi_refmodel_trace_context(int64_t trans_id, int64_t sim_time)
+{
+    fpu_trace_set_context((uint64_t) trans_id, (uint64_t) sim_time);
+}
+
+int dpi_refmodel_cov_open(const char* path)
+{
+    return fpu_cov_open(path);
+}
+
+void dpi_refmodel_cov_enable(int enable)
+{
+    fpu_cov_enable(enable != 0);
+}
+
+int dpi_refmodel_cov_enabled()
+{
+    return fpu_cov_enabled();
+}
+
+int dpi_refmodel_cov_save()
+{
+    return fpu_cov_save();
+}
+
+int dpi_refmodel_cov_load(const char* path)
+{
+    return fpu_cov_load(path);
+}
+
+double dpi_refmodel_cov_closure(int op, int fmt, int point)
+{
+    fpu_cov_closure closure;
+    fpu_cov_get_closure(&closure, op, fmt, point);
+    return closure.goals ? 100.0 * closure.hits / closure.goals : 100.0;
+}
+
+int64_t dpi_refmodel_cov_count(int op, int fmt, int point, int bin)
+{
+    return fpu_cov_count(op, fmt, point, bin);
+}
+
+int dpi_refmodel_cov_next_unhit(int op, int fmt, int point, int bin)
+{
+    return fpu_cov_next_unhit(op, fmt, point, bin);
+}
+
+int64_t dpi_refmodel_cov_unhit(int op, int fmt, int point)
+{
+    fpu_cov_closure closure;
+    fpu_cov_get_closure(&closure, op, fmt, point);
+    return (int64_t) (closure.goals - closure.hits);
+}
+
+int dpi_refmodel_cov_unhit_bins(int op, int fmt, int point, int* bins)
+{
+    return fpu_cov_unhit_bins(op, fmt, point, bins, FPU_COV_MAX_BINS);
+}
+
+int dpi_refmodel_cov_report(const char* json_path)
+{
+    return fpu_cov_report(stdout, json_path);
+}
+
+// Operand generator of the sequences, seeded with 1 until dpi_fpu_gen_seed is called
+static fpu_gen* dpi_gen()
+{
+    static fpu_gen gen;
+    static bool    seeded = false;
+
+    if (!seeded)
+    {
+        fpu_gen_init(&gen, 1);
+        seeded = true;
+    }
+    return &gen;
+}
+
+static inline environment env_of(const env_t* env)
+{
+    environment env_c;
+    env_c.bis = env->bis;
+    env_c.es  = env->es;
+    return env_c;
+}
+
+void dpi_fpu_gen_seed(int64_t seed)
+{
+    fpu_gen_init(dpi_gen(), (uint64_t) seed);
+}
+
+void dpi_fpu_gen_weights(const int* class_w, const int* mant_w, const int* int_w)
+{
+    uint32_t w_class[FPU_GEN_CLASS_NUM], w_mant[FPU_GEN_MANT_NUM], w_int[FPU_GEN_INT_NUM];
+
+    for (int k = 0; k < FPU_GEN_CLASS_NUM; k++)
+        w_class[k] = class_w[k] > 0 ? class_w[k] : 0;
+    for (int k = 0; k < FPU_GEN_MANT_NUM; k++)
+        w_mant[k] = mant_w[k] > 0 ? mant_w[k] : 0;
+    for (int k = 0; k < FPU_GEN_INT_NUM; k++)
+        w_int[k] = int_w[k] > 0 ? int_w[k] : 0;
+    fpu_gen_set_weights(dpi_gen(), w_class, w_mant, w_int);
+}
+
+int64_t dpi_fpu_gen_float(const env_t* env)
+{
+    return fpu_gen_float(dpi_gen(), env_of(env));
+}
+
+int64_t dpi_fpu_gen_float_of(const env_t* env, int cls, int mant)
+{
+    return fpu_gen_float_of(dpi_gen(), env_of(env), cls, mant);
+}
+
+int64_t dpi_fpu_gen_corner(const env_t* env, int corner)
+{
+    return fpu_gen_corner(env_of(env), corner);
+}
+
+int64_t dpi_fpu_gen_int()
+{
+    return fpu_gen_int(dpi_gen());
+}
+
+int dpi_fpu_hard_operands(int op, const env_t* env, int hard, int64_t* operand_a, int64_t* operand_b, int64_t* imm)
+{
+    uint64_t a, b, c;
+    int      status = fpu_hard_operands(dpi_gen(), op, env_of(env), hard, &a, &b, &c);
+
+    *operand_a = (int64_t) a;
+    *operand_b = (int64_t) b;
+    *imm       = (int64_t) c;
+    return status;
+}
+
+int dpi_fpu_golden_open(const char* path, int xlen, int flen)
+{
+    return fpu_golden_open(path, xlen, flen);
+}
+
+void dpi_fpu_golden_close()
+{
+    fpu_golden_close();
+}
+
+int64_t dpi_fpu_golden_count()
+{
+    return (int64_t) fpu_golden_count();
+}
+
+int dpi_fpu_golden_request(int64_t index, int* op, int64_t* operand_a, int64_t* operand_b, int64_t* imm, int* fmt,
+                           int* rm, int* delay)
+{
+    const fpu_golden_record* r = fpu_golden_get((uint64_t) index);
+    if (r == NULL)
+        return -1;
+    *op        = r->op;
+    *operand_a = (int64_t) r->operand_a;
+    *operand_b = (int64_t) r->operand_b;
+    *imm       = (int64_t) r->imm;
+    *fmt       = r->fmt;
+    *rm        = r->rm;
+    *delay     = (int) r->delay;
+    return 0;
+}
+
+int dpi_fpu_golden_expected(int64_t index, int64_t* result, int* flags)
+{
+    const fpu_golden_record* r = fpu_golden_get((uint64_t) index);
+    if (r == NULL)
+        return -1;
+    *result = (int64_t) r->result;
+    *flags  = r->flags;
+    return 0;
+}
+
+int dpi_fpu_golden_recorded()
+{
+    const fpu_golden_header* header = fpu_golden_get_header();
+    return header != NULL && (header->flags & FPU_GOLDEN_RECORDED) ? 1 : 0;
+}
+
+int64_t dpi_fpu_golden_trans_id(int64_t index)
+{
+    const fpu_golden_record* r = fpu_golden_get((uint64_t) index);
+    return r != NULL ? (int64_t) r->trans_id : -1;
+}
+
+int dpi_fpu_golden_record_open(const char* path, int xlen, int flen)
+{
+    return fpu_golden_record_open(path, xlen, flen);
+}
+
+void dpi_fpu_golden_record(int op, int64_t operand_a, int64_t operand_b, int64_t imm, int fmt, int rm,
+                           int64_t trans_id, int delay)
+{
+    fpu_golden_record r;
+    memset(&r, 0, sizeof(r));
+    r.op        = op;
+    r.operand_a = (uint64_t) operand_a;
+    r.operand_b = (uint64_t) operand_b;
+    r.imm       = (uint64_t) imm;
+    r.fmt       = fmt;
+    r.rm        = rm;
+    r.trans_id  = (uint64_t) trans_id;
+    r.delay     = delay > 0 ? delay : 0;
+    fpu_golden_record_write(&r);
+}
+
+void dpi_fpu_golden_record_close()
+{
+    fpu_golden_record_close();
+}
+
+int dpi_refmodel_novelty_open(const char* path, int64_t entries)
+{
+    return fpu_novelty_open(path, entries > 0 ? (uint64_t) entries : 0);
+}
+
+int dpi_refmodel_novelty_enabled()
+{
+    return fpu_novelty_enabled();
+}
+
+int dpi_fpu_novelty_resample(int op, int64_t operand_a, int64_t operand_b, int64_t imm, int fmt, int rm, int xlen,
+                             int flen, int percent)
+{
+    fpu_cache_key key = fpu_cache_make_key(op, operand_a, operand_b, imm, fmt, rm, xlen, flen);
+    return fpu_novelty_resample(&key, percent > 0 ? percent : 0, fpu_gen_next(dpi_gen()));
+}
+
+int dpi_fpu_novelty_insert(int op, int64_t operand_a, int64_t operand_b, int64_t imm, int fmt, int rm, int xlen,
+                           int flen)
+{
+    fpu_cache_key key = fpu_cache_make_key(op, operand_a, operand_b, imm, fmt, rm, xlen, flen);
+    return fpu_novelty_insert(&key);
+}
+
+int64_t dpi_refmodel_novelty_lookups()
+{
+    fpu_novelty_stats stats;
+    fpu_novelty_get_stats(&stats);
+    return stats.lookups;
+}
+
+int64_t dpi_refmodel_novelty_hits()
+{
+    fpu_novelty_stats stats;
+    fpu_novelty_get_stats(&stats);
+    return stats.hits;
+}
+
+int64_t dpi_refmodel_novelty_resamples()
+{
+    fpu_novelty_stats stats;
+    fpu_novelty_get_stats(&stats);
+    return stats.resamples;
+}
+
+int64_t dpi_refmodel_novelty_inserts()
+{
+    fpu_novelty_stats stats;
+    fpu_novelty_get_stats(&stats);
+    return stats.inserts;
+}
+
+int64_t dpi_refmodel_novelty_novel()
+{
+    fpu_novelty_stats stats;
+    fpu_novelty_get_stats(&stats);
+    return stats.novel;
+}
+
+int64_t dpi_refmodel_novelty_count()
+{
+    return (int64_t) fpu_novelty_count();
+}
+
+double dpi_refmodel_novelty_fill()
+{
+    return fpu_novelty_fill();
 }
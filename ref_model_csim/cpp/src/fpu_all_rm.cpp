@@ -0,0 +1,342 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Evaluation of an operation in every rounding mode
+ *  History       :
+ */
+
+#include "fpu_all_rm.h"
+#include "intfp.h"
+
+#define RM_RNE 0
+#define RM_RDN 2
+#define RM_RUP 3
+#define RM_RMM 4
+
+bool fpu_all_rm_supported(int op)
+{
+    switch (op)
+    {
+    case FPU_OP_FADD:
+    case FPU_OP_FSUB:
+    case FPU_OP_FMUL:
+    case FPU_OP_FDIV:
+    case FPU_OP_FMADD:
+    case FPU_OP_FNMADD:
+    case FPU_OP_FMSUB:
+    case FPU_OP_FNMSUB:
+    case FPU_OP_FSQRT:
+    case FPU_OP_FCVT_F2I:
+    case FPU_OP_FCVT_I2F:
+    case FPU_OP_FCVT_F2F:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//########## OPERANDS ##################################################################################################
+
+typedef struct
+{
+    bool     special;   // Inf or NaN
+    bool     zero;
+    bool     sign;
+    uint64_t sig;
+    int      exp;       // value is (-1)^sign * sig * 2^exp
+} operand;
+
+static operand decode(const uint32_t* op, environment env)
+{
+    operand o;
+    int      t     = MBITS(env);
+    int      width = env.bis + 1;
+    uint64_t x     = ((uint64_t) op[1] << 32) | op[0];
+    uint64_t E_max = (1ULL << (env.es + 1)) - 1;
+    uint64_t T     = x & ((1ULL << t) - 1);
+    uint64_t E     = (x >> t) & E_max;
+    int      bias  = (1 << env.es) - 1;
+
+    o.sign    = (x >> (width - 1)) & 1;
+    o.special = E == E_max;
+    o.zero    = E == 0 && T == 0;
+    o.sig     = (E == 0) ? T : (T | (1ULL << t));
+    o.exp     = ((E == 0) ? 1 - bias : (int) E - bias) - t;
+    return o;
+}
+
+static void set_operand(mpfr_t x, const operand* o)
+{
+    if (o->zero)
+        mpfr_set_zero(x, o->sign ? -1 : 1);
+    else
+    {
+        mpfr_set_ui_2exp(x, o->sig, o->exp, MPFR_RNDN);
+        if (o->sign)
+            mpfr_neg(x, x, MPFR_RNDN);
+    }
+}
+
+//########## EXACT EVALUATION ##########################################################################################
+
+// Exponent range of MPFR widened to its limits, restored when the scope is left
+struct wide_exponent_range
+{
+    mpfr_exp_t emin, emax;
+
+    wide_exponent_range() : emin(mpfr_get_emin()), emax(mpfr_get_emax())
+    {
+        mpfr_set_emin(mpfr_get_emin_min());
+        mpfr_set_emax(mpfr_get_emax_max());
+    }
+    ~wide_exponent_range()
+    {
+        mpfr_set_emin(emin);
+        mpfr_set_emax(emax);
+    }
+};
+
+// Evaluate the operation in r, rounded toward zero to the precision of r, in the current exponent range. Return false if
+// an operand is Inf or NaN or if op has no evaluation, the ternary value of MPFR in inex otherwise.
+static bool evaluate(mpfr_t r, int* inex, int op, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    const uint32_t* inputs[3];
+    int ninputs;
+
+    switch (op)
+    {
+    case FPU_OP_FADD:
+    case FPU_OP_FSUB:
+        inputs[0] = op2; inputs[1] = op3; ninputs = 2;
+        break;
+    case FPU_OP_FMUL:
+    case FPU_OP_FDIV:
+        inputs[0] = op1; inputs[1] = op2; ninputs = 2;
+        break;
+    case FPU_OP_FMADD:
+    case FPU_OP_FNMADD:
+    case FPU_OP_FMSUB:
+    case FPU_OP_FNMSUB:
+        inputs[0] = op1; inputs[1] = op2; inputs[2] = op3; ninputs = 3;
+        break;
+    case FPU_OP_FSQRT:
+    case FPU_OP_FCVT_F2I:
+    case FPU_OP_FCVT_F2F:
+        inputs[0] = op1; ninputs = 1;
+        break;
+    case FPU_OP_FCVT_I2F:
+        ninputs = 0;
+        break;
+    default:
+        return false;
+    }
+
+    environment in_env = (op == FPU_OP_FCVT_F2F) ? ctx->src_env : ctx->dst_env;
+    operand in[3];
+    for (int i = 0; i < ninputs; i++)
+    {
+        in[i] = decode(inputs[i], in_env);
+        if (in[i].special)
+            return false;
+    }
+
+    mpfr_t x[3];
+    for (int i = 0; i < ninputs; i++)
+    {
+        mpfr_init2(x[i], 64);
+        set_operand(x[i], &in[i]);
+    }
+
+    switch (op)
+    {
+    case FPU_OP_FADD:   *inex = mpfr_add(r, x[0], x[1], MPFR_RNDZ); break;
+    case FPU_OP_FSUB:   *inex = mpfr_sub(r, x[0], x[1], MPFR_RNDZ); break;
+    case FPU_OP_FMUL:   *inex = mpfr_mul(r, x[0], x[1], MPFR_RNDZ); break;
+    case FPU_OP_FDIV:   *inex = mpfr_div(r, x[0], x[1], MPFR_RNDZ); break;
+    case FPU_OP_FSQRT:  *inex = mpfr_sqrt(r, x[0], MPFR_RNDZ);      break;
+    case FPU_OP_FCVT_F2I:
+    case FPU_OP_FCVT_F2F: *inex = mpfr_set(r, x[0], MPFR_RNDZ);     break;
+    case FPU_OP_FMADD:
+        *inex = mpfr_fma(r, x[0], x[1], x[2], MPFR_RNDZ);
+        break;
+    case FPU_OP_FMSUB:
+        *inex = mpfr_fms(r, x[0], x[1], x[2], MPFR_RNDZ);
+        break;
+    case FPU_OP_FNMADD: // -(a*b)-c
+        mpfr_neg(x[0], x[0], MPFR_RNDN);
+        *inex = mpfr_fms(r, x[0], x[1], x[2], MPFR_RNDZ);
+        break;
+    case FPU_OP_FNMSUB: // -(a*b)+c
+        mpfr_neg(x[0], x[0], MPFR_RNDN);
+        *inex = mpfr_fma(r, x[0], x[1], x[2], MPFR_RNDZ);
+        break;
+    case FPU_OP_FCVT_I2F:
+    {
+        uint64_t value = ctx->int_format ? (((uint64_t) op1[1] << 32) | op1[0]) : op1[0];
+        bool negative  = ctx->is_signed && (ctx->int_format ? (int64_t) value < 0 : (int32_t) value < 0);
+        if (negative)
+            value = ctx->int_format ? -value : (uint32_t) -value;
+        *inex = mpfr_set_ui_2exp(r, value, 0, MPFR_RNDZ);
+        if (negative)
+            mpfr_neg(r, r, MPFR_RNDN);
+        break;
+    }
+    }
+
+    for (int i = 0; i < ninputs; i++)
+        mpfr_clear(x[i]);
+    return true;
+}
+
+//########## ROUNDED TO ODD EVALUATION #################################################################################
+
+// Compute the operation rounded to odd with two extra bits, return false if it cannot be derived
+static bool derive(uint64_t* raw, int* flags, int op, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    // The flags of the conversions to integers are the ones of the MPFR integer conversions
+    if (op == FPU_OP_FCVT_F2I)
+        return false;
+
+    wide_exponent_range range;
+    mpfr_t r;
+    int inex = 0;
+    mpfr_init2(r, MBITS(ctx->dst_env) + 3);
+    if (!evaluate(r, &inex, op, op1, op2, op3, ctx))
+    {
+        mpfr_clear(r);
+        return false;
+    }
+
+    // Zero, infinite and NaN results depend on the operands only, they are left to the handler
+    bool regular = mpfr_regular_p(r);
+    bool sign = mpfr_signbit(r);
+    mpz_t z;
+    mpz_init(z);
+    long exp = regular ? mpfr_get_z_2exp(z, r) : 0;
+    mpz_abs(z, z);
+    uint64_t sig = mpz_get_ui(z);
+
+    mpz_clear(z);
+    mpfr_clear(r);
+
+    if (!regular)
+        return false;
+
+    // Round to odd : the inexact bit is kept as the least significant bit
+    if (inex != 0)
+        sig |= 1;
+
+    for (int rm = 0; rm < FPU_RM_NUM; rm++)
+    {
+        flags[rm] = intfp_round(&raw[rm], sign, sig, (int) exp, rm, ctx->dst_env);
+        // Integer to float conversions only report inexact results, see get_conv_flags
+        if (op == FPU_OP_FCVT_I2F)
+            flags[rm] &= 0x1;
+    }
+    return true;
+}
+
+//########## HANDLER ###################################################################################################
+
+// True if the float to integer conversion of op is a tie, i.e. op is an odd multiple of 1/2
+static bool is_tie(const uint32_t* op, environment env)
+{
+    operand o = decode(op, env);
+    if (o.special || o.zero || o.exp >= 0 || o.exp < -63)
+        return false;
+    return (o.sig & ((1ULL << -o.exp) - 1)) == (1ULL << (-o.exp - 1));
+}
+
+void fpu_all_rm_compute(uint64_t* raw, int* flags, int op, int fmt, const uint32_t* op1, const uint32_t* op2,
+                        const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    if (derive(raw, flags, op, op1, op2, op3, ctx))
+        return;
+
+    fpu_exec_fn  handler = fpu_exec_get_handler(op, fmt);
+    fpu_exec_ctx rm_ctx  = *ctx;
+
+    for (int rm = RM_RNE; rm < RM_RMM; rm++)
+    {
+        uint32_t res[4] = { 0, 0, 0, 0 };
+        rm_ctx.rm = rm;
+        flags[rm] = handler(res, op1, op2, op3, &rm_ctx);
+        raw[rm]   = ((uint64_t) res[1] << 32) | res[0];
+    }
+
+    // Other results than the conversions to integers are exact here, they are the same in RMM and RNE
+    int rmm = RM_RNE;
+    if (op == FPU_OP_FCVT_F2I && is_tie(op1, ctx->dst_env))
+        rmm = decode(op1, ctx->dst_env).sign ? RM_RDN : RM_RUP;
+    raw[RM_RMM]   = raw[rmm];
+    flags[RM_RMM] = flags[rmm];
+}
+
+//########## TIES ######################################################################################################
+
+// Value of a raw floating point result of a handler, false if it is not finite
+static bool result_value(mpfr_t v, uint64_t raw, const fpu_exec_ctx* ctx)
+{
+    uint32_t res[2] = { (uint32_t) raw, (uint32_t) (raw >> 32) };
+    operand  o      = decode(res, ctx->dst_env);
+    if (o.special)
+        return false;
+    set_operand(v, &o);
+    return true;
+}
+
+int fpu_all_rm_tie(int op, uint64_t down, uint64_t up, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3,
+                   const fpu_exec_ctx* ctx)
+{
+    if (!fpu_all_rm_supported(op) || (down == up && op != FPU_OP_FCVT_F2I))
+        return -1;
+
+    // Enough bits for the exact sum of the product of two operands and of the smallest operand
+    environment in_env = (op == FPU_OP_FCVT_F2F) ? ctx->src_env : ctx->dst_env;
+    mpfr_prec_t prec   = (4 << in_env.es) + 4 * MBITS(ctx->dst_env) + 128;
+
+    wide_exponent_range range;
+    mpfr_t exact, lo, hi;
+    mpfr_inits2(prec, exact, lo, hi, (mpfr_ptr) 0);
+
+    int inex = 0;
+    int rm   = -1;
+    bool ok  = evaluate(exact, &inex, op, op1, op2, op3, ctx) && inex == 0 && mpfr_regular_p(exact);
+
+    // The integer results are saturated, a conversion is a tie if the operand is an odd multiple of 1/2
+    if (ok && op == FPU_OP_FCVT_F2I)
+    {
+        mpfr_mul_2si(lo, exact, 1, MPFR_RNDN);
+        if (mpfr_integer_p(lo) && !mpfr_integer_p(exact))
+            rm = mpfr_signbit(exact) ? RM_RDN : RM_RUP;
+    }
+    else if (ok && result_value(lo, down, ctx) && result_value(hi, up, ctx))
+    {
+        mpfr_add(lo, lo, hi, MPFR_RNDN);
+        mpfr_mul_2si(lo, lo, -1, MPFR_RNDN);
+        if (mpfr_equal_p(exact, lo))
+            rm = mpfr_signbit(exact) ? RM_RDN : RM_RUP;
+    }
+
+    mpfr_clears(exact, lo, hi, (mpfr_ptr) 0);
+    return rm;
+}
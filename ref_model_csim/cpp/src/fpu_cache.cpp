@@ -0,0 +1,207 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : In-process result cache of the reference model
+ *  History       :
+ */
+
+#include "fpu_cache.h"
+#include <atomic>
+#include <vector>
+#include <cstdlib>
+
+#define CTRL_VALID 0x80000000u
+
+typedef struct
+{
+    uint64_t operand_a;
+    uint64_t operand_b;
+    uint64_t imm;
+    uint64_t result;
+    uint32_t ctrl;      // key control word, CTRL_VALID set when the slot is used
+    int32_t  flags;
+} cache_entry;
+
+typedef struct
+{
+    uint32_t                 generation;
+    std::vector<cache_entry> slots;
+} cache_table;
+
+static std::atomic<uint32_t> cache_capacity(0);
+static std::atomic<uint32_t> cache_generation(0);
+
+static std::atomic<uint64_t> cache_hits(0);
+static std::atomic<uint64_t> cache_misses(0);
+static std::atomic<uint64_t> cache_evictions(0);
+
+static thread_local cache_table local_table = { 0, std::vector<cache_entry>() };
+
+// Read REFMODEL_CACHE when the library is loaded
+static struct cache_env_init
+{
+    cache_env_init()
+    {
+        const char* entries = getenv(FPU_CACHE_ENV_VAR);
+        if (entries != NULL)
+            fpu_cache_enable(strtoul(entries, NULL, 0));
+    }
+} cache_env_init_instance;
+
+fpu_cache_key fpu_cache_make_key(int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int rm, int xlen, int flen)
+{
+    fpu_cache_key key;
+    key.operand_a = operand_a;
+    key.operand_b = operand_b;
+    key.imm       = imm;
+    key.ctrl      = (op & 0xFF) | ((fmt & 0xF) << 8) | ((rm & 0xF) << 12) | (((xlen / 32) & 0xF) << 16) | (((flen / 32) & 0xF) << 20);
+    return key;
+}
+
+void fpu_cache_enable(uint32_t entries)
+{
+    uint32_t capacity = 0;
+    if (entries > 0)
+    {
+        capacity = 1;
+        while (capacity < entries && capacity < 0x80000000u)
+            capacity <<= 1;
+    }
+    cache_capacity.store(capacity);
+    cache_generation.fetch_add(1);
+}
+
+uint32_t fpu_cache_capacity()
+{
+    return cache_capacity.load(std::memory_order_relaxed);
+}
+
+static inline uint64_t mix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t fpu_cache_key_hash(const fpu_cache_key* key)
+{
+    uint64_t h = mix64(key->operand_a ^ ((uint64_t) key->ctrl << 32));
+    h = mix64(h ^ key->operand_b);
+    h = mix64(h ^ key->imm);
+    return h;
+}
+
+static inline bool key_equal(const cache_entry* e, const fpu_cache_key* key)
+{
+    return e->ctrl == (key->ctrl | CTRL_VALID) && e->operand_a == key->operand_a && e->operand_b == key->operand_b && e->imm == key->imm;
+}
+
+// Table of the calling thread, NULL if the cache is disabled
+static cache_table* get_table()
+{
+    uint32_t capacity = cache_capacity.load(std::memory_order_relaxed);
+    if (capacity == 0)
+        return NULL;
+
+    cache_table* t = &local_table;
+    uint32_t generation = cache_generation.load(std::memory_order_relaxed);
+    if (t->generation != generation || t->slots.size() != capacity)
+    {
+        cache_entry empty = { 0, 0, 0, 0, 0, 0 };
+        t->slots.assign(capacity, empty);
+        t->generation = generation;
+    }
+    return t;
+}
+
+bool fpu_cache_lookup(const fpu_cache_key* key, uint64_t* result, int* flags)
+{
+    cache_table* t = get_table();
+    if (t == NULL)
+        return false;
+
+    uint32_t mask = t->slots.size() - 1;
+    uint32_t home = fpu_cache_key_hash(key) & mask;
+
+    for (uint32_t i = 0; i < FPU_CACHE_MAX_PROBES; i++)
+    {
+        const cache_entry* e = &t->slots[(home + i) & mask];
+        if (!(e->ctrl & CTRL_VALID))
+            break;
+        if (key_equal(e, key))
+        {
+            *result = e->result;
+            *flags  = e->flags;
+            cache_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    cache_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void fpu_cache_insert(const fpu_cache_key* key, uint64_t result, int flags)
+{
+    cache_table* t = get_table();
+    if (t == NULL)
+        return;
+
+    uint32_t mask = t->slots.size() - 1;
+    uint32_t home = fpu_cache_key_hash(key) & mask;
+    cache_entry* slot = &t->slots[home];
+
+    for (uint32_t i = 0; i < FPU_CACHE_MAX_PROBES; i++)
+    {
+        cache_entry* e = &t->slots[(home + i) & mask];
+        if (!(e->ctrl & CTRL_VALID) || key_equal(e, key))
+        {
+            slot = e;
+            break;
+        }
+        if (i == FPU_CACHE_MAX_PROBES - 1)
+            cache_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    slot->operand_a = key->operand_a;
+    slot->operand_b = key->operand_b;
+    slot->imm       = key->imm;
+    slot->result    = result;
+    slot->ctrl      = key->ctrl | CTRL_VALID;
+    slot->flags     = flags;
+}
+
+void fpu_cache_get_stats(fpu_cache_stats* stats)
+{
+    stats->hits      = cache_hits.load(std::memory_order_relaxed);
+    stats->misses    = cache_misses.load(std::memory_order_relaxed);
+    stats->evictions = cache_evictions.load(std::memory_order_relaxed);
+}
+
+void fpu_cache_reset_stats()
+{
+    cache_hits.store(0);
+    cache_misses.store(0);
+    cache_evictions.store(0);
+}
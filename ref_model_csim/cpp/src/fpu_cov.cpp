@@ -0,0 +1,1019 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Functional coverage collector of the reference model
+ *  History       :
+ */
+
+#include "fpu_cov.h"
+#include "fpu_util.h"
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define RM_NUM          8
+#define FLAGS_NUM       32
+#define SLOT_NUM        4   // three sources and the result
+
+// Offsets of the coverpoints in the counters of a group
+#define OFFSET_RM           0
+#define OFFSET_SOURCES      (OFFSET_RM + RM_NUM)
+#define OFFSET_RESULT       (OFFSET_SOURCES + FPU_COV_CLASS_NUM * FPU_COV_CLASS_NUM * FPU_COV_CLASS_NUM)
+#define OFFSET_FLAGS        (OFFSET_RESULT + RM_NUM * FPU_COV_CLASS_NUM)
+#define OFFSET_EXPONENT     (OFFSET_FLAGS + RM_NUM * FLAGS_NUM)
+#define OFFSET_ALIGNMENT    (OFFSET_EXPONENT + SLOT_NUM * FPU_COV_EXP_NUM)
+#define OFFSET_ROUNDING     (OFFSET_ALIGNMENT + FPU_COV_ALIGN_NUM)
+#define GROUP_BINS          (OFFSET_ROUNDING + RM_NUM * FPU_COV_ROUND_NUM)
+#define COUNTER_NUM         (FPU_COV_GROUP_NUM * GROUP_BINS)
+
+#define FLAG_NX 0x01
+#define FLAG_UF 0x02
+#define FLAG_OF 0x04
+#define FLAG_DZ 0x08
+#define FLAG_NV 0x10
+
+static const int point_offsets[FPU_COV_POINT_NUM] = {
+    OFFSET_RM, OFFSET_SOURCES, OFFSET_RESULT, OFFSET_FLAGS, OFFSET_EXPONENT, OFFSET_ALIGNMENT, OFFSET_ROUNDING
+};
+
+static const int point_sizes[FPU_COV_POINT_NUM] = {
+    OFFSET_SOURCES - OFFSET_RM, OFFSET_RESULT - OFFSET_SOURCES, OFFSET_FLAGS - OFFSET_RESULT,
+    OFFSET_EXPONENT - OFFSET_FLAGS, OFFSET_ALIGNMENT - OFFSET_EXPONENT, OFFSET_ROUNDING - OFFSET_ALIGNMENT,
+    GROUP_BINS - OFFSET_ROUNDING
+};
+
+static const char* point_names[FPU_COV_POINT_NUM] = {
+    "rm", "sources", "result", "flags", "exponent", "alignment", "rounding"
+};
+
+static const char* class_names[FPU_COV_CLASS_NUM] = {
+    "-inf", "-normal", "-subnormal", "-zero", "+zero", "+subnormal", "+normal", "+inf", "snan", "qnan",
+    "int_zero", "int_pos", "int_neg", "int_extreme", "?", "?"
+};
+
+static const char* round_names[FPU_COV_ROUND_NUM] = {
+    "exact", "inexact_even", "inexact_odd", "binade", "max_finite", "overflow_inf", "min_normal", "tiny"
+};
+
+static const char* flag_names[5] = { "NX", "UF", "OF", "DZ", "NV" };
+
+//########## OPERATIONS ################################################################################################
+
+// Kind of the sources and of the result of an operation
+enum { KIND_FLOAT = 0, KIND_INT };
+
+typedef struct
+{
+    uint8_t nsources;   // number of sources
+    uint8_t source;     // kind of the sources
+    uint8_t result;     // kind of the result
+    uint8_t rm_goals;   // mask of the legal rm values, 0 if rm is not used. RMM is not a goal, the testbench does not
+                        // generate it (rm_c of fpu_txn).
+    bool    rounds;     // the result is rounded
+} op_desc;
+
+static const op_desc op_table[FPU_OP_NUM] = {
+    /* FPU_OP_FADD     */ { 2, KIND_FLOAT, KIND_FLOAT, 0x0F, true  },
+    /* FPU_OP_FSUB     */ { 2, KIND_FLOAT, KIND_FLOAT, 0x0F, true  },
+    /* FPU_OP_FMUL     */ { 2, KIND_FLOAT, KIND_FLOAT, 0x0F, true  },
+    /* FPU_OP_FDIV     */ { 2, KIND_FLOAT, KIND_FLOAT, 0x0F, true  },
+    /* FPU_OP_FMADD    */ { 3, KIND_FLOAT, KIND_FLOAT, 0x0F, true  },
+    /* FPU_OP_FNMADD   */ { 3, KIND_FLOAT, KIND_FLOAT, 0x0F, true  },
+    /* FPU_OP_FMSUB    */ { 3, KIND_FLOAT, KIND_FLOAT, 0x0F, true  },
+    /* FPU_OP_FNMSUB   */ { 3, KIND_FLOAT, KIND_FLOAT, 0x0F, true  },
+    /* FPU_OP_FCMP     */ { 2, KIND_FLOAT, KIND_INT,   0x07, false },
+    /* FPU_OP_FSQRT    */ { 1, KIND_FLOAT, KIND_FLOAT, 0x0F, true  },
+    /* FPU_OP_FMIN_MAX */ { 2, KIND_FLOAT, KIND_FLOAT, 0x03, false },
+    /* FPU_OP_FSGNJ    */ { 2, KIND_FLOAT, KIND_FLOAT, 0x07, false },
+    /* FPU_OP_FCVT_F2I */ { 1, KIND_FLOAT, KIND_INT,   0x0F, true  },
+    /* FPU_OP_FCVT_I2F */ { 1, KIND_INT,   KIND_FLOAT, 0x0F, true  },
+    /* FPU_OP_FCVT_F2F */ { 1, KIND_FLOAT, KIND_FLOAT, 0x0F, true  },
+    /* FPU_OP_FCLASS   */ { 1, KIND_FLOAT, KIND_INT,   0x00, false },
+    /* FPU_OP_FMV_F2X  */ { 1, KIND_FLOAT, KIND_INT,   0x00, false },
+    /* FPU_OP_FMV_X2F  */ { 1, KIND_FLOAT, KIND_FLOAT, 0x00, false },
+};
+
+static inline bool is_fused(int op)
+{
+    return op >= FPU_OP_FMADD && op <= FPU_OP_FNMSUB;
+}
+
+// Fields of a floating point format
+typedef struct
+{
+    int width;
+    int ebits;
+    int mbits;          // trailing significand
+} fmt_geom;
+
+static inline fmt_geom get_geom(int fmt)
+{
+    const fpu_fmt_desc* desc = fpu_fmt_get_desc(fmt);
+    fmt_geom g;
+    g.width = desc->width;
+    g.ebits = desc->env.es + 1;
+    g.mbits = g.width - g.ebits - 1;
+    return g;
+}
+
+//########## CLASSIFICATION ############################################################################################
+
+static inline int float_class(uint64_t x, const fmt_geom* g)
+{
+    uint64_t man  = x & fpu_low_mask(g->mbits);
+    uint64_t exp  = (x >> g->mbits) & fpu_low_mask(g->ebits);
+    bool     sign = (x >> (g->width - 1)) & 1;
+
+    if (exp == fpu_low_mask(g->ebits))
+    {
+        if (man == 0)
+            return sign ? FPU_COV_NEG_INF : FPU_COV_POS_INF;
+        return ((man >> (g->mbits - 1)) & 1) ? FPU_COV_QNAN : FPU_COV_SNAN;
+    }
+    if (exp == 0)
+    {
+        if (man == 0)
+            return sign ? FPU_COV_NEG_ZERO : FPU_COV_POS_ZERO;
+        return sign ? FPU_COV_NEG_SUBNORMAL : FPU_COV_POS_SUBNORMAL;
+    }
+    return sign ? FPU_COV_NEG_NORMAL : FPU_COV_POS_NORMAL;
+}
+
+static inline bool finite_nonzero(int cls)
+{
+    return cls == FPU_COV_NEG_NORMAL || cls == FPU_COV_NEG_SUBNORMAL || cls == FPU_COV_POS_SUBNORMAL ||
+           cls == FPU_COV_POS_NORMAL;
+}
+
+// Integer of width bits, extreme selects the class of the minimum and maximum values
+static inline int int_class(uint64_t v, int width, bool is_signed, bool extreme)
+{
+    uint64_t top = 1ULL << (width - 1);
+
+    v &= fpu_low_mask(width);
+    if (v == 0)
+        return FPU_COV_INT_ZERO;
+    if (extreme && (is_signed ? (v == top || v == top - 1) : v == fpu_low_mask(width)))
+        return FPU_COV_INT_EXTREME;
+    return (is_signed && (v & top)) ? FPU_COV_INT_NEG : FPU_COV_INT_POS;
+}
+
+// Bucket of a biased exponent, emax is the exponent of the infinities
+static inline int exp_bucket(int exp, int emax)
+{
+    if (exp == 0)
+        return 0;
+    if (exp == emax)
+        return FPU_COV_EXP_NUM - 1;
+    if (exp == 1)
+        return 1;
+    if (exp == emax - 1)
+        return FPU_COV_EXP_NUM - 2;
+    return 2 + (exp - 2) * (FPU_COV_EXP_NUM - 4) / (emax - 3);
+}
+
+//########## COUNTERS ##################################################################################################
+
+// Counters of every group, only written by the owning thread, see fpu_add_relaxed
+typedef struct
+{
+    std::atomic<uint64_t> counters[COUNTER_NUM];
+} cov_block;
+
+std::atomic<bool> fpu_cov_on(false);
+
+// Blocks of every thread that sampled a request. They are never freed, so the samples of the threads that exited are
+// still counted.
+static std::vector<cov_block*> blocks;
+static std::mutex              blocks_mutex;
+
+static thread_local cov_block* local_block = NULL;
+
+// Counts of the loaded databases, and counts of the threads at the last save
+static std::vector<uint64_t> loaded;
+static std::vector<uint64_t> saved;
+static uint64_t              loaded_runs = 0;
+
+static std::string db_path;
+static bool        db_run_saved = false;
+static std::mutex  db_mutex;
+
+static cov_block* get_block()
+{
+    cov_block* b = local_block;
+    if (b == NULL)
+    {
+        b = new cov_block(); // value-initialised, counters start at 0
+        std::lock_guard<std::mutex> lock(blocks_mutex);
+        blocks.push_back(b);
+        local_block = b;
+    }
+    return b;
+}
+
+static inline int group_index(int op, int fmt)
+{
+    return op * FPU_DST_FMT_NUM + fmt;
+}
+
+void fpu_cov_enable(bool enable)
+{
+    fpu_cov_on.store(enable, std::memory_order_release);
+}
+
+//########## SAMPLING ##################################################################################################
+
+void fpu_cov_record(int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int rm, int xlen,
+                    uint64_t result, int flags)
+{
+    if (flags < 0 || op < 0 || op >= FPU_OP_NUM || fmt < 0 || fmt >= FPU_DST_FMT_NUM)
+        return;
+
+    const op_desc* d       = &op_table[op];
+    int            src_fmt = (op == FPU_OP_FCVT_F2F) ? (int) (imm & 0x7) : fmt;
+    if (!fpu_fmt_get_desc(src_fmt)->valid)
+        return;
+
+    fmt_geom src = get_geom(src_fmt), dst = get_geom(fmt);
+    bool     is_signed = ~imm & 0x1;
+    int      int_width = ((imm >> 1) & 0x1) ? 64 : 32;
+    int      cross_rm  = d->rm_goals ? (rm & 0x7) : 0;
+
+    std::atomic<uint64_t>* c = &get_block()->counters[group_index(op, fmt) * GROUP_BINS];
+
+    fpu_add_relaxed(c[OFFSET_RM + (rm & 0x7)], 1);
+
+    // Sources, NaN-box checked as in exec_prepare
+    uint64_t fields[3] = { operand_a, operand_b, imm };
+    const uint64_t* sources = (op == FPU_OP_FADD || op == FPU_OP_FSUB) ? &fields[1] : fields;
+    bool     boxed = xlen > src.width && op != FPU_OP_FMV_X2F && op != FPU_OP_FMV_F2X;
+    uint64_t box   = fpu_low_mask(xlen) & ~fpu_low_mask(src.width);
+    int      emax  = (int) fpu_low_mask(src.ebits);
+    int      classes[3] = { 0, 0, 0 }, exps[3] = { 0, 0, 0 };
+
+    for (int s = 0; s < d->nsources; s++)
+    {
+        if (d->source == KIND_INT)
+        {
+            classes[s] = int_class(sources[s], int_width, is_signed, true);
+            continue;
+        }
+        if (boxed && (sources[s] & box) != box)
+        {
+            classes[s] = FPU_COV_QNAN;
+            exps[s]    = emax;
+        }
+        else
+        {
+            classes[s] = float_class(sources[s], &src);
+            exps[s]    = (int) ((sources[s] >> src.mbits) & fpu_low_mask(src.ebits));
+        }
+        fpu_add_relaxed(c[OFFSET_EXPONENT + s * FPU_COV_EXP_NUM + exp_bucket(exps[s], emax)], 1);
+    }
+    fpu_add_relaxed(c[OFFSET_SOURCES + classes[0] + FPU_COV_CLASS_NUM * (classes[1] + FPU_COV_CLASS_NUM * classes[2])], 1);
+
+    // Alignment of the addends, subnormals have the exponent of the smallest normals
+    int diff = 0;
+    bool aligned = false;
+    if ((op == FPU_OP_FADD || op == FPU_OP_FSUB) && finite_nonzero(classes[0]) && finite_nonzero(classes[1]))
+    {
+        diff    = std::max(exps[0], 1) - std::max(exps[1], 1);
+        aligned = true;
+    }
+    else if (is_fused(op) && finite_nonzero(classes[0]) && finite_nonzero(classes[1]) && finite_nonzero(classes[2]))
+    {
+        diff    = std::max(exps[0], 1) + std::max(exps[1], 1) - (emax >> 1) - std::max(exps[2], 1);
+        aligned = true;
+    }
+    if (aligned)
+        fpu_add_relaxed(c[OFFSET_ALIGNMENT + std::min(std::max(diff, -FPU_COV_ALIGN_ZERO), FPU_COV_ALIGN_NUM - 1 - FPU_COV_ALIGN_ZERO) + FPU_COV_ALIGN_ZERO], 1);
+
+    // Result and rounding events
+    int  rclass;
+    int  events = 0;
+    bool nx = flags & FLAG_NX;
+
+    if (d->result == KIND_FLOAT)
+    {
+        uint64_t r    = result & fpu_low_mask(dst.width);
+        uint64_t mag  = r & fpu_low_mask(dst.width - 1);
+        uint64_t min_normal = 1ULL << dst.mbits;
+        uint64_t max_finite = ((fpu_low_mask(dst.ebits) - 1) << dst.mbits) | fpu_low_mask(dst.mbits);
+        int      rexp = (int) ((r >> dst.mbits) & fpu_low_mask(dst.ebits));
+
+        rclass = float_class(r, &dst);
+        fpu_add_relaxed(c[OFFSET_EXPONENT + 3 * FPU_COV_EXP_NUM + exp_bucket(rexp, (int) fpu_low_mask(dst.ebits))], 1);
+
+        bool nan = rclass == FPU_COV_SNAN || rclass == FPU_COV_QNAN;
+        bool inf = rclass == FPU_COV_NEG_INF || rclass == FPU_COV_POS_INF;
+
+        events |= (!nx && !nan)                                        << FPU_COV_EXACT;
+        events |= (nx && !nan && !inf && !(r & 1))                     << FPU_COV_INEXACT_EVEN;
+        events |= (nx && !nan && !inf && (r & 1))                      << FPU_COV_INEXACT_ODD;
+        events |= (nx && mag >= min_normal && !inf && !nan &&
+                   (r & fpu_low_mask(dst.mbits)) == 0)                     << FPU_COV_BINADE;
+        events |= (nx && mag == max_finite)                            << FPU_COV_MAX_FINITE;
+        events |= ((flags & FLAG_OF) && inf)                           << FPU_COV_OVERFLOW_INF;
+        events |= (nx && mag == min_normal)                            << FPU_COV_MIN_NORMAL;
+        events |= (nx && mag < min_normal)                             << FPU_COV_TINY;
+    }
+    else
+    {
+        switch (op)
+        {
+        case FPU_OP_FCMP:
+            rclass = int_class(result, 1, false, false);
+            break;
+        case FPU_OP_FCVT_F2I:
+            rclass = int_class(result, int_width, is_signed, true);
+            events |= (!nx && !(flags & FLAG_NV)) << FPU_COV_EXACT;
+            events |= (nx && !(result & 1))       << FPU_COV_INEXACT_EVEN;
+            events |= (nx && (result & 1))        << FPU_COV_INEXACT_ODD;
+            break;
+        case FPU_OP_FMV_F2X:
+            rclass = int_class(result, dst.width, true, false);
+            break;
+        default:
+            rclass = int_class(result, 32, false, false);
+            break;
+        }
+    }
+    fpu_add_relaxed(c[OFFSET_RESULT + cross_rm * FPU_COV_CLASS_NUM + rclass], 1);
+    fpu_add_relaxed(c[OFFSET_FLAGS + cross_rm * FLAGS_NUM + (flags & 0x1F)], 1);
+
+    if (d->rounds)
+        for (int e = 0; events != 0; e++, events >>= 1)
+            if (events & 1)
+                fpu_add_relaxed(c[OFFSET_ROUNDING + cross_rm * FPU_COV_ROUND_NUM + e], 1);
+}
+
+//########## GOALS #####################################################################################################
+
+// Classes of the result that the operation can produce
+static bool result_goal(int op, int fmt, int rm, int cls)
+{
+    bool narrow = fmt == FPU_FMT_FP16 || fmt == FPU_FMT_FP8; // integers can overflow
+
+    switch (op)
+    {
+    case FPU_OP_FCMP:
+        return cls == FPU_COV_INT_ZERO || cls == FPU_COV_INT_POS;
+    case FPU_OP_FCLASS:
+        return cls == FPU_COV_INT_POS;
+    case FPU_OP_FCVT_F2I:
+        return cls >= FPU_COV_INT_ZERO && cls <= FPU_COV_INT_EXTREME;
+    case FPU_OP_FMV_F2X:
+        return cls >= FPU_COV_INT_ZERO && cls <= FPU_COV_INT_NEG;
+    case FPU_OP_FSGNJ:
+    case FPU_OP_FMV_X2F:
+        return cls <= FPU_COV_QNAN;
+    case FPU_OP_FSQRT:
+        return cls == FPU_COV_NEG_ZERO || cls == FPU_COV_POS_ZERO || cls == FPU_COV_POS_NORMAL ||
+               cls == FPU_COV_POS_INF || cls == FPU_COV_QNAN;
+    case FPU_OP_FCVT_I2F:
+        // Overflows round to the infinity in RNE and in the direction of the rounding
+        return cls == FPU_COV_POS_ZERO || cls == FPU_COV_POS_NORMAL || cls == FPU_COV_NEG_NORMAL ||
+               (narrow && cls == FPU_COV_POS_INF && (rm == 0 || rm == 3)) ||
+               (narrow && cls == FPU_COV_NEG_INF && (rm == 0 || rm == 2));
+    case FPU_OP_FCVT_F2F:
+        // Every source format is narrower than FP64
+        if (fmt == FPU_FMT_FP64 && (cls == FPU_COV_NEG_SUBNORMAL || cls == FPU_COV_POS_SUBNORMAL))
+            return false;
+        return cls <= FPU_COV_QNAN && cls != FPU_COV_SNAN;
+    default:
+        return cls <= FPU_COV_QNAN && cls != FPU_COV_SNAN;
+    }
+}
+
+// Flag combinations that the operation can raise, UF is only raised with NX
+static bool flags_goal(int op, int fmt, int f)
+{
+    bool rounded = f == 0 || f == FLAG_NX || f == (FLAG_NX | FLAG_UF) || f == (FLAG_NX | FLAG_OF);
+
+    switch (op)
+    {
+    case FPU_OP_FADD:
+    case FPU_OP_FSUB:
+        // Tiny sums are exact
+        return (rounded && f != (FLAG_NX | FLAG_UF)) || f == FLAG_NV;
+    case FPU_OP_FMUL:
+    case FPU_OP_FMADD:
+    case FPU_OP_FNMADD:
+    case FPU_OP_FMSUB:
+    case FPU_OP_FNMSUB:
+        return rounded || f == FLAG_NV;
+    case FPU_OP_FDIV:
+        return rounded || f == FLAG_NV || f == FLAG_DZ;
+    case FPU_OP_FSQRT:
+    case FPU_OP_FCVT_F2I:
+        return f == 0 || f == FLAG_NX || f == FLAG_NV;
+    case FPU_OP_FCMP:
+    case FPU_OP_FMIN_MAX:
+        return f == 0 || f == FLAG_NV;
+    case FPU_OP_FCVT_I2F:
+        // The integer conversions only raise NX on overflow, see get_conv_flags
+        return f == 0 || f == FLAG_NX;
+    case FPU_OP_FCVT_F2F:
+        return f == 0 || f == FLAG_NV || (fmt != FPU_FMT_FP64 && rounded);
+    default:
+        return f == 0;
+    }
+}
+
+// Results spanning the whole exponent range of the format
+static bool result_exponent_goal(int op, int fmt)
+{
+    switch (op)
+    {
+    case FPU_OP_FSQRT:
+    case FPU_OP_FCVT_I2F:
+        return false;
+    case FPU_OP_FCVT_F2F:
+        return fmt != FPU_FMT_FP64;
+    default:
+        return op_table[op].result == KIND_FLOAT;
+    }
+}
+
+static bool rounding_goal(int op, int fmt, int rm, int event)
+{
+    bool narrow = fmt == FPU_FMT_FP16 || fmt == FPU_FMT_FP8;
+
+    // RTZ overflows to the largest finite number
+    if (event == FPU_COV_OVERFLOW_INF && rm == 1)
+        return false;
+
+    switch (op)
+    {
+    case FPU_OP_FADD:
+    case FPU_OP_FSUB:
+        return event != FPU_COV_MIN_NORMAL && event != FPU_COV_TINY;
+    case FPU_OP_FSQRT:
+        return event <= FPU_COV_BINADE;
+    case FPU_OP_FCVT_I2F:
+        return event <= FPU_COV_BINADE || (narrow && event == FPU_COV_MAX_FINITE);
+    case FPU_OP_FCVT_F2F:
+        return fmt != FPU_FMT_FP64 || event == FPU_COV_EXACT;
+    case FPU_OP_FCVT_F2I:
+        return event <= FPU_COV_INEXACT_ODD;
+    default:
+        return true;
+    }
+}
+
+bool fpu_cov_goal(int op, int fmt, int point, int bin)
+{
+    if (point < 0 || point >= FPU_COV_POINT_NUM || bin < 0 || bin >= point_sizes[point] ||
+        fpu_exec_get_handler(op, fmt) == NULL)
+        return false;
+
+    const op_desc* d        = &op_table[op];
+    int            rm_goals = d->rm_goals ? d->rm_goals : 0x01; // rm of the crosses
+
+    switch (point)
+    {
+    case FPU_COV_RM:
+        return (d->rm_goals >> bin) & 1;
+    case FPU_COV_SOURCES:
+        for (int s = 0; s < 3; s++, bin /= FPU_COV_CLASS_NUM)
+        {
+            int cls = bin % FPU_COV_CLASS_NUM;
+            if (s >= d->nsources ? cls != 0 :
+                d->source == KIND_INT ? (cls < FPU_COV_INT_ZERO || cls > FPU_COV_INT_EXTREME) : cls > FPU_COV_QNAN)
+                return false;
+        }
+        return true;
+    case FPU_COV_RESULT:
+        return ((rm_goals >> (bin / FPU_COV_CLASS_NUM)) & 1) &&
+               result_goal(op, fmt, bin / FPU_COV_CLASS_NUM, bin % FPU_COV_CLASS_NUM);
+    case FPU_COV_FLAGS:
+        return ((rm_goals >> (bin / FLAGS_NUM)) & 1) && flags_goal(op, fmt, bin % FLAGS_NUM);
+    case FPU_COV_EXPONENT:
+        if (bin / FPU_COV_EXP_NUM == 3)
+            return result_exponent_goal(op, fmt);
+        return d->source == KIND_FLOAT && bin / FPU_COV_EXP_NUM < d->nsources;
+    case FPU_COV_ALIGNMENT:
+        // Beyond the significand and the guard bits, every difference only sets the sticky bit
+        return (op == FPU_OP_FADD || op == FPU_OP_FSUB || is_fused(op)) &&
+               abs(bin - FPU_COV_ALIGN_ZERO) <= get_geom(fmt).mbits + 3;
+    default:
+        return d->rounds && ((rm_goals >> (bin / FPU_COV_ROUND_NUM)) & 1) &&
+               rounding_goal(op, fmt, bin / FPU_COV_ROUND_NUM, bin % FPU_COV_ROUND_NUM);
+    }
+}
+
+//########## QUERIES ###################################################################################################
+
+const char* fpu_cov_point_name(int point)
+{
+    return (point >= 0 && point < FPU_COV_POINT_NUM) ? point_names[point] : "?";
+}
+
+int fpu_cov_point_size(int point)
+{
+    return (point >= 0 && point < FPU_COV_POINT_NUM) ? point_sizes[point] : 0;
+}
+
+static const char* exp_bucket_name(char* out, size_t size, int bucket)
+{
+    if (bucket == 0)
+        return "zero_or_subnormal";
+    if (bucket == 1)
+        return "emin";
+    if (bucket == FPU_COV_EXP_NUM - 2)
+        return "emax";
+    if (bucket == FPU_COV_EXP_NUM - 1)
+        return "inf_or_nan";
+    snprintf(out, size, "mid%d", bucket - 2);
+    return out;
+}
+
+const char* fpu_cov_bin_name(char* out, size_t size, int op, int point, int bin)
+{
+    int  nsources = (op >= 0 && op < FPU_OP_NUM) ? op_table[op].nsources : 3;
+    char tmp[16];
+
+    switch (point)
+    {
+    case FPU_COV_RM:
+        snprintf(out, size, "rm=%d", bin);
+        break;
+    case FPU_COV_SOURCES:
+    {
+        int n = 0;
+        out[0] = '\0';
+        for (int s = 0; s < nsources && n < (int) size; s++, bin /= FPU_COV_CLASS_NUM)
+            n += snprintf(out + n, size - n, "%ssrc%d=%s", s ? " " : "", s, class_names[bin % FPU_COV_CLASS_NUM]);
+        break;
+    }
+    case FPU_COV_RESULT:
+        snprintf(out, size, "rm=%d result=%s", bin / FPU_COV_CLASS_NUM, class_names[bin % FPU_COV_CLASS_NUM]);
+        break;
+    case FPU_COV_FLAGS:
+    {
+        int n = snprintf(out, size, "rm=%d flags=%s", bin / FLAGS_NUM, bin % FLAGS_NUM ? "" : "none");
+        for (int k = 0, first = 1; k < 5 && n < (int) size; k++)
+            if ((bin >> k) & 1)
+            {
+                n += snprintf(out + n, size - n, "%s%s", first ? "" : "|", flag_names[k]);
+                first = 0;
+            }
+        break;
+    }
+    case FPU_COV_EXPONENT:
+        if (bin / FPU_COV_EXP_NUM == 3)
+            snprintf(out, size, "result exp=%s", exp_bucket_name(tmp, sizeof(tmp), bin % FPU_COV_EXP_NUM));
+        else
+            snprintf(out, size, "src%d exp=%s", bin / FPU_COV_EXP_NUM, exp_bucket_name(tmp, sizeof(tmp), bin % FPU_COV_EXP_NUM));
+        break;
+    case FPU_COV_ALIGNMENT:
+        snprintf(out, size, "exp_diff=%+d", bin - FPU_COV_ALIGN_ZERO);
+        break;
+    case FPU_COV_ROUNDING:
+        snprintf(out, size, "rm=%d %s", bin / FPU_COV_ROUND_NUM, round_names[bin % FPU_COV_ROUND_NUM]);
+        break;
+    default:
+        snprintf(out, size, "?");
+        break;
+    }
+    return out;
+}
+
+// Sum the counters of a group over all threads and the loaded databases, blocks_mutex must be held
+static void sum_group(uint64_t* totals, int group)
+{
+    size_t base = (size_t) group * GROUP_BINS;
+
+    for (int i = 0; i < GROUP_BINS; i++)
+        totals[i] = loaded.empty() ? 0 : loaded[base + i];
+    for (size_t b = 0; b < blocks.size(); b++)
+        for (int i = 0; i < GROUP_BINS; i++)
+            totals[i] += blocks[b]->counters[base + i].load(std::memory_order_relaxed);
+}
+
+uint64_t fpu_cov_count(int op, int fmt, int point, int bin)
+{
+    if (op < 0 || op >= FPU_OP_NUM || fmt < 0 || fmt >= FPU_DST_FMT_NUM || point < 0 || point >= FPU_COV_POINT_NUM ||
+        bin < 0 || bin >= point_sizes[point])
+        return 0;
+
+    size_t   i     = (size_t) group_index(op, fmt) * GROUP_BINS + point_offsets[point] + bin;
+    uint64_t count = 0;
+
+    std::lock_guard<std::mutex> lock(blocks_mutex);
+    if (!loaded.empty())
+        count = loaded[i];
+    for (size_t b = 0; b < blocks.size(); b++)
+        count += blocks[b]->counters[i].load(std::memory_order_relaxed);
+    return count;
+}
+
+// Closure of the selected coverpoints of a group from its counters
+static void add_closure(fpu_cov_closure* closure, const uint64_t* totals, int op, int fmt, int point)
+{
+    for (int rm = 0; rm < RM_NUM; rm++)
+        closure->samples += totals[OFFSET_RM + rm];
+
+    for (int p = 0; p < FPU_COV_POINT_NUM; p++)
+    {
+        if (point >= 0 && p != point)
+            continue;
+        for (int bin = 0; bin < point_sizes[p]; bin++)
+            if (fpu_cov_goal(op, fmt, p, bin))
+            {
+                closure->goals++;
+                closure->hits += totals[point_offsets[p] + bin] != 0;
+            }
+    }
+}
+
+void fpu_cov_get_closure(fpu_cov_closure* closure, int op, int fmt, int point)
+{
+    std::vector<uint64_t> totals(GROUP_BINS);
+
+    memset(closure, 0, sizeof(*closure));
+
+    std::lock_guard<std::mutex> lock(blocks_mutex);
+    for (int o = 0; o < FPU_OP_NUM; o++)
+        for (int f = 0; f < FPU_DST_FMT_NUM; f++)
+            if ((op < 0 || o == op) && (fmt < 0 || f == fmt))
+            {
+                sum_group(&totals[0], group_index(o, f));
+                add_closure(closure, &totals[0], o, f, point);
+            }
+}
+
+int fpu_cov_next_unhit(int op, int fmt, int point, int bin)
+{
+    if (op < 0 || op >= FPU_OP_NUM || fmt < 0 || fmt >= FPU_DST_FMT_NUM || point < 0 || point >= FPU_COV_POINT_NUM)
+        return -1;
+
+    std::vector<uint64_t> totals(GROUP_BINS);
+
+    std::lock_guard<std::mutex> lock(blocks_mutex);
+    sum_group(&totals[0], group_index(op, fmt));
+    for (bin = std::max(bin, 0); bin < point_sizes[point]; bin++)
+        if (fpu_cov_goal(op, fmt, point, bin) && totals[point_offsets[point] + bin] == 0)
+            return bin;
+    return -1;
+}
+
+int fpu_cov_unhit_bins(int op, int fmt, int point, int* bins, int size)
+{
+    if (op < 0 || op >= FPU_OP_NUM || fmt < 0 || fmt >= FPU_DST_FMT_NUM || point < 0 || point >= FPU_COV_POINT_NUM)
+        return 0;
+
+    std::vector<uint64_t> totals(GROUP_BINS);
+    int                   n = 0;
+
+    std::lock_guard<std::mutex> lock(blocks_mutex);
+    sum_group(&totals[0], group_index(op, fmt));
+    for (int bin = 0; bin < point_sizes[point] && n < size; bin++)
+        if (fpu_cov_goal(op, fmt, point, bin) && totals[point_offsets[point] + bin] == 0)
+            bins[n++] = bin;
+    return n;
+}
+
+void fpu_cov_reset()
+{
+    std::lock_guard<std::mutex> db_lock(db_mutex);
+    std::lock_guard<std::mutex> lock(blocks_mutex);
+    for (size_t b = 0; b < blocks.size(); b++)
+        for (int i = 0; i < COUNTER_NUM; i++)
+            blocks[b]->counters[i].store(0, std::memory_order_relaxed);
+    saved.clear();
+}
+
+//########## DATABASE ##################################################################################################
+
+// Database header, followed by the counters of every group
+typedef struct
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t group_bins;
+    uint32_t groups;
+    uint32_t reserved0;
+    uint64_t runs;          // number of saved simulations
+    uint8_t  reserved[4096 - 32];
+} cov_header;
+
+static_assert(sizeof(cov_header) == 4096, "database header must fill a page");
+
+#define DB_SIZE (sizeof(cov_header) + COUNTER_NUM * sizeof(uint64_t))
+
+static bool valid_header(const cov_header* h, size_t size)
+{
+    return size == DB_SIZE && h->magic == FPU_COV_MAGIC && h->version == FPU_COV_VERSION &&
+           h->group_bins == GROUP_BINS && h->groups == FPU_COV_GROUP_NUM;
+}
+
+// Map a database read only, NULL if the file is not a database
+static const cov_header* map_database(const char* path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        fprintf(stderr, "fpu_cov: cannot open %s\n", path);
+        return NULL;
+    }
+
+    struct stat st;
+    void*       map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && (size_t) st.st_size == DB_SIZE)
+        map = mmap(NULL, DB_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (map == MAP_FAILED || !valid_header((const cov_header*) map, DB_SIZE))
+    {
+        if (map != MAP_FAILED)
+            munmap(map, DB_SIZE);
+        fprintf(stderr, "fpu_cov: %s is not a coverage database\n", path);
+        return NULL;
+    }
+    return (const cov_header*) map;
+}
+
+// Add counts to a database, created if it is empty. The file lock serialises the parallel simulations.
+static int add_to_database(const char* path, const uint64_t* counts, uint64_t runs)
+{
+    int fd = open(path, O_RDWR | O_CREAT, 0664);
+    if (fd < 0)
+    {
+        fprintf(stderr, "fpu_cov: cannot open %s\n", path);
+        return -1;
+    }
+    flock(fd, LOCK_EX);
+
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0;
+    if (ok && st.st_size == 0)
+    {
+        cov_header header;
+        memset(&header, 0, sizeof(header));
+        header.magic      = FPU_COV_MAGIC;
+        header.version    = FPU_COV_VERSION;
+        header.group_bins = GROUP_BINS;
+        header.groups     = FPU_COV_GROUP_NUM;
+
+        // Truncating zero-fills the counters
+        ok = ftruncate(fd, DB_SIZE) == 0 && pwrite(fd, &header, sizeof(header), 0) == (ssize_t) sizeof(header);
+        st.st_size = DB_SIZE;
+    }
+
+    void* map = MAP_FAILED;
+    if (ok && (size_t) st.st_size == DB_SIZE)
+        map = mmap(NULL, DB_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    int status = -1;
+    if (map != MAP_FAILED && valid_header((cov_header*) map, DB_SIZE))
+    {
+        cov_header* header   = (cov_header*) map;
+        uint64_t*   counters = (uint64_t*) ((uint8_t*) map + sizeof(cov_header));
+
+        for (int i = 0; i < COUNTER_NUM; i++)
+            counters[i] += counts[i];
+        header->runs += runs;
+        status = 0;
+    }
+    else
+        fprintf(stderr, "fpu_cov: %s is not a coverage database\n", path);
+
+    if (map != MAP_FAILED)
+        munmap(map, DB_SIZE);
+    flock(fd, LOCK_UN);
+    close(fd);
+    return status;
+}
+
+int fpu_cov_open(const char* path)
+{
+    std::lock_guard<std::mutex> lock(db_mutex);
+    if (db_path != path)
+        db_run_saved = false;
+    db_path = path;
+    fpu_cov_enable(true);
+    return 0;
+}
+
+int fpu_cov_save()
+{
+    std::lock_guard<std::mutex> db_lock(db_mutex);
+    if (db_path.empty())
+        return -1;
+
+    std::vector<uint64_t> totals(COUNTER_NUM, 0), delta(COUNTER_NUM);
+    {
+        std::lock_guard<std::mutex> lock(blocks_mutex);
+        for (size_t b = 0; b < blocks.size(); b++)
+            for (int i = 0; i < COUNTER_NUM; i++)
+                totals[i] += blocks[b]->counters[i].load(std::memory_order_relaxed);
+    }
+    bool sampled = false;
+    for (int i = 0; i < COUNTER_NUM; i++)
+    {
+        delta[i] = totals[i] - (saved.empty() ? 0 : saved[i]);
+        sampled |= delta[i] != 0;
+    }
+
+    // Nothing to add, the database is not created
+    if (!sampled)
+        return 0;
+    if (add_to_database(db_path.c_str(), &delta[0], db_run_saved ? 0 : 1) != 0)
+        return -1;
+    saved.swap(totals);
+    db_run_saved = true;
+    return 0;
+}
+
+int fpu_cov_load(const char* path)
+{
+    const cov_header* header = map_database(path);
+    if (header == NULL)
+        return -1;
+
+    const uint64_t* counters = (const uint64_t*) ((const uint8_t*) header + sizeof(cov_header));
+
+    std::lock_guard<std::mutex> lock(blocks_mutex);
+    loaded.resize(COUNTER_NUM, 0);
+    for (int i = 0; i < COUNTER_NUM; i++)
+        loaded[i] += counters[i];
+    loaded_runs += header->runs;
+
+    munmap((void*) header, DB_SIZE);
+    return 0;
+}
+
+int fpu_cov_merge(const char* dst, const char* src)
+{
+    const cov_header* header = map_database(src);
+    if (header == NULL)
+        return -1;
+
+    int status = add_to_database(dst, (const uint64_t*) ((const uint8_t*) header + sizeof(cov_header)), header->runs);
+    munmap((void*) header, DB_SIZE);
+    return status;
+}
+
+// Read REFMODEL_COV when the library is loaded, save the database at exit
+static struct cov_env_init
+{
+    cov_env_init()
+    {
+        const char* path = getenv(FPU_COV_ENV_VAR);
+        if (path != NULL && path[0] != '\0')
+            fpu_cov_open(path);
+    }
+
+    ~cov_env_init()
+    {
+        if (!db_path.empty())
+            fpu_cov_save();
+    }
+} cov_env_init_instance;
+
+//########## REPORT ####################################################################################################
+
+static void print_ratio(FILE* out, uint64_t hits, uint64_t goals)
+{
+    if (goals == 0)
+        fprintf(out, " %10s", "-");
+    else
+        fprintf(out, " %9.1f%%", 100.0 * hits / goals);
+}
+
+static void write_group_json(FILE* f, const uint64_t* totals, int op, int fmt, bool last)
+{
+    fpu_cov_closure group;
+    memset(&group, 0, sizeof(group));
+    add_closure(&group, totals, op, fmt, -1);
+
+    fprintf(f, "    {\"op\": \"%s\", \"fmt\": \"%s\", \"samples\": %llu, \"goals\": %llu, \"hits\": %llu, \"points\": {",
+            fpu_op_name(op), fpu_fmt_name(fmt), (unsigned long long) group.samples, (unsigned long long) group.goals,
+            (unsigned long long) group.hits);
+    for (int p = 0; p < FPU_COV_POINT_NUM; p++)
+    {
+        fpu_cov_closure point;
+        memset(&point, 0, sizeof(point));
+        add_closure(&point, totals, op, fmt, p);
+        fprintf(f, "%s\"%s\": {\"goals\": %llu, \"hits\": %llu}", p ? ", " : "", point_names[p],
+                (unsigned long long) point.goals, (unsigned long long) point.hits);
+    }
+    fprintf(f, "}, \"unhit\": [");
+
+    char name[96];
+    bool first = true;
+    for (int p = 0; p < FPU_COV_POINT_NUM; p++)
+        for (int bin = 0; bin < point_sizes[p]; bin++)
+            if (fpu_cov_goal(op, fmt, p, bin) && totals[point_offsets[p] + bin] == 0)
+            {
+                fprintf(f, "%s\"%s: %s\"", first ? "" : ", ", point_names[p], fpu_cov_bin_name(name, sizeof(name), op, p, bin));
+                first = false;
+            }
+    fprintf(f, "]}%s\n", last ? "" : ",");
+}
+
+int fpu_cov_report(FILE* out, const char* json_path)
+{
+    std::vector<uint64_t> totals(COUNTER_NUM);
+    fpu_cov_closure       all;
+    uint64_t              runs;
+
+    memset(&all, 0, sizeof(all));
+    {
+        std::lock_guard<std::mutex> lock(blocks_mutex);
+        for (int g = 0; g < FPU_COV_GROUP_NUM; g++)
+            sum_group(&totals[(size_t) g * GROUP_BINS], g);
+        runs = loaded_runs;
+    }
+
+    if (out != NULL)
+    {
+        fprintf(out, "%-9s %-7s %12s", "OP", "FMT", "SAMPLES");
+        for (int p = 0; p < FPU_COV_POINT_NUM; p++)
+            fprintf(out, " %10s", point_names[p]);
+        fprintf(out, " %10s\n", "total");
+    }
+
+    for (int op = 0; op < FPU_OP_NUM; op++)
+        for (int fmt = 0; fmt < FPU_DST_FMT_NUM; fmt++)
+        {
+            const uint64_t* t = &totals[(size_t) group_index(op, fmt) * GROUP_BINS];
+            fpu_cov_closure group;
+            memset(&group, 0, sizeof(group));
+            add_closure(&group, t, op, fmt, -1);
+
+            all.goals   += group.goals;
+            all.hits    += group.hits;
+            all.samples += group.samples;
+            if (out == NULL || group.samples == 0)
+                continue;
+
+            fprintf(out, "%-9s %-7s %12llu", fpu_op_name(op), fpu_fmt_name(fmt), (unsigned long long) group.samples);
+            for (int p = 0; p < FPU_COV_POINT_NUM; p++)
+            {
+                fpu_cov_closure point;
+                memset(&point, 0, sizeof(point));
+                add_closure(&point, t, op, fmt, p);
+                print_ratio(out, point.hits, point.goals);
+            }
+            print_ratio(out, group.hits, group.goals);
+            fprintf(out, "\n");
+        }
+
+    if (out != NULL)
+        fprintf(out, "coverage : %llu samples, %llu/%llu goals hit (%.2f%%), %llu runs loaded\n",
+                (unsigned long long) all.samples, (unsigned long long) all.hits, (unsigned long long) all.goals,
+                all.goals ? 100.0 * all.hits / all.goals : 0.0, (unsigned long long) runs);
+
+    if (json_path == NULL || json_path[0] == '\0')
+        return 0;
+
+    FILE* f = fopen(json_path, "w");
+    if (f == NULL)
+    {
+        fprintf(stderr, "fpu_cov: cannot write %s\n", json_path);
+        return -1;
+    }
+    fprintf(f, "{\n  \"samples\": %llu,\n  \"goals\": %llu,\n  \"hits\": %llu,\n  \"runs_loaded\": %llu,\n  \"groups\": [\n",
+            (unsigned long long) all.samples, (unsigned long long) all.goals, (unsigned long long) all.hits,
+            (unsigned long long) runs);
+
+    int last = -1;
+    for (int g = 0; g < FPU_COV_GROUP_NUM; g++)
+        if (fpu_exec_get_handler(g / FPU_DST_FMT_NUM, g % FPU_DST_FMT_NUM) != NULL)
+            last = g;
+    for (int g = 0; g < FPU_COV_GROUP_NUM; g++)
+        if (fpu_exec_get_handler(g / FPU_DST_FMT_NUM, g % FPU_DST_FMT_NUM) != NULL)
+            write_group_json(f, &totals[(size_t) g * GROUP_BINS], g / FPU_DST_FMT_NUM, g % FPU_DST_FMT_NUM, g == last);
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return 0;
+}
@@ -0,0 +1,423 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Opcode-dispatched entry point of the reference model
+ *  History       :
+ */
+
+#include "fpu_exec.h"
+#include "fpu_all_rm.h"
+#include "fpu_fp8_table.h"
+#include "fpu_unary_table.h"
+#include "operations.h"
+#include "fpu_cache.h"
+#include "fpu_store.h"
+#include "fpu_probes.h"
+#include "fpu_util.h"
+#include <cstring>
+
+//########## FORMATS ###################################################################################################
+
+static const fpu_fmt_desc fmt_table[FPU_FMT_NUM] = {
+    /* 3'b000 FP32    */ { true,  32, FLOAT_ENV_INITIALIZER   },
+    /* 3'b001 FP64    */ { true,  64, DOUBLE_ENV_INITIALIZER  },
+    /* 3'b010 FP16    */ { true,  16, HALF_ENV_INITIALIZER    },
+    /* 3'b011 FP8     */ { true,   8, FP8_ENV_INITIALIZER     },
+    /* 3'b100         */ { false,  0, { 0, 0 }                },
+    /* 3'b101         */ { false,  0, { 0, 0 }                },
+    /* 3'b110 FP16ALT */ { true,  16, FP16ALT_ENV_INITIALIZER },
+    /* 3'b111         */ { false,  0, { 0, 0 }                },
+};
+
+static const char* fmt_names[FPU_FMT_NUM] = {
+    "FP32", "FP64", "FP16", "FP8", "?", "?", "FP16ALT", "?"
+};
+
+static const char* op_names[FPU_OP_NUM] = {
+    "FADD", "FSUB", "FMUL", "FDIV", "FMADD", "FNMADD", "FMSUB", "FNMSUB", "FCMP", "FSQRT",
+    "FMIN_MAX", "FSGNJ", "FCVT_F2I", "FCVT_I2F", "FCVT_F2F", "FCLASS", "FMV_F2X", "FMV_X2F"
+};
+
+const fpu_fmt_desc* fpu_fmt_get_desc(int fmt)
+{
+    return &fmt_table[fmt & (FPU_FMT_NUM - 1)];
+}
+
+int fpu_fmt_from_env(environment env)
+{
+    for (int fmt = 0; fmt < FPU_FMT_NUM; fmt++)
+    {
+        if (fmt_table[fmt].valid && fmt_table[fmt].env.bis == env.bis && fmt_table[fmt].env.es == env.es)
+            return fmt;
+    }
+    return -1;
+}
+
+const char* fpu_op_name(int op)
+{
+    return (op >= 0 && op < FPU_OP_NUM) ? op_names[op] : "?";
+}
+
+const char* fpu_fmt_name(int fmt)
+{
+    return fmt_names[fmt & (FPU_FMT_NUM - 1)];
+}
+
+// Canonical NaN of a format : exponent all ones and most significant bit of the significand set
+static inline uint64_t canonical_nan(environment env)
+{
+    int man_size = env.bis - env.es - 1;
+    return (fpu_low_mask(env.es + 1) << man_size) | (1ULL << (man_size - 1));
+}
+
+//########## ROUNDING MODES ############################################################################################
+
+#define RM_RNE 0
+#define RM_RDN 2
+#define RM_RUP 3
+#define RM_RMM 4
+
+mpfr_rnd_t rnd_rtl_to_c(int rnd_rtl) {
+    mpfr_rnd_t rnd_c;
+    if (rnd_rtl == 2)
+    {
+        rnd_c = MPFR_RNDD;
+    }
+    else if (rnd_rtl == 3) {
+        rnd_c = MPFR_RNDU;
+    }
+    else if (rnd_rtl == 4) {
+        rnd_c = MPFR_RNDNA;
+    }
+    else {
+        rnd_c = static_cast<mpfr_rnd_t>(rnd_rtl);
+    }
+    return rnd_c;
+}
+
+//########## HANDLERS ##################################################################################################
+
+static int exec_fadd(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return add(result, op2, op3, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+static int exec_fsub(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return sub(result, op2, op3, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+static int exec_fmul(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return mul(result, op1, op2, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+static int exec_fdiv(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return div(result, op1, op2, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+static int exec_fmadd(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return fma(result, op1, op2, op3, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+static int exec_fnmadd(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return fnma(result, op1, op2, op3, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+static int exec_fmsub(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return fms(result, op1, op2, op3, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+static int exec_fnmsub(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return fnms(result, op1, op2, op3, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+// rm selects the comparison : 0 FLE, 1 FLT, 2 FEQ
+static int exec_fcmp(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    switch (ctx->rm)
+    {
+    case 0:
+        return cmp_leq(result, op1, op2, ctx->dst_env);
+    case 1:
+        return cmp_lt(result, op1, op2, ctx->dst_env);
+    default:
+        return cmp_eq(result, op1, op2, ctx->dst_env);
+    }
+}
+
+static int exec_fsqrt(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return sqrt(result, op1, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+// rm selects the operation : 0 FMIN, 1 FMAX
+static int exec_fmin_max(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    if (ctx->rm == 0)
+        return fmin(result, op1, op2, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+    return fmax(result, op1, op2, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+// rm selects the operation : 0 FSGNJ, 1 FSGNJN, 2 FSGNJX. Also used by FMV_X2F.
+static int exec_fsgnj(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return fsgnj(result, op1, op2, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+static int exec_fcvt_f2i(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    if (ctx->int_format == 1) // INT64
+        return fcvt_f2i64(result, op1, ctx->is_signed, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+    return fcvt_f2i32(result, op1, ctx->is_signed, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+static int exec_fcvt_i2f(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return fcvt_i2f(result, op1, ctx->is_signed, ctx->int_format, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+static int exec_fclass(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return fclass(result, op1, ctx->dst_env);
+}
+
+static int exec_fmv_f2x(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return fmv_f2x(result, op1, ctx->dst_env, ctx->nchunks);
+}
+
+//########## DISPATCH ##################################################################################################
+
+// Same handler for every destination format
+#define ALL_FMTS(fn) { fn, fn, fn, fn }
+// Dedicated FP8 handler, see fpu_fp8_table.h
+#define FP8_TABLE(fn, fp8_fn) { fn, fn, fn, fp8_fn }
+// Dedicated FP16 and FP8 handler, see fpu_unary_table.h
+#define UNARY_TABLE(fn, table_fn) { fn, fn, table_fn, table_fn }
+
+static const fpu_exec_fn exec_table[FPU_OP_NUM][FPU_DST_FMT_NUM] = {
+    /* FPU_OP_FADD     */ FP8_TABLE(exec_fadd,     fpu_fp8_exec_fadd),
+    /* FPU_OP_FSUB     */ FP8_TABLE(exec_fsub,     fpu_fp8_exec_fsub),
+    /* FPU_OP_FMUL     */ FP8_TABLE(exec_fmul,     fpu_fp8_exec_fmul),
+    /* FPU_OP_FDIV     */ FP8_TABLE(exec_fdiv,     fpu_fp8_exec_fdiv),
+    /* FPU_OP_FMADD    */ FP8_TABLE(exec_fmadd,    fpu_fp8_exec_fmadd),
+    /* FPU_OP_FNMADD   */ FP8_TABLE(exec_fnmadd,   fpu_fp8_exec_fnmadd),
+    /* FPU_OP_FMSUB    */ FP8_TABLE(exec_fmsub,    fpu_fp8_exec_fmsub),
+    /* FPU_OP_FNMSUB   */ FP8_TABLE(exec_fnmsub,   fpu_fp8_exec_fnmsub),
+    /* FPU_OP_FCMP     */ FP8_TABLE(exec_fcmp,     fpu_fp8_exec_fcmp),
+    /* FPU_OP_FSQRT    */ UNARY_TABLE(exec_fsqrt,    fpu_unary_exec_fsqrt),
+    /* FPU_OP_FMIN_MAX */ FP8_TABLE(exec_fmin_max, fpu_fp8_exec_fmin_max),
+    /* FPU_OP_FSGNJ    */ ALL_FMTS(exec_fsgnj),
+    /* FPU_OP_FCVT_F2I */ UNARY_TABLE(exec_fcvt_f2i, fpu_unary_exec_fcvt_f2i),
+    /* FPU_OP_FCVT_I2F */ ALL_FMTS(exec_fcvt_i2f),
+    /* FPU_OP_FCVT_F2F */ ALL_FMTS(fpu_unary_exec_fcvt_f2f),
+    /* FPU_OP_FCLASS   */ UNARY_TABLE(exec_fclass,   fpu_unary_exec_fclass),
+    /* FPU_OP_FMV_F2X  */ ALL_FMTS(exec_fmv_f2x),
+    /* FPU_OP_FMV_X2F  */ ALL_FMTS(exec_fsgnj),
+};
+
+fpu_exec_fn fpu_exec_get_handler(int op, int fmt)
+{
+    if (op < 0 || op >= FPU_OP_NUM || fmt < 0 || fmt >= FPU_DST_FMT_NUM)
+        return NULL;
+    return exec_table[op][fmt];
+}
+
+static inline void split_dwords(uint32_t* dst, uint64_t src)
+{
+    dst[0] = src & 0xFFFFFFFF;
+    dst[1] = (src >> 32) & 0xFFFFFFFF;
+}
+
+// Build the context and the operands of the handler, return the handler or NULL if the request is not supported
+static fpu_exec_fn exec_prepare(int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int rm, int xlen,
+                                fpu_exec_ctx* ctx, uint32_t* op1, uint32_t* op2, uint32_t* op3)
+{
+    fpu_exec_fn handler = fpu_exec_get_handler(op, fmt);
+    if (handler == NULL)
+        return NULL;
+
+    const fpu_fmt_desc* dst = fpu_fmt_get_desc(fmt);
+    int                 src_fmt = (op == FPU_OP_FCVT_F2F) ? (int) (imm & 0x7) : fmt;
+    const fpu_fmt_desc* src = fpu_fmt_get_desc(src_fmt);
+    if (!src->valid)
+        return NULL;
+
+    ctx->dst_env    = dst->env;
+    ctx->src_env    = src->env;
+    ctx->rm         = rm;
+    ctx->is_signed  = ~imm & 0x1;
+    ctx->int_format = (imm >> 1) & 0x1;
+    ctx->nchunks    = xlen / 32;
+
+    // NaN-box check : operands narrower than the integer register must have their upper bits set, otherwise they are
+    // replaced by the canonical NaN of the source format. Operands of moves and integer conversions are not checked.
+    if (op != FPU_OP_FMV_X2F && op != FPU_OP_FMV_F2X && op != FPU_OP_FCVT_I2F)
+    {
+        if (src->width > xlen)
+            return NULL;
+
+        uint64_t box  = fpu_low_mask(xlen) & ~fpu_low_mask(src->width);
+        uint64_t cnan = box | canonical_nan(src->env);
+
+        if ((operand_a & box) != box) { operand_a = cnan; FPU_PROBE3(nan_box, op, src_fmt, 0); }
+        if ((operand_b & box) != box) { operand_b = cnan; FPU_PROBE3(nan_box, op, src_fmt, 1); }
+        if ((imm       & box) != box) { imm       = cnan; FPU_PROBE3(nan_box, op, src_fmt, 2); }
+    }
+
+    if (op == FPU_OP_FCVT_I2F)
+        operand_a &= fpu_low_mask(ctx->int_format ? 64 : 32);
+
+    split_dwords(op1, operand_a);
+    split_dwords(op2, operand_b);
+    split_dwords(op3, imm);
+    return handler;
+}
+
+// Format the raw result of a handler as read on the result port
+static uint64_t exec_finish(int op, uint64_t raw, int fmt, int xlen, int flen)
+{
+    uint64_t result;
+    int width = fpu_fmt_get_desc(fmt)->width;
+
+    // Integer results and moves are sign extended by the model itself, other results are NaN-boxed
+    if (op == FPU_OP_FCMP || op == FPU_OP_FCLASS || op == FPU_OP_FCVT_F2I || op == FPU_OP_FMV_F2X)
+        result = raw;
+    else
+        result = (raw & fpu_low_mask(width)) | ~fpu_low_mask(width);
+
+    // Result is read on the FLen-bit result port through an XLEN-bit variable
+    return result & fpu_low_mask(xlen < flen ? xlen : flen);
+}
+
+int fpu_exec_compute(uint64_t* result, int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int rm, int xlen, int flen)
+{
+    uint32_t op1[2], op2[2], op3[2];
+    uint32_t res[4] = { 0, 0, 0, 0 };
+    fpu_exec_ctx ctx;
+
+    *result = 0;
+
+    fpu_exec_fn handler = exec_prepare(op, operand_a, operand_b, imm, fmt, rm, xlen, &ctx, op1, op2, op3);
+    if (handler == NULL)
+        return -1;
+
+    // MPFR operations do not support RMM (MPFR_RNDNA) : every format is rounded to it by fpu_all_rm, with intfp_round
+    if (rm == RM_RMM && fpu_all_rm_supported(op))
+    {
+        uint64_t raw[FPU_RM_NUM];
+        int      flags[FPU_RM_NUM];
+        fpu_all_rm_compute(raw, flags, op, fmt, op1, op2, op3, &ctx);
+        *result = exec_finish(op, raw[RM_RMM], fmt, xlen, flen);
+        return flags[RM_RMM];
+    }
+
+    int flags = handler(res, op1, op2, op3, &ctx);
+
+    *result = exec_finish(op, ((uint64_t) res[1] << 32) | res[0], fmt, xlen, flen);
+    return flags;
+}
+
+int fpu_exec_rmm_expected(uint64_t* result, int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int xlen, int flen)
+{
+    uint32_t op1[2], op2[2], op3[2];
+    uint64_t raw[FPU_RM_NUM];
+    int      flags[FPU_RM_NUM];
+    fpu_exec_ctx ctx;
+
+    *result = 0;
+
+    fpu_exec_fn handler = exec_prepare(op, operand_a, operand_b, imm, fmt, RM_RNE, xlen, &ctx, op1, op2, op3);
+    if (handler == NULL || !fpu_all_rm_supported(op))
+        return -1;
+
+    for (int rm = RM_RNE; rm <= RM_RUP; rm++)
+    {
+        uint32_t res[4] = { 0, 0, 0, 0 };
+        ctx.rm    = rm;
+        flags[rm] = handler(res, op1, op2, op3, &ctx);
+        raw[rm]   = ((uint64_t) res[1] << 32) | res[0];
+    }
+
+    int rm = fpu_all_rm_tie(op, raw[RM_RDN], raw[RM_RUP], op1, op2, op3, &ctx);
+    if (rm < 0)
+        rm = RM_RNE;
+
+    *result = exec_finish(op, raw[rm], fmt, xlen, flen);
+    return flags[rm];
+}
+
+int fpu_exec_all_rm(fpu_all_rm_record* record, int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int xlen, int flen)
+{
+    uint32_t op1[2], op2[2], op3[2];
+    uint64_t raw[FPU_RM_NUM];
+    fpu_exec_ctx ctx;
+
+    memset(record, 0, sizeof(*record));
+
+    if (!fpu_all_rm_supported(op) ||
+        exec_prepare(op, operand_a, operand_b, imm, fmt, 0, xlen, &ctx, op1, op2, op3) == NULL)
+        return -1;
+
+    fpu_all_rm_compute(raw, record->flags, op, fmt, op1, op2, op3, &ctx);
+
+    for (int rm = 0; rm < FPU_RM_NUM; rm++)
+        record->result[rm] = exec_finish(op, raw[rm], fmt, xlen, flen);
+    return 0;
+}
+
+int fpu_exec(uint64_t* result, int op, uint64_t operand_a, uint64_t operand_b, uint64_t imm, int fmt, int rm, int xlen, int flen)
+{
+    bool use_cache = fpu_cache_capacity() != 0;
+    bool use_store = fpu_store_enabled();
+
+    if (!use_cache && !use_store)
+        return fpu_exec_compute(result, op, operand_a, operand_b, imm, fmt, rm, xlen, flen);
+
+    int flags;
+    fpu_cache_key key = fpu_cache_make_key(op, operand_a, operand_b, imm, fmt, rm, xlen, flen);
+
+    // In-process cache, then persistent store, then MPFR
+    if (use_cache && fpu_cache_lookup(&key, result, &flags))
+        return flags;
+
+    if (use_store && fpu_store_lookup(&key, result, &flags))
+    {
+        if (use_cache)
+            fpu_cache_insert(&key, *result, flags);
+        return flags;
+    }
+
+    flags = fpu_exec_compute(result, op, operand_a, operand_b, imm, fmt, rm, xlen, flen);
+
+    if (use_cache)
+        fpu_cache_insert(&key, *result, flags);
+    if (use_store)
+        fpu_store_insert(&key, *result, flags);
+    return flags;
+}
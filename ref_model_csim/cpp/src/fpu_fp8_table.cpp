@@ -0,0 +1,315 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Exhaustive tables of the FP8 binary operations
+ *  History       :
+ */
+
+#include "fpu_fp8_table.h"
+#include "fpu_store.h"
+#include "intfp.h"
+#include "operations.h"
+#include <atomic>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define TABLE_MAGIC     0x454C424154385046ULL // "FP8TABLE"
+#define TABLE_VERSION   2
+
+// File header, followed by the tables
+typedef struct
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t ntables;
+    uint64_t model_hash;
+} fp8_table_header;
+
+static const environment fp8_env = FP8_ENV_INITIALIZER;
+
+static uint16_t          tables[FP8_TABLE_NUM][FPU_FP8_TABLE_SIZE];
+static std::atomic<bool> table_ready[FP8_TABLE_NUM];
+static std::mutex        table_mutex;
+
+// Read REFMODEL_FP8_TABLES when the library is loaded
+static struct fp8_table_env_init
+{
+    fp8_table_env_init()
+    {
+        const char* path = getenv(FPU_FP8_TABLE_ENV_VAR);
+        if (path != NULL && path[0] != '\0')
+            fpu_fp8_table_load(path);
+    }
+} fp8_table_env_init_instance;
+
+static const char* rm_names[FPU_FP8_TABLE_RM_NUM] = { "RNE", "RTZ", "RDN", "RUP" };
+
+const char* fpu_fp8_table_name(int table)
+{
+    static const char* arith_names[4] = { "ADD", "SUB", "MUL", "DIV" };
+    static const char* other_names[FP8_TABLE_NUM - FP8_TABLE_MIN] = { "MIN", "MAX", "LEQ", "LT", "EQ" };
+    static char names[FP8_TABLE_MIN][8];
+    static std::once_flag names_once;
+
+    if (table < 0 || table >= FP8_TABLE_NUM)
+        return "?";
+    if (table >= FP8_TABLE_MIN)
+        return other_names[table - FP8_TABLE_MIN];
+
+    std::call_once(names_once, []() {
+        for (int i = 0; i < FP8_TABLE_MIN; i++)
+            snprintf(names[i], sizeof(names[i]), "%s.%s", arith_names[i / FPU_FP8_TABLE_RM_NUM], rm_names[i % FPU_FP8_TABLE_RM_NUM]);
+    });
+    return names[table];
+}
+
+//########## COMPUTATION ###############################################################################################
+
+uint16_t fpu_fp8_table_mpfr(int table, uint8_t op1, uint8_t op2)
+{
+    uint32_t a[2] = { op1, 0 };
+    uint32_t b[2] = { op2, 0 };
+    uint32_t r[2] = { 0, 0 };
+    int flags;
+
+    mpfr_rnd_t rnd = rnd_rtl_to_c(table % FPU_FP8_TABLE_RM_NUM);
+
+    if      (table < FP8_TABLE_SUB) flags = add(r, a, b, rnd, fp8_env);
+    else if (table < FP8_TABLE_MUL) flags = sub(r, a, b, rnd, fp8_env);
+    else if (table < FP8_TABLE_DIV) flags = mul(r, a, b, rnd, fp8_env);
+    else if (table < FP8_TABLE_MIN) flags = div(r, a, b, rnd, fp8_env);
+    else if (table == FP8_TABLE_MIN) flags = fmin(r, a, b, MPFR_RNDN, fp8_env);
+    else if (table == FP8_TABLE_MAX) flags = fmax(r, a, b, MPFR_RNDN, fp8_env);
+    else if (table == FP8_TABLE_LEQ) flags = cmp_leq(r, a, b, fp8_env);
+    else if (table == FP8_TABLE_LT)  flags = cmp_lt(r, a, b, fp8_env);
+    else                             flags = cmp_eq(r, a, b, fp8_env);
+
+    return FP8_TABLE_ENTRY(r[0], flags);
+}
+
+uint16_t fpu_fp8_table_intfp(int table, uint8_t op1, uint8_t op2)
+{
+    uint64_t r = 0;
+    int flags;
+    int rm = table % FPU_FP8_TABLE_RM_NUM;
+
+    if      (table < FP8_TABLE_SUB) flags = intfp_add(&r, op1, op2, rm, fp8_env);
+    else if (table < FP8_TABLE_MUL) flags = intfp_sub(&r, op1, op2, rm, fp8_env);
+    else if (table < FP8_TABLE_DIV) flags = intfp_mul(&r, op1, op2, rm, fp8_env);
+    else if (table < FP8_TABLE_MIN) flags = intfp_div(&r, op1, op2, rm, fp8_env);
+    else if (table == FP8_TABLE_MIN) flags = intfp_fmin(&r, op1, op2, fp8_env);
+    else if (table == FP8_TABLE_MAX) flags = intfp_fmax(&r, op1, op2, fp8_env);
+    else if (table == FP8_TABLE_LEQ) flags = intfp_cmp_leq(&r, op1, op2, fp8_env);
+    else if (table == FP8_TABLE_LT)  flags = intfp_cmp_lt(&r, op1, op2, fp8_env);
+    else                             flags = intfp_cmp_eq(&r, op1, op2, fp8_env);
+
+    return FP8_TABLE_ENTRY(r, flags);
+}
+
+static void generate(int table)
+{
+    for (int i = 0; i < FPU_FP8_TABLE_SIZE; i++)
+        tables[table][i] = fpu_fp8_table_mpfr(table, i & 0xFF, i >> 8);
+}
+
+const uint16_t* fpu_fp8_table_get(int table)
+{
+    if (!table_ready[table].load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(table_mutex);
+        if (!table_ready[table].load(std::memory_order_relaxed))
+        {
+            generate(table);
+            table_ready[table].store(true, std::memory_order_release);
+        }
+    }
+    return tables[table];
+}
+
+//########## FILE ######################################################################################################
+
+int fpu_fp8_table_load(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "fpu_fp8_table: cannot open %s, tables are computed on first use\n", path);
+        return -1;
+    }
+
+    fp8_table_header header;
+    bool valid = fread(&header, sizeof(header), 1, file) == 1 && header.magic == TABLE_MAGIC &&
+                 header.version == TABLE_VERSION && header.ntables == FP8_TABLE_NUM &&
+                 header.model_hash == fpu_store_model_hash();
+
+    if (valid)
+    {
+        std::lock_guard<std::mutex> lock(table_mutex);
+        // Read in a copy so that a short file does not leave partially written tables in use
+        uint16_t* data = new uint16_t[FP8_TABLE_NUM * FPU_FP8_TABLE_SIZE];
+        valid = fread(data, sizeof(uint16_t), FP8_TABLE_NUM * FPU_FP8_TABLE_SIZE, file) == FP8_TABLE_NUM * FPU_FP8_TABLE_SIZE;
+        if (valid)
+        {
+            for (int table = 0; table < FP8_TABLE_NUM; table++)
+            {
+                if (!table_ready[table].load(std::memory_order_relaxed))
+                {
+                    memcpy(tables[table], &data[table * FPU_FP8_TABLE_SIZE], sizeof(tables[table]));
+                    table_ready[table].store(true, std::memory_order_release);
+                }
+            }
+        }
+        delete[] data;
+    }
+    fclose(file);
+
+    if (!valid)
+    {
+        fprintf(stderr, "fpu_fp8_table: %s is not a table file of this model, tables are computed on first use\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+int fpu_fp8_table_save(const char* path)
+{
+    for (int table = 0; table < FP8_TABLE_NUM; table++)
+        fpu_fp8_table_get(table);
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "fpu_fp8_table: cannot create %s\n", path);
+        return -1;
+    }
+
+    fp8_table_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic      = TABLE_MAGIC;
+    header.version    = TABLE_VERSION;
+    header.ntables    = FP8_TABLE_NUM;
+    header.model_hash = fpu_store_model_hash();
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(tables, sizeof(tables), 1, file) == 1;
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok)
+    {
+        fprintf(stderr, "fpu_fp8_table: cannot write %s\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+//########## HANDLERS ##################################################################################################
+
+static inline int table_lookup(uint32_t* result, int table, uint32_t op1, uint32_t op2)
+{
+    uint16_t entry = fpu_fp8_table_get(table)[(op1 & 0xFF) | ((op2 & 0xFF) << 8)];
+    result[0] = FP8_TABLE_RESULT(entry);
+    return FP8_TABLE_FLAGS(entry);
+}
+
+int fpu_fp8_exec_fadd(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    if (ctx->rm >= FPU_FP8_TABLE_RM_NUM)
+        return add(result, op2, op3, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+    return table_lookup(result, FP8_TABLE_ADD + ctx->rm, op2[0], op3[0]);
+}
+
+int fpu_fp8_exec_fsub(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    if (ctx->rm >= FPU_FP8_TABLE_RM_NUM)
+        return sub(result, op2, op3, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+    return table_lookup(result, FP8_TABLE_SUB + ctx->rm, op2[0], op3[0]);
+}
+
+int fpu_fp8_exec_fmul(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    if (ctx->rm >= FPU_FP8_TABLE_RM_NUM)
+        return mul(result, op1, op2, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+    return table_lookup(result, FP8_TABLE_MUL + ctx->rm, op1[0], op2[0]);
+}
+
+int fpu_fp8_exec_fdiv(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    if (ctx->rm >= FPU_FP8_TABLE_RM_NUM)
+        return div(result, op1, op2, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+    return table_lookup(result, FP8_TABLE_DIV + ctx->rm, op1[0], op2[0]);
+}
+
+// 2^24 operand triples do not fit in a table, the fused operations are computed with integers
+int fpu_fp8_exec_fmadd(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    if (ctx->rm >= FPU_FP8_TABLE_RM_NUM)
+        return fma(result, op1, op2, op3, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+    uint64_t r;
+    int flags = intfp_fma(&r, op1[0] & 0xFF, op2[0] & 0xFF, op3[0] & 0xFF, ctx->rm, ctx->dst_env);
+    result[0] = r;
+    return flags;
+}
+
+int fpu_fp8_exec_fnmadd(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    if (ctx->rm >= FPU_FP8_TABLE_RM_NUM)
+        return fnma(result, op1, op2, op3, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+    uint64_t r;
+    int flags = intfp_fnma(&r, op1[0] & 0xFF, op2[0] & 0xFF, op3[0] & 0xFF, ctx->rm, ctx->dst_env);
+    result[0] = r;
+    return flags;
+}
+
+int fpu_fp8_exec_fmsub(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    if (ctx->rm >= FPU_FP8_TABLE_RM_NUM)
+        return fms(result, op1, op2, op3, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+    uint64_t r;
+    int flags = intfp_fms(&r, op1[0] & 0xFF, op2[0] & 0xFF, op3[0] & 0xFF, ctx->rm, ctx->dst_env);
+    result[0] = r;
+    return flags;
+}
+
+int fpu_fp8_exec_fnmsub(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    if (ctx->rm >= FPU_FP8_TABLE_RM_NUM)
+        return fnms(result, op1, op2, op3, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+    uint64_t r;
+    int flags = intfp_fnms(&r, op1[0] & 0xFF, op2[0] & 0xFF, op3[0] & 0xFF, ctx->rm, ctx->dst_env);
+    result[0] = r;
+    return flags;
+}
+
+// rm selects the comparison : 0 FLE, 1 FLT, 2 FEQ
+int fpu_fp8_exec_fcmp(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    int table = (ctx->rm == 0) ? FP8_TABLE_LEQ : (ctx->rm == 1) ? FP8_TABLE_LT : FP8_TABLE_EQ;
+    return table_lookup(result, table, op1[0], op2[0]);
+}
+
+// rm selects the operation : 0 FMIN, 1 FMAX
+int fpu_fp8_exec_fmin_max(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    return table_lookup(result, (ctx->rm == 0) ? FP8_TABLE_MIN : FP8_TABLE_MAX, op1[0], op2[0]);
+}
@@ -0,0 +1,203 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Operand generator of the reference model
+ *  History       :
+ */
+
+#include "fpu_gen.h"
+#include "fpu_util.h"
+#include <cstring>
+
+// Default weights of fpu_txn (operands_config_c, fp_mant_cfg_c and int_values_cfg_c)
+static const uint32_t default_class_w[FPU_GEN_CLASS_NUM] = { 1, 1, 1, 1, 30, 66, 0 };
+static const uint32_t default_mant_w[FPU_GEN_MANT_NUM]   = { 10, 10, 30, 30, 20 };
+static const uint32_t default_int_w[FPU_GEN_INT_NUM]     = { 10, 90 };
+
+// special_int_values of fpu_txn
+static const uint64_t bound_values[] = {
+    0x7FFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x7FFFFFFFULL, 0xFFFFFFFFULL, 0
+};
+#define BOUND_VALUE_NUM (sizeof(bound_values) / sizeof(bound_values[0]))
+
+static inline uint64_t rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+// Uniform value below n, n up to 2^32
+static inline uint32_t below(fpu_gen* gen, uint64_t n)
+{
+    return (uint32_t) (((fpu_gen_next(gen) >> 32) * n) >> 32);
+}
+
+// Index of a value drawn with the weights w[0..num-1]
+static int draw(fpu_gen* gen, const uint32_t* w, int num)
+{
+    uint64_t sum = 0;
+    for (int k = 0; k < num; k++)
+        sum += w[k];
+    if (sum == 0)
+        return 0;
+
+    uint64_t r = ((fpu_gen_next(gen) >> 32) * sum) >> 32;
+    for (int k = 0; k < num; k++)
+    {
+        if (r < w[k])
+            return k;
+        r -= w[k];
+    }
+    return num - 1;
+}
+
+void fpu_gen_init(fpu_gen* gen, uint64_t seed)
+{
+    for (int k = 0; k < 4; k++)
+        gen->s[k] = fpu_splitmix64(&seed);
+    memcpy(gen->class_w, default_class_w, sizeof(gen->class_w));
+    memcpy(gen->mant_w, default_mant_w, sizeof(gen->mant_w));
+    memcpy(gen->int_w, default_int_w, sizeof(gen->int_w));
+}
+
+void fpu_gen_set_weights(fpu_gen* gen, const uint32_t* class_w, const uint32_t* mant_w, const uint32_t* int_w)
+{
+    if (class_w != NULL)
+        memcpy(gen->class_w, class_w, sizeof(gen->class_w));
+    if (mant_w != NULL)
+        memcpy(gen->mant_w, mant_w, sizeof(gen->mant_w));
+    if (int_w != NULL)
+        memcpy(gen->int_w, int_w, sizeof(gen->int_w));
+}
+
+uint64_t fpu_gen_next(fpu_gen* gen)
+{
+    uint64_t* s      = gen->s;
+    uint64_t  result = rotl(s[1] * 5, 7) * 9;
+    uint64_t  t      = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3]  = rotl(s[3], 45);
+    return result;
+}
+
+uint64_t fpu_gen_corner(environment env, int corner)
+{
+    int      t     = MBITS(env);
+    uint64_t E_max = fpu_low_mask(ES(env.es));
+    uint64_t bias  = E_max >> 1;
+    uint64_t T_max = fpu_low_mask(t);
+
+    switch (corner)
+    {
+    case FPU_GEN_MIN_SUBNORMAL:        return 1;
+    case FPU_GEN_MAX_SUBNORMAL:        return T_max;
+    case FPU_GEN_MIN_NORMAL:           return 1ULL << t;
+    case FPU_GEN_MIN_NORMAL_PLUS_ULP:  return (1ULL << t) | 1;
+    case FPU_GEN_MAX_NORMAL_MINUS_ULP: return ((E_max - 1) << t) | (T_max - 1);
+    case FPU_GEN_MAX_NORMAL:           return ((E_max - 1) << t) | T_max;
+    case FPU_GEN_ONE_MINUS_ULP:        return ((bias - 1) << t) | T_max;
+    case FPU_GEN_ONE:                  return bias << t;
+    case FPU_GEN_ONE_PLUS_ULP:         return (bias << t) | 1;
+    default:                           return 0;
+    }
+}
+
+// Trailing significand of t bits of a mantissa configuration
+static uint64_t mantissa(fpu_gen* gen, int t, int mant)
+{
+    switch (mant)
+    {
+    case FPU_GEN_ALL_ZEROS:    return 0;
+    case FPU_GEN_ALL_ONES:     return fpu_low_mask(t);
+    case FPU_GEN_WALKING_ONE:  return 1ULL << below(gen, t);
+    case FPU_GEN_WALKING_ZERO: return fpu_low_mask(t) ^ (1ULL << below(gen, t));
+    default:                   return fpu_gen_next(gen) & fpu_low_mask(t);
+    }
+}
+
+uint64_t fpu_gen_float_of(fpu_gen* gen, environment env, int cls, int mant)
+{
+    int      width = BIS(env.bis);
+    int      t     = MBITS(env);
+    uint64_t E_max = fpu_low_mask(ES(env.es));
+    uint64_t sign  = fpu_gen_next(gen) >> 63;
+    uint64_t quiet = 1ULL << (t - 1);
+    uint64_t E, T;
+
+    switch (cls)
+    {
+    case FPU_GEN_INF:
+        E = E_max;
+        T = 0;
+        break;
+    case FPU_GEN_ZERO:
+        E = 0;
+        T = 0;
+        break;
+    case FPU_GEN_SNAN:
+        // Quiet bit clear, at least one other bit set
+        E = E_max;
+        T = fpu_gen_next(gen) & (quiet - 1);
+        T = T ? T : 1;
+        break;
+    case FPU_GEN_QNAN:
+        E = E_max;
+        T = quiet | (fpu_gen_next(gen) & (quiet - 1));
+        break;
+    case FPU_GEN_SUBNORMAL:
+        // Only an ALL_ZEROS configuration gives a zero
+        E = 0;
+        T = mantissa(gen, t, mant);
+        T = (T == 0 && mant != FPU_GEN_ALL_ZEROS) ? 1 : T;
+        break;
+    case FPU_GEN_NORMAL:
+        E = 1 + below(gen, E_max - 1);
+        T = mantissa(gen, t, mant);
+        break;
+    default:
+        return (sign << (width - 1)) | fpu_gen_corner(env, below(gen, FPU_GEN_CORNER_NUM));
+    }
+    return (sign << (width - 1)) | (E << t) | T;
+}
+
+uint64_t fpu_gen_float(fpu_gen* gen, environment env)
+{
+    int cls  = draw(gen, gen->class_w, FPU_GEN_CLASS_NUM);
+    int mant = (cls == FPU_GEN_SUBNORMAL || cls == FPU_GEN_NORMAL) ? draw(gen, gen->mant_w, FPU_GEN_MANT_NUM) : 0;
+    return fpu_gen_float_of(gen, env, cls, mant);
+}
+
+uint64_t fpu_gen_int_of(fpu_gen* gen, int type)
+{
+    if (type == FPU_GEN_BOUND_VALUES)
+        return bound_values[below(gen, BOUND_VALUE_NUM)];
+    return fpu_gen_next(gen);
+}
+
+uint64_t fpu_gen_int(fpu_gen* gen)
+{
+    return fpu_gen_int_of(gen, draw(gen, gen->int_w, FPU_GEN_INT_NUM));
+}
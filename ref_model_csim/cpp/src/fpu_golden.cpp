@@ -0,0 +1,278 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Golden-vector files of the testbench : writer and memory-mapped reader
+ *  History       :
+ */
+
+#include "fpu_golden.h"
+#include "fpu_store.h"
+#include "fpu_util.h"
+#include <gmp.h>
+#include <mpfr.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const uint8_t*           golden_map     = NULL;
+static size_t                   golden_size    = 0;
+static const fpu_golden_record* golden_records = NULL;
+static uint64_t                 golden_count   = 0;
+static std::mutex               golden_mutex;
+
+#define RECORD_BUFFER 1024 // records buffered before they are written
+
+static int                            record_fd = -1;
+static uint64_t                       record_count = 0;
+static std::vector<fpu_golden_record> record_buffer;
+static std::mutex                     record_mutex;
+
+// Close the recorded stream at exit, the last records are written and the stream is readable
+static struct golden_exit
+{
+    ~golden_exit()
+    {
+        fpu_golden_record_close();
+    }
+} golden_exit_instance;
+
+static void init_header(fpu_golden_header* header, uint64_t nrecords, int xlen, int flen, uint64_t seed,
+                        uint32_t flags)
+{
+    memset(header, 0, sizeof(*header));
+    header->magic       = FPU_GOLDEN_MAGIC;
+    header->version     = FPU_GOLDEN_VERSION;
+    header->record_size = sizeof(fpu_golden_record);
+    header->nrecords    = nrecords;
+    header->xlen        = xlen;
+    header->flen        = flen;
+    header->flags       = flags;
+    header->seed        = seed;
+    header->model_hash  = fpu_store_model_hash();
+    snprintf(header->model, sizeof(header->model), "%s", fpu_store_model_version());
+    snprintf(header->mpfr, sizeof(header->mpfr), "%s", mpfr_get_version());
+    snprintf(header->gmp, sizeof(header->gmp), "%s", gmp_version);
+}
+
+int fpu_golden_write(const char* path, const fpu_golden_record* records, uint64_t nrecords, int xlen, int flen,
+                     uint64_t seed)
+{
+    fpu_golden_header header;
+    init_header(&header, nrecords, xlen, flen, seed, 0);
+
+    // Written aside then renamed, a simulation mapping the previous file never reads a partial one
+    std::string tmp = std::string(path) + ".tmp";
+    int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    if (fd < 0)
+    {
+        fprintf(stderr, "fpu_golden: cannot create %s\n", tmp.c_str());
+        return -1;
+    }
+    bool ok = fpu_write_all(fd, &header, sizeof(header)) && fpu_write_all(fd, records, nrecords * sizeof(fpu_golden_record));
+    ok = (close(fd) == 0) && ok;
+    if (!ok || rename(tmp.c_str(), path) != 0)
+    {
+        fprintf(stderr, "fpu_golden: cannot write %s\n", path);
+        unlink(tmp.c_str());
+        return -1;
+    }
+    return 0;
+}
+
+//########## RECORDING #################################################################################################
+
+int fpu_golden_record_open(const char* path, int xlen, int flen)
+{
+    fpu_golden_record_close();
+
+    std::lock_guard<std::mutex> lock(record_mutex);
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    if (fd < 0)
+    {
+        fprintf(stderr, "fpu_golden: cannot create %s\n", path);
+        return -1;
+    }
+
+    fpu_golden_header header;
+    init_header(&header, FPU_GOLDEN_OPEN, xlen, flen, 0, FPU_GOLDEN_RECORDED);
+    if (!fpu_write_all(fd, &header, sizeof(header)))
+    {
+        fprintf(stderr, "fpu_golden: cannot write %s\n", path);
+        close(fd);
+        return -1;
+    }
+    record_fd    = fd;
+    record_count = 0;
+    record_buffer.clear();
+    record_buffer.reserve(RECORD_BUFFER);
+    return 0;
+}
+
+// Write the buffered records, the recording stops on error. Called with record_mutex held.
+static void record_flush()
+{
+    if (record_buffer.empty())
+        return;
+    if (!fpu_write_all(record_fd, record_buffer.data(), record_buffer.size() * sizeof(fpu_golden_record)))
+    {
+        fprintf(stderr, "fpu_golden: cannot write the recorded stream, recording stopped\n");
+        close(record_fd);
+        record_fd = -1;
+    }
+    record_count += record_buffer.size();
+    record_buffer.clear();
+}
+
+void fpu_golden_record_write(const fpu_golden_record* record)
+{
+    std::lock_guard<std::mutex> lock(record_mutex);
+    if (record_fd < 0)
+        return;
+    record_buffer.push_back(*record);
+    if (record_buffer.size() == RECORD_BUFFER)
+        record_flush();
+}
+
+void fpu_golden_record_close()
+{
+    std::lock_guard<std::mutex> lock(record_mutex);
+    if (record_fd < 0)
+        return;
+    record_flush();
+    if (record_fd >= 0)
+    {
+        if (pwrite(record_fd, &record_count, sizeof(record_count), offsetof(fpu_golden_header, nrecords)) !=
+            (ssize_t) sizeof(record_count))
+            fprintf(stderr, "fpu_golden: cannot close the recorded stream\n");
+        close(record_fd);
+    }
+    record_fd = -1;
+}
+
+bool fpu_golden_recording()
+{
+    return record_fd >= 0;
+}
+
+//########## READING ###################################################################################################
+
+static void golden_unmap()
+{
+    if (golden_map != NULL)
+        munmap((void*) golden_map, golden_size);
+    golden_map     = NULL;
+    golden_size    = 0;
+    golden_records = NULL;
+    golden_count   = 0;
+}
+
+int fpu_golden_open(const char* path, int xlen, int flen)
+{
+    std::lock_guard<std::mutex> lock(golden_mutex);
+
+    golden_unmap();
+
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(fpu_golden_header))
+    {
+        fprintf(stderr, "fpu_golden: cannot open %s\n", path);
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+
+    size_t size = st.st_size;
+    void*  map  = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        fprintf(stderr, "fpu_golden: cannot map %s\n", path);
+        return -1;
+    }
+    // Records are read in order by the sequence, then once more by the scoreboard a few requests later
+    madvise(map, size, MADV_SEQUENTIAL);
+
+    const fpu_golden_header* header    = (const fpu_golden_header*) map;
+    uint64_t                 available = (size - sizeof(fpu_golden_header)) / sizeof(fpu_golden_record);
+    uint64_t                 nrecords  = header->nrecords;
+    if (header->magic != FPU_GOLDEN_MAGIC || header->version != FPU_GOLDEN_VERSION ||
+        header->record_size != sizeof(fpu_golden_record))
+    {
+        fprintf(stderr, "fpu_golden: %s is not a golden-vector file of version %d\n", path, FPU_GOLDEN_VERSION);
+        munmap(map, size);
+        return -1;
+    }
+    if (nrecords == FPU_GOLDEN_OPEN && (header->flags & FPU_GOLDEN_RECORDED))
+    {
+        // Recording of a simulation that did not end
+        nrecords = available;
+        fprintf(stderr, "fpu_golden: %s was not closed, %llu records kept\n", path, (unsigned long long) nrecords);
+    }
+    if (nrecords > available)
+    {
+        fprintf(stderr, "fpu_golden: %s is truncated\n", path);
+        munmap(map, size);
+        return -1;
+    }
+    if ((xlen != 0 && header->xlen != xlen) || (flen != 0 && header->flen != flen))
+    {
+        fprintf(stderr, "fpu_golden: %s was generated for XLEN=%d FLEN=%d\n", path, header->xlen, header->flen);
+        munmap(map, size);
+        return -1;
+    }
+
+    golden_map     = (const uint8_t*) map;
+    golden_size    = size;
+    golden_records = (const fpu_golden_record*) (golden_map + sizeof(fpu_golden_header));
+    golden_count   = nrecords;
+    // The expectations of a file are those of the model which generated it, recorded streams have none
+    return (header->flags & FPU_GOLDEN_RECORDED) || header->model_hash == fpu_store_model_hash() ? 0 : 1;
+}
+
+void fpu_golden_close()
+{
+    std::lock_guard<std::mutex> lock(golden_mutex);
+    golden_unmap();
+}
+
+const fpu_golden_header* fpu_golden_get_header()
+{
+    return (const fpu_golden_header*) golden_map;
+}
+
+uint64_t fpu_golden_count()
+{
+    return golden_count;
+}
+
+const fpu_golden_record* fpu_golden_get(uint64_t index)
+{
+    return index < golden_count ? &golden_records[index] : NULL;
+}
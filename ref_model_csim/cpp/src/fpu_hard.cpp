@@ -0,0 +1,521 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Hard-case operand generator of the reference model
+ *  History       :
+ */
+
+#include "fpu_hard.h"
+#include "fpu_exec.h"
+#include <algorithm>
+
+typedef unsigned __int128 u128;
+
+static const char* hard_names[FPU_HARD_NUM] = {
+    "tie", "above_tie", "below_tie", "underflow", "overflow", "cancellation"
+};
+
+// Parameters of a format, the exponents are the ones of the values 1.f * 2^E
+typedef struct
+{
+    int p;      // precision, hidden bit included
+    int width;
+    int bias;
+    int emin;
+    int emax;
+} hard_fmt;
+
+// Operands of an operation, in the order of its mathematical definition : x + y, x * y, x * y + z, x / y, sqrt(x)
+typedef struct
+{
+    uint64_t x, y, z;
+} hard_src;
+
+static inline u128 one(int n)
+{
+    return (u128) 1 << n;
+}
+
+static inline int bit_length(u128 x)
+{
+    int n = 0;
+    for (; x != 0; x >>= 1)
+        n++;
+    return n;
+}
+
+// Uniform value in [lo, hi]
+static inline int range(fpu_gen* gen, int lo, int hi)
+{
+    return hi <= lo ? lo : lo + (int) (((fpu_gen_next(gen) >> 32) * (uint64_t) (hi - lo + 1)) >> 32);
+}
+
+// Random significand of n bits, leading bit set
+static inline u128 significand(fpu_gen* gen, int n)
+{
+    return one(n - 1) | (fpu_gen_next(gen) & (u128) (one(n - 1) - 1));
+}
+
+// Encoding of (-1)^sign * X * 2^e, the value must be representable
+static uint64_t encode(const hard_fmt& f, int sign, u128 X, int e)
+{
+    uint64_t s = (uint64_t) sign << (f.width - 1);
+    if (X == 0)
+        return s;
+
+    int n = bit_length(X);
+    if (n > f.p)
+    {
+        X >>= n - f.p;
+        e  += n - f.p;
+    }
+    else
+    {
+        X <<= f.p - n;
+        e  -= f.p - n;
+    }
+
+    int E = e + f.p - 1;
+    if (E > f.emax)
+        return s | ((uint64_t) (2 * f.bias + 1) << (f.p - 1));
+    if (E < f.emin)
+    {
+        X >>= std::min(f.emin - E, 127);
+        E   = f.emin - 1;
+    }
+    return s | ((uint64_t) (E + f.bias) << (f.p - 1)) | ((uint64_t) X & (((uint64_t) 1 << (f.p - 1)) - 1));
+}
+
+// Scales ex and ey of two factors X and Y of bx and by bits, such that ex + ey = s and both factors are normal
+static void split_scale(fpu_gen* gen, const hard_fmt& f, int s, int bx, int by, int* ex, int* ey)
+{
+    int K  = s + bx - 1 + by - 1;     // sum of the exponents of the factors
+    int lo = std::max(f.emin, K - f.emax);
+    int hi = std::min(f.emax, K - f.emin);
+
+    *ex = range(gen, lo, hi) - (bx - 1);
+    *ey = s - *ex;
+}
+
+// Rounding pattern of the m bits below the last kept bit
+static inline u128 tie_pattern(int hard, int m)
+{
+    u128 half = one(m - 1);
+    return hard == FPU_HARD_ABOVE_TIE ? half + 1 : hard == FPU_HARD_BELOW_TIE ? half - 1 : half;
+}
+
+// Inverse of an odd x modulo 2^64, Newton iteration
+static inline uint64_t inverse(uint64_t x)
+{
+    uint64_t inv = x;
+    for (int k = 0; k < 5; k++)
+        inv *= 2 - x * inv;
+    return inv;
+}
+
+//########## ADDITION ##################################################################################################
+
+static void hard_add(fpu_gen* gen, const hard_fmt& f, int hard, int sign, hard_src* src)
+{
+    int p = f.p;
+
+    switch (hard)
+    {
+    case FPU_HARD_UNDERFLOW:
+    {
+        // Smallest normal plus r ulps, minus r+1 ulps : largest subnormal
+        u128 r = fpu_gen_next(gen) & (u128) (one(p - 2) - 1);
+        src->x = encode(f, sign, one(p - 1) + r, f.emin - (p - 1));
+        src->y = encode(f, !sign, r + 1, f.emin - (p - 1));
+        break;
+    }
+    case FPU_HARD_OVERFLOW:
+        // Largest normal plus half an ulp
+        src->x = encode(f, sign, one(p) - 1, f.emax - (p - 1));
+        src->y = encode(f, sign, 1, f.emax - p);
+        if (fpu_gen_next(gen) >> 63)
+            std::swap(src->x, src->y);
+        break;
+    case FPU_HARD_CANCELLATION:
+    {
+        // Operands within 2^(k+1) ulps of each other, same exponent or exponents one apart : p-k-1 bits cancel
+        int  k = range(gen, 0, p / 2);
+        u128 u = fpu_gen_next(gen) & (u128) (one(k) - 1);
+        u128 v = fpu_gen_next(gen) & (u128) (one(k) - 1);
+        if (fpu_gen_next(gen) >> 63)
+        {
+            int  E = range(gen, f.emin, f.emax);
+            u128 X = significand(gen, p);
+            u128 Y = X - u - 1 >= one(p - 1) ? X - u - 1 : X + u + 1;
+            src->x = encode(f, sign, X, E - (p - 1));
+            src->y = encode(f, !sign, Y, E - (p - 1));
+        }
+        else
+        {
+            int E = range(gen, f.emin + 1, f.emax);
+            src->x = encode(f, sign, one(p - 1) + u, E - (p - 1));
+            src->y = encode(f, !sign, one(p) - 1 - v, E - p);
+        }
+        break;
+    }
+    default:
+    {
+        // x = X * 2^d, no carry out of X as its second bit is clear, y = Y whose d low bits hold the pattern
+        int  d = hard == FPU_HARD_TIE ? range(gen, 2, p - 1) : p - 1;
+        u128 X = one(p - 1) | (fpu_gen_next(gen) & (u128) (one(p - 2) - 1));
+        u128 Y = (significand(gen, p) & ~(u128) (one(d) - 1)) | tie_pattern(hard, d);
+        int  E = range(gen, f.emin + d, f.emax - 1);
+        src->x = encode(f, sign, X, E - (p - 1));
+        src->y = encode(f, sign, Y, E - (p - 1) - d);
+        break;
+    }
+    }
+}
+
+//########## MULTIPLICATION ############################################################################################
+
+// Factors of 2^(p+1)-1 of at most p bits, 2^(u*v)-1 = (2^u-1) * sum(2^(i*u), i < v). False if p+1 is prime.
+static bool overflow_factors(fpu_gen* gen, int p, u128* X, u128* Y)
+{
+    int divisors[64], num = 0;
+    for (int u = 2; u <= p && num < 64; u++)
+        if ((p + 1) % u == 0)
+            divisors[num++] = u;
+    if (num == 0)
+        return false;
+
+    int u = divisors[range(gen, 0, num - 1)];
+    *X = one(u) - 1;
+    *Y = 0;
+    for (int i = 0; i < (p + 1) / u; i++)
+        *Y |= one(i * u);
+    return true;
+}
+
+static void hard_mul(fpu_gen* gen, const hard_fmt& f, int hard, int sign, hard_src* src)
+{
+    int  p = f.p;
+    int  s, ex, ey;
+    u128 X, Y;
+
+    switch (hard)
+    {
+    case FPU_HARD_UNDERFLOW:
+        // X * floor(2^(2p-1) / X) is in ]2^(2p-1) - 2^p, 2^(2p-1)[ when X is not a power of two
+        X = significand(gen, p) | 1;
+        Y = one(2 * p - 1) / X;
+        s = f.emin - (2 * p - 1);
+        break;
+    case FPU_HARD_OVERFLOW:
+        // Product of p+1 bits set
+        if (!overflow_factors(gen, p, &X, &Y))
+        {
+            X = significand(gen, p) | 1;
+            Y = ((one(p + 1) - 1) << (p - 2)) / X;
+            s = f.emax - 2 * p + 2;
+            break;
+        }
+        s = f.emax - p;
+        break;
+    default:
+    {
+        // X of p-1 bits, the product has N = p+m bits and its m low bits hold the pattern : Y is the inverse of X
+        // times the pattern modulo 2^m, plus a multiple of 2^m in [2^(N-1) / X, 2^N / X[ (wider than 2^m)
+        int  m       = (hard == FPU_HARD_TIE || p < 4) ? range(gen, 1, p - 2) : p - 2;
+        u128 pattern = tie_pattern(p < 4 ? FPU_HARD_TIE : hard, m);
+        u128 M = one(m);
+        int  N = p + m;
+
+        X = one(p - 2) | (fpu_gen_next(gen) & (u128) (one(p - 2) - 1)) | 1;
+        u128 lo = (one(N - 1) + X - 1) / X;
+        u128 hi = (one(N) - 1) / X;
+        u128 y0 = (pattern * inverse((uint64_t) X)) & (M - 1);
+        Y = lo + ((y0 - lo) & (M - 1));
+        Y += M * (u128) range(gen, 0, (int) std::min((hi - Y) / M, (u128) 0x7FFFFFFF));
+        s = range(gen, f.emin / 2 + 1, f.emax / 2 - 1) - (N - 1);
+        break;
+    }
+    }
+
+    if (fpu_gen_next(gen) >> 63)
+        std::swap(X, Y);
+    split_scale(gen, f, s, bit_length(X), bit_length(Y), &ex, &ey);
+    src->x = encode(f, sign, X, ex);
+    src->y = encode(f, 0, Y, ey);
+}
+
+//########## FUSED MULTIPLY-ADD ########################################################################################
+
+static void hard_fma(fpu_gen* gen, const hard_fmt& f, int hard, int sign, hard_src* src)
+{
+    int  p = f.p;
+    int  s, ex, ey;
+    u128 X, Y, C;
+    int  c_sign = 0;
+
+    if (hard == FPU_HARD_UNDERFLOW)
+    {
+        // Product below the smallest normal, zero addend
+        hard_mul(gen, f, hard, sign, src);
+        src->z = encode(f, sign, 0, 0);
+        return;
+    }
+
+    if (hard == FPU_HARD_OVERFLOW)
+    {
+        // T = 2^(p+1)-1 followed by p-2 zeros, the addend is the remainder of T / X
+        u128 T = (one(p + 1) - 1) << (p - 2);
+        X = significand(gen, p) | 1;
+        Y = T / X;
+        C = T - X * Y;
+        s = f.emax - 2 * p + 2;
+    }
+    else
+    {
+        // The product keeps its p high bits H, the addend replaces its m low bits L by the pattern, or cancels H
+        X = significand(gen, p);
+        Y = significand(gen, p);
+        u128 P = X * Y;
+        int  m = bit_length(P) - p;
+        u128 L = P & (one(m) - 1);
+        u128 H = P - L;
+
+        if (hard == FPU_HARD_CANCELLATION)
+        {
+            c_sign = 1;
+            C      = H + ((fpu_gen_next(gen) >> 63) ? one(m) : 0);
+        }
+        else
+        {
+            u128 target = tie_pattern(hard, m);
+            c_sign = target < L;
+            C      = c_sign ? L - target : target - L;
+        }
+        s = range(gen, f.emin + p, f.emax - 1) - (bit_length(P) - 1);
+    }
+
+    split_scale(gen, f, s, bit_length(X), bit_length(Y), &ex, &ey);
+    src->x = encode(f, sign, X, ex);
+    src->y = encode(f, 0, Y, ey);
+    src->z = encode(f, sign ^ c_sign, C, s);
+}
+
+//########## DIVISION AND SQUARE ROOT ##################################################################################
+
+// Multiplier of the distance to the midpoint, negligible against the 2^p scale of the operands
+static inline uint64_t offset(fpu_gen* gen, int p)
+{
+    return (uint64_t) range(gen, 0, (1 << (p >= 5 ? std::min((p - 5) / 2, 24) : 0)) - 1);
+}
+
+// Square root of a modulo 2^n, a = 1 mod 8, Hensel lifting
+static inline u128 sqrt_mod(u128 a, int n)
+{
+    u128 x = 1;
+    for (int i = 3; i < n; i++)
+        if (((x * x - a) >> i) & 1)
+            x += one(i - 1);
+    return x & (one(n) - 1);
+}
+
+// X * 2^k = Q * Y +/- r for a target Q of p+1 bits, odd : Q = -/+ r / Y modulo 2^k, k = p or p+1 depending on the
+// size of Q * Y. One draw of Y out of two at least has a solution.
+static bool div_operands(fpu_gen* gen, int p, bool above, u128* X, u128* Y, int* k)
+{
+    uint64_t r = 1 + 2 * offset(gen, p);
+
+    *Y = significand(gen, p) | 1;
+    for (*k = p + 1; *k >= p; (*k)--)
+    {
+        u128 M = one(*k);
+        u128 Q = (inverse((uint64_t) *Y) * r) & (M - 1);
+        Q = (above ? M - Q : Q) & (M - 1);
+        Q = *k == p ? Q + one(p) : Q;
+
+        u128 N = above ? Q * *Y + r : Q * *Y - r;
+        if (Q >= one(p) && N >= one(p - 1 + *k) && N <= one(p + *k))
+        {
+            *X = N >> *k;
+            return true;
+        }
+    }
+    return false;
+}
+
+// X * 2^k = Q^2 +/- r for a target Q of p+1 bits, odd : Q is a square root of -/+ r modulo 2^k, k = p+1 or p+2
+// depending on the size of Q^2. An odd square is 1 modulo 8, r is 7 modulo 8 above the midpoint and 1 below.
+static bool sqrt_operand(fpu_gen* gen, int p, bool above, u128* X, int* k)
+{
+    uint64_t r    = (above ? 7 : 1) + 8 * offset(gen, p);
+    u128     root = sqrt_mod(above ? one(p + 2) - r : (u128) r, p + 2);
+    int      pick = range(gen, 0, 3);
+
+    // Square roots modulo 2^(p+1) : +/- root, +/- root + 2^p
+    for (int c = 0; c < 4; c++)
+    {
+        u128 Q = (((pick + c) & 1) ? one(p + 1) - root : root) + (((pick + c) & 2) ? one(p) : 0);
+        Q &= one(p + 1) - 1;
+
+        u128 N = above ? Q * Q + r : Q * Q - r;
+        *k = N < one(2 * p + 1) ? p + 1 : p + 2;
+        if (Q >= one(p) && (N & (one(*k) - 1)) == 0 && N <= one(p + *k))
+        {
+            *X = N >> *k;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void hard_div(fpu_gen* gen, const hard_fmt& f, int hard, int sign, hard_src* src)
+{
+    int  p = f.p;
+    int  ex, ey, k, tries = 0;
+    u128 X, Y;
+
+    if (hard == FPU_HARD_UNDERFLOW)
+    {
+        // (Y-1) / Y * 2^emin is in ]2^emin - 2^(emin-p+1), 2^emin[ for Y odd of p bits
+        Y  = significand(gen, p) | 1;
+        X  = Y - 1;
+        ex = range(gen, f.emin, f.emax + f.emin) - (p - 1);
+        ey = ex - f.emin;
+    }
+    else if (hard == FPU_HARD_OVERFLOW)
+    {
+        // No quotient gets close to the overflow midpoint, (2^p-1) / (2^p-1) * 2^(emax+1) is the overflow threshold
+        int j = range(gen, 0, -1 - f.emin);
+        X  = one(p) - 1;
+        Y  = X;
+        ex = f.emax - (p - 1) - j;
+        ey = -p - j;
+    }
+    else
+    {
+        while (!div_operands(gen, p, hard != FPU_HARD_BELOW_TIE, &X, &Y, &k) && ++tries < 256)
+            ;
+        if (tries == 256)
+        {
+            // Practically never reached, exact quotient
+            X = Y;
+            k = p;
+        }
+        ey = range(gen, f.emin / 2 + 1, f.emax / 2 - 1) - (p - 1);
+        ex = range(gen, f.emin / 2 + 1, f.emax / 2 - 1) - p + k + ey;
+    }
+    src->x = encode(f, sign, X, ex);
+    src->y = encode(f, 0, Y, ey);
+}
+
+static void hard_sqrt(fpu_gen* gen, const hard_fmt& f, int hard, hard_src* src)
+{
+    int  p = f.p;
+    int  k, tries = 0;
+    u128 X;
+
+    if (hard == FPU_HARD_UNDERFLOW)
+        src->x = encode(f, 0, 1, f.emin - (p - 1));
+    else if (hard == FPU_HARD_OVERFLOW)
+        src->x = encode(f, 0, one(p) - 1, f.emax - (p - 1));
+    else
+    {
+        while (!sqrt_operand(gen, p, hard != FPU_HARD_BELOW_TIE, &X, &k) && ++tries < 256)
+            ;
+        if (tries == 256)
+        {
+            // Practically never reached, exact square root
+            X = 1;
+            k = 0;
+        }
+        src->x = encode(f, 0, X, k + 2 * (range(gen, f.emin / 2 + 1, f.emax / 2 - 1) - p));
+    }
+}
+
+//########## REQUEST ###################################################################################################
+
+int fpu_hard_operands(fpu_gen* gen, int op, environment env, int hard, uint64_t* operand_a, uint64_t* operand_b,
+                      uint64_t* imm)
+{
+    hard_fmt f;
+    hard_src src = { 0, 0, 0 };
+    int      sign;
+    uint64_t minus;
+
+    f.p     = MBITS(env) + 1;
+    f.width = BIS(env.bis);
+    f.bias  = (1 << (ES(env.es) - 1)) - 1;
+    f.emin  = 1 - f.bias;
+    f.emax  = f.bias;
+    if (hard < 0 || hard >= FPU_HARD_NUM || f.p < 3 || f.width > 64)
+        return -1;
+
+    sign  = (int) (fpu_gen_next(gen) >> 63);
+    minus = 1ULL << (f.width - 1);
+    if (hard == FPU_HARD_CANCELLATION && op != FPU_OP_FADD && op != FPU_OP_FSUB && op != FPU_OP_FMADD
+        && op != FPU_OP_FNMADD && op != FPU_OP_FMSUB && op != FPU_OP_FNMSUB)
+        hard = FPU_HARD_TIE;
+
+    *operand_a = 0;
+    *operand_b = 0;
+    *imm       = 0;
+    switch (op)
+    {
+    case FPU_OP_FADD:
+    case FPU_OP_FSUB:
+        // operand_b + imm, operand_b - imm
+        hard_add(gen, f, hard, sign, &src);
+        *operand_b = src.x;
+        *imm       = op == FPU_OP_FSUB ? src.y ^ minus : src.y;
+        return 0;
+    case FPU_OP_FMUL:
+        hard_mul(gen, f, hard, sign, &src);
+        break;
+    case FPU_OP_FDIV:
+        hard_div(gen, f, hard, sign, &src);
+        break;
+    case FPU_OP_FSQRT:
+        hard_sqrt(gen, f, hard, &src);
+        break;
+    case FPU_OP_FMADD:
+    case FPU_OP_FNMADD:
+    case FPU_OP_FMSUB:
+    case FPU_OP_FNMSUB:
+        // The negations of the product and of the addend are undone on the operands
+        hard_fma(gen, f, hard, sign, &src);
+        if (op == FPU_OP_FNMADD || op == FPU_OP_FNMSUB)
+            src.x ^= minus;
+        if (op == FPU_OP_FNMADD || op == FPU_OP_FMSUB)
+            src.z ^= minus;
+        break;
+    default:
+        return -1;
+    }
+    *operand_a = src.x;
+    *operand_b = src.y;
+    *imm       = src.z;
+    return 0;
+}
+
+const char* fpu_hard_name(int hard)
+{
+    return (hard >= 0 && hard < FPU_HARD_NUM) ? hard_names[hard] : "unknown";
+}
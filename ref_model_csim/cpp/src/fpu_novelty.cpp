@@ -0,0 +1,270 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Novelty filter of the stimuli, a split block Bloom filter in a file mapped in memory
+ *  History       :
+ */
+
+#include "fpu_novelty.h"
+#include "fpu_store.h"
+#include <atomic>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define NOVELTY_MAGIC       0x4C45564F4E555046ULL // "FPUNOVEL"
+#define NOVELTY_VERSION     1
+#define NOVELTY_BLOCK_WORDS 8                     // 64-bit words of a block, one bit of a tuple in each
+
+// File header, followed by the blocks
+typedef struct
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t block_words;
+    uint64_t nblocks;       // power of two
+    uint64_t count;         // tuples inserted by every simulation, updated atomically
+    uint8_t  reserved[4096 - 32];
+} novelty_header;
+
+typedef struct
+{
+    uint64_t word[NOVELTY_BLOCK_WORDS];
+} novelty_block;
+
+static_assert(sizeof(novelty_header) == 4096, "novelty header must fill a page");
+static_assert(sizeof(novelty_block) == 64, "novelty blocks must fill a cache line");
+
+// Odd multipliers selecting the bit of each word, those of the split block Bloom filters of Parquet
+static const uint32_t salt[NOVELTY_BLOCK_WORDS] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+static novelty_header* novelty_map    = NULL;
+static novelty_block*  novelty_blocks = NULL;
+static size_t          novelty_size   = 0;
+static std::mutex      novelty_mutex;
+
+static std::atomic<uint64_t> novelty_lookups(0);
+static std::atomic<uint64_t> novelty_hits(0);
+static std::atomic<uint64_t> novelty_resamples(0);
+static std::atomic<uint64_t> novelty_inserts(0);
+static std::atomic<uint64_t> novelty_novel(0);
+
+// Read REFMODEL_NOVELTY when the library is loaded
+static struct novelty_env_init
+{
+    novelty_env_init()
+    {
+        const char* path = getenv(FPU_NOVELTY_ENV_VAR);
+        if (path != NULL && path[0] != '\0')
+            fpu_novelty_open(path, 0);
+    }
+} novelty_env_init_instance;
+
+// Header of the filter to open, read from the file or written to it
+typedef struct
+{
+    novelty_header header;
+    uint64_t       nblocks; // size of a new filter
+} novelty_open_args;
+
+static bool novelty_valid(int fd, void* arg)
+{
+    novelty_header& header = ((novelty_open_args*) arg)->header;
+    struct stat     st;
+    return fstat(fd, &st) == 0 && (size_t) st.st_size >= sizeof(novelty_header) &&
+           pread(fd, &header, sizeof(header), 0) == (ssize_t) sizeof(header) &&
+           header.magic == NOVELTY_MAGIC && header.version == NOVELTY_VERSION &&
+           header.block_words == NOVELTY_BLOCK_WORDS &&
+           header.nblocks != 0 && (header.nblocks & (header.nblocks - 1)) == 0 &&
+           (uint64_t) st.st_size == sizeof(novelty_header) + header.nblocks * sizeof(novelty_block);
+}
+
+static bool novelty_init(int fd, void* arg)
+{
+    novelty_open_args* args   = (novelty_open_args*) arg;
+    novelty_header&    header = args->header;
+
+    memset(&header, 0, sizeof(header));
+    header.magic       = NOVELTY_MAGIC;
+    header.version     = NOVELTY_VERSION;
+    header.block_words = NOVELTY_BLOCK_WORDS;
+    header.nblocks     = args->nblocks;
+
+    // Extending the empty file zero-fills the blocks
+    return ftruncate(fd, sizeof(novelty_header) + header.nblocks * sizeof(novelty_block)) == 0 &&
+           pwrite(fd, &header, sizeof(header), 0) == (ssize_t) sizeof(header);
+}
+
+int fpu_novelty_open(const char* path, uint64_t entries)
+{
+    std::lock_guard<std::mutex> lock(novelty_mutex);
+
+    if (novelty_map != NULL)
+    {
+        munmap(novelty_map, novelty_size);
+        novelty_map    = NULL;
+        novelty_blocks = NULL;
+    }
+
+    if (entries == 0)
+    {
+        const char* env_entries = getenv(FPU_NOVELTY_ENTRIES_ENV_VAR);
+        entries = (env_entries != NULL) ? strtoull(env_entries, NULL, 0) : FPU_NOVELTY_DEFAULT_ENTRIES;
+    }
+    uint64_t nblocks = 1;
+    while (nblocks * sizeof(novelty_block) * 8 < entries * FPU_NOVELTY_BITS_PER_ENTRY)
+        nblocks <<= 1;
+
+    // Bits are set atomically, the file lock only serialises the creation of the filter
+    novelty_open_args args;
+    args.nblocks = nblocks;
+    int fd = fpu_shared_file_open(path, novelty_valid, novelty_init, &args);
+    if (fd < 0)
+    {
+        fprintf(stderr, "fpu_novelty: cannot open %s\n", path);
+        return -1;
+    }
+
+    size_t size = sizeof(novelty_header) + args.header.nblocks * sizeof(novelty_block);
+    void* map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    flock(fd, LOCK_UN);
+    close(fd);
+
+    if (map == MAP_FAILED)
+    {
+        fprintf(stderr, "fpu_novelty: cannot map %s\n", path);
+        return -1;
+    }
+
+    novelty_size   = size;
+    novelty_map    = (novelty_header*) map;
+    novelty_blocks = (novelty_block*) ((uint8_t*) map + sizeof(novelty_header));
+    return 0;
+}
+
+void fpu_novelty_close()
+{
+    std::lock_guard<std::mutex> lock(novelty_mutex);
+    if (novelty_map != NULL)
+        munmap(novelty_map, novelty_size);
+    novelty_map    = NULL;
+    novelty_blocks = NULL;
+}
+
+bool fpu_novelty_enabled()
+{
+    return novelty_blocks != NULL;
+}
+
+// Block of a tuple from the upper bits of its hash, the bits of its words from the lower ones
+static inline novelty_block* get_block(uint64_t hash)
+{
+    return &novelty_blocks[(hash >> 32) & (novelty_map->nblocks - 1)];
+}
+
+static inline uint64_t word_mask(uint64_t hash, int w)
+{
+    return 1ULL << (((uint32_t) hash * salt[w]) >> 26);
+}
+
+bool fpu_novelty_lookup(const fpu_cache_key* key)
+{
+    if (novelty_blocks == NULL)
+        return false;
+
+    uint64_t       hash  = fpu_cache_key_hash(key);
+    novelty_block* block = get_block(hash);
+    bool           found = true;
+    for (int w = 0; w < NOVELTY_BLOCK_WORDS && found; w++)
+        found = (__atomic_load_n(&block->word[w], __ATOMIC_RELAXED) & word_mask(hash, w)) != 0;
+
+    novelty_lookups.fetch_add(1, std::memory_order_relaxed);
+    if (found)
+        novelty_hits.fetch_add(1, std::memory_order_relaxed);
+    return found;
+}
+
+bool fpu_novelty_resample(const fpu_cache_key* key, uint32_t percent, uint64_t random)
+{
+    if (!fpu_novelty_lookup(key) || random % 100 >= percent)
+        return false;
+    novelty_resamples.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool fpu_novelty_insert(const fpu_cache_key* key)
+{
+    if (novelty_blocks == NULL)
+        return false;
+
+    uint64_t       hash  = fpu_cache_key_hash(key);
+    novelty_block* block = get_block(hash);
+    bool           novel = false;
+    for (int w = 0; w < NOVELTY_BLOCK_WORDS; w++)
+    {
+        uint64_t mask = word_mask(hash, w);
+        novel |= (__atomic_fetch_or(&block->word[w], mask, __ATOMIC_RELAXED) & mask) == 0;
+    }
+
+    novelty_inserts.fetch_add(1, std::memory_order_relaxed);
+    if (novel)
+    {
+        novelty_novel.fetch_add(1, std::memory_order_relaxed);
+        __atomic_fetch_add(&novelty_map->count, 1, __ATOMIC_RELAXED);
+    }
+    return novel;
+}
+
+void fpu_novelty_get_stats(fpu_novelty_stats* stats)
+{
+    stats->lookups   = novelty_lookups.load(std::memory_order_relaxed);
+    stats->hits      = novelty_hits.load(std::memory_order_relaxed);
+    stats->resamples = novelty_resamples.load(std::memory_order_relaxed);
+    stats->inserts   = novelty_inserts.load(std::memory_order_relaxed);
+    stats->novel     = novelty_novel.load(std::memory_order_relaxed);
+}
+
+uint64_t fpu_novelty_count()
+{
+    return novelty_map != NULL ? __atomic_load_n(&novelty_map->count, __ATOMIC_RELAXED) : 0;
+}
+
+double fpu_novelty_fill()
+{
+    if (novelty_blocks == NULL)
+        return 0.0;
+
+    uint64_t set = 0;
+    for (uint64_t b = 0; b < novelty_map->nblocks; b++)
+        for (int w = 0; w < NOVELTY_BLOCK_WORDS; w++)
+            set += __builtin_popcountll(__atomic_load_n(&novelty_blocks[b].word[w], __ATOMIC_RELAXED));
+    return (double) set / (novelty_map->nblocks * NOVELTY_BLOCK_WORDS * 64);
+}
@@ -0,0 +1,333 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Per-entry call statistics of the DPI interface
+ *  History       :
+ */
+
+#include "fpu_stats.h"
+#include "fpu_util.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <vector>
+
+#define STATS_OP_NUM    (FPU_OP_NUM + 1)           // last index counts the out of range operations
+#define STATS_FMT_NUM   (FPU_STATS_FMT_OTHER + 1)
+#define STATS_SLOT_NUM  (FPU_STATS_ENTRY_NUM * STATS_OP_NUM * STATS_FMT_NUM)
+
+// Counters of a triple, only written by the owning thread, see fpu_add_relaxed
+typedef struct
+{
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> total_ns;
+    std::atomic<uint64_t> max_ns;
+    std::atomic<uint64_t> latency[FPU_STATS_LATENCY_NUM];
+    std::atomic<uint64_t> outcomes[FPU_STATS_OUTCOME_NUM];
+} stats_slot;
+
+typedef struct
+{
+    stats_slot slots[STATS_SLOT_NUM];
+} stats_block;
+
+std::atomic<bool> fpu_stats_on(false);
+
+static double     ns_per_tick = 1.0;
+static std::mutex calibrate_mutex;
+
+// Blocks of every thread that recorded a call. They are never freed, so the calls of the threads that exited are
+// still reported.
+static std::vector<stats_block*> blocks;
+static std::mutex                blocks_mutex;
+
+static thread_local stats_block* local_block = NULL;
+
+static const char* dpi_names[FPU_OP_NUM] = {
+    "dpi_fadd", "dpi_fsub", "dpi_fmul", "dpi_fdiv", "dpi_fma", "dpi_fnma", "dpi_fms", "dpi_fnms", "dpi_fcmp",
+    "dpi_fsqrt", "dpi_fmin_max", "dpi_fsgnj", "dpi_fcvt_f2i", "dpi_fcvt_i2f", "dpi_fcvt_f2f", "dpi_fclass",
+    "dpi_fmv_f2x", "dpi_fmv_x2f"
+};
+
+static const char* entry_names[FPU_STATS_ENTRY_NUM] = { NULL, "dpi_fpu_exec", "dpi_fpu_exec_all_rm" };
+
+static const char* outcome_names[FPU_STATS_OUTCOME_NUM] = { "NX", "UF", "OF", "DZ", "NV", "none", "unsupported" };
+
+// Read REFMODEL_STATS when the library is loaded
+static struct stats_env_init
+{
+    stats_env_init()
+    {
+        const char* value = getenv(FPU_STATS_ENV_VAR);
+        if (value != NULL && value[0] != '\0' && strcmp(value, "0") != 0)
+            fpu_stats_enable(true);
+    }
+} stats_env_init_instance;
+
+static uint64_t monotonic_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+// Measure the period of the clock of fpu_stats_now, once
+static void calibrate()
+{
+#if defined(__x86_64__)
+    static bool calibrated = false;
+
+    std::lock_guard<std::mutex> lock(calibrate_mutex);
+    if (calibrated)
+        return;
+
+    uint64_t ns0 = monotonic_ns(), tick0 = fpu_stats_now(), ns1;
+    do
+        ns1 = monotonic_ns();
+    while (ns1 - ns0 < 10000000);
+    ns_per_tick = (double) (ns1 - ns0) / (fpu_stats_now() - tick0);
+    calibrated  = true;
+#endif
+}
+
+void fpu_stats_enable(bool enable)
+{
+    if (enable)
+        calibrate();
+    fpu_stats_on.store(enable, std::memory_order_release);
+}
+
+bool fpu_stats_enabled()
+{
+    return fpu_stats_on.load(std::memory_order_relaxed);
+}
+
+static inline int slot_index(int entry, int op, int fmt)
+{
+    return (entry * STATS_OP_NUM + op) * STATS_FMT_NUM + fmt;
+}
+
+static stats_block* get_block()
+{
+    stats_block* b = local_block;
+    if (b == NULL)
+    {
+        b = new stats_block(); // value-initialised, counters start at 0
+        std::lock_guard<std::mutex> lock(blocks_mutex);
+        blocks.push_back(b);
+        local_block = b;
+    }
+    return b;
+}
+
+void fpu_stats_record(int entry, int64_t op, int64_t fmt, int flags, uint64_t start)
+{
+    uint64_t ns = (uint64_t) ((fpu_stats_now() - start) * ns_per_tick);
+
+    if (op < 0 || op >= FPU_OP_NUM)
+        op = FPU_OP_NUM;
+    if (fmt < 0 || fmt >= FPU_FMT_NUM)
+        fmt = FPU_STATS_FMT_OTHER;
+
+    stats_slot* s = &get_block()->slots[slot_index(entry, (int) op, (int) fmt)];
+
+    fpu_add_relaxed(s->calls, 1);
+    fpu_add_relaxed(s->total_ns, ns);
+    if (ns > s->max_ns.load(std::memory_order_relaxed))
+        s->max_ns.store(ns, std::memory_order_relaxed);
+
+    int bucket = ns == 0 ? 0 : 63 - __builtin_clzll(ns);
+    fpu_add_relaxed(s->latency[std::min(bucket, FPU_STATS_LATENCY_NUM - 1)], 1);
+
+    if (flags < 0)
+        fpu_add_relaxed(s->outcomes[6], 1);
+    else if ((flags & 0x1F) == 0)
+        fpu_add_relaxed(s->outcomes[5], 1);
+    else
+        for (int bit = 0; bit < 5; bit++)
+            if ((flags >> bit) & 1)
+                fpu_add_relaxed(s->outcomes[bit], 1);
+}
+
+void fpu_stats_get(fpu_stats_counters* counters, int entry, int op, int fmt)
+{
+    memset(counters, 0, sizeof(*counters));
+
+    std::lock_guard<std::mutex> lock(blocks_mutex);
+    for (size_t b = 0; b < blocks.size(); b++)
+    {
+        const stats_slot* s = &blocks[b]->slots[slot_index(entry, op, fmt)];
+
+        counters->calls    += s->calls.load(std::memory_order_relaxed);
+        counters->total_ns += s->total_ns.load(std::memory_order_relaxed);
+        counters->max_ns    = std::max(counters->max_ns, (uint64_t) s->max_ns.load(std::memory_order_relaxed));
+        for (int k = 0; k < FPU_STATS_LATENCY_NUM; k++)
+            counters->latency[k] += s->latency[k].load(std::memory_order_relaxed);
+        for (int k = 0; k < FPU_STATS_OUTCOME_NUM; k++)
+            counters->outcomes[k] += s->outcomes[k].load(std::memory_order_relaxed);
+    }
+}
+
+void fpu_stats_reset()
+{
+    std::lock_guard<std::mutex> lock(blocks_mutex);
+    for (size_t b = 0; b < blocks.size(); b++)
+    {
+        for (int i = 0; i < STATS_SLOT_NUM; i++)
+        {
+            stats_slot* s = &blocks[b]->slots[i];
+
+            s->calls.store(0, std::memory_order_relaxed);
+            s->total_ns.store(0, std::memory_order_relaxed);
+            s->max_ns.store(0, std::memory_order_relaxed);
+            for (int k = 0; k < FPU_STATS_LATENCY_NUM; k++)
+                s->latency[k].store(0, std::memory_order_relaxed);
+            for (int k = 0; k < FPU_STATS_OUTCOME_NUM; k++)
+                s->outcomes[k].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+//########## REPORT ####################################################################################################
+
+typedef struct
+{
+    int                entry, op, fmt;
+    fpu_stats_counters counters;
+} stats_row;
+
+static bool by_total_time(const stats_row& a, const stats_row& b)
+{
+    return a.counters.total_ns > b.counters.total_ns;
+}
+
+static const char* row_entry_name(const stats_row* r)
+{
+    if (r->entry != FPU_STATS_DPI)
+        return entry_names[r->entry];
+    return r->op < FPU_OP_NUM ? dpi_names[r->op] : "dpi_?";
+}
+
+static const char* row_fmt_name(const stats_row* r)
+{
+    return r->fmt == FPU_STATS_FMT_OTHER ? "OTHER" : fpu_fmt_name(r->fmt);
+}
+
+// Upper bound of the bucket holding the call of rank ceil(p * calls)
+static uint64_t percentile_ns(const fpu_stats_counters* c, double p)
+{
+    uint64_t rank = (uint64_t) (p * c->calls + 0.999999), seen = 0;
+
+    for (int k = 0; k < FPU_STATS_LATENCY_NUM; k++)
+    {
+        seen += c->latency[k];
+        if (seen >= rank && seen > 0)
+            return 2ULL << k;
+    }
+    return c->max_ns;
+}
+
+static void print_table(FILE* out, const std::vector<stats_row>& rows, uint64_t total_ns)
+{
+    fprintf(out, "%-20s %-9s %-7s %10s %10s %6s %9s %10s %9s %9s %9s %9s %9s %9s %9s %9s %9s\n", "ENTRY", "OP", "FMT",
+            "CALLS", "TIME(ms)", "SHARE", "MEAN(ns)", "MAX(ns)", "P50(ns)", "P99(ns)", "NX", "UF", "OF", "DZ", "NV",
+            "NONE", "UNSUP");
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        const stats_row*          r = &rows[i];
+        const fpu_stats_counters* c = &r->counters;
+
+        fprintf(out, "%-20s %-9s %-7s %10llu %10.3f %5.1f%% %9.0f %10llu %9llu %9llu", row_entry_name(r),
+                fpu_op_name(r->op), row_fmt_name(r), (unsigned long long) c->calls, c->total_ns / 1e6,
+                total_ns ? 100.0 * c->total_ns / total_ns : 0.0, (double) c->total_ns / c->calls,
+                (unsigned long long) c->max_ns, (unsigned long long) percentile_ns(c, 0.5),
+                (unsigned long long) percentile_ns(c, 0.99));
+        for (int k = 0; k < FPU_STATS_OUTCOME_NUM; k++)
+            fprintf(out, " %9llu", (unsigned long long) c->outcomes[k]);
+        fprintf(out, "\n");
+    }
+}
+
+// One triple per line
+static void write_json(FILE* f, const std::vector<stats_row>& rows, uint64_t total_ns)
+{
+    fprintf(f, "{\n  \"total_ns\": %llu,\n  \"rows\": [\n", (unsigned long long) total_ns);
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        const stats_row*          r = &rows[i];
+        const fpu_stats_counters* c = &r->counters;
+
+        fprintf(f, "    {\"entry\": \"%s\", \"op\": \"%s\", \"fmt\": \"%s\", \"calls\": %llu, \"total_ns\": %llu, "
+                   "\"max_ns\": %llu, \"p50_ns\": %llu, \"p99_ns\": %llu, \"latency_log2_ns\": [",
+                row_entry_name(r), fpu_op_name(r->op), row_fmt_name(r), (unsigned long long) c->calls,
+                (unsigned long long) c->total_ns, (unsigned long long) c->max_ns,
+                (unsigned long long) percentile_ns(c, 0.5), (unsigned long long) percentile_ns(c, 0.99));
+        for (int k = 0; k < FPU_STATS_LATENCY_NUM; k++)
+            fprintf(f, "%s%llu", k ? ", " : "", (unsigned long long) c->latency[k]);
+        fprintf(f, "]");
+        for (int k = 0; k < FPU_STATS_OUTCOME_NUM; k++)
+            fprintf(f, ", \"%s\": %llu", outcome_names[k], (unsigned long long) c->outcomes[k]);
+        fprintf(f, "}%s\n", i + 1 < rows.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+int fpu_stats_report(FILE* out, const char* json_path)
+{
+    std::vector<stats_row> rows;
+    uint64_t               total_ns = 0;
+
+    for (int entry = 0; entry < FPU_STATS_ENTRY_NUM; entry++)
+        for (int op = 0; op < STATS_OP_NUM; op++)
+            for (int fmt = 0; fmt < STATS_FMT_NUM; fmt++)
+            {
+                stats_row r;
+                r.entry = entry;
+                r.op    = op;
+                r.fmt   = fmt;
+                fpu_stats_get(&r.counters, entry, op, fmt);
+                if (r.counters.calls > 0)
+                {
+                    rows.push_back(r);
+                    total_ns += r.counters.total_ns;
+                }
+            }
+    std::sort(rows.begin(), rows.end(), by_total_time);
+
+    if (out != NULL)
+        print_table(out, rows, total_ns);
+
+    if (json_path == NULL || json_path[0] == '\0')
+        return 0;
+
+    FILE* f = fopen(json_path, "w");
+    if (f == NULL)
+    {
+        fprintf(stderr, "fpu_stats: cannot write %s\n", json_path);
+        return -1;
+    }
+    write_json(f, rows, total_ns);
+    fclose(f);
+    return 0;
+}
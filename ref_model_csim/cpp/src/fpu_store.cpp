@@ -0,0 +1,383 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Persistent result store of the reference model, shared by parallel simulations
+ *  History       :
+ */
+
+#include "fpu_store.h"
+#include <gmp.h>
+#include <mpfr.h>
+#include <atomic>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Hash of the sources of the model computed by the Makefile, see fpu_store_model_version. Other builds are stamped with
+// their build time, their files are not shared with any other build.
+#ifndef FPU_MODEL_SOURCE_HASH
+#define FPU_MODEL_SOURCE_HASH "build-" __DATE__ "-" __TIME__
+#endif
+
+#define STORE_MAGIC     0x45524F5453555046ULL // "FPUSTORE"
+#define STORE_VERSION   1
+
+// File header, followed by the buckets
+typedef struct
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t entry_size;
+    uint32_t ways;
+    uint32_t clock;         // insertion counter, orders the entries of a bucket for eviction
+    uint64_t nbuckets;      // power of two
+    uint64_t model_hash;    // hash of the model which created the store, informative only
+    uint8_t  reserved[4096 - 40];
+} store_header;
+
+// Entry of a bucket. seq is a sequence lock : odd while a writer owns the entry.
+// A crashed writer leaves the entry locked, it is then skipped until the store is recreated.
+typedef struct
+{
+    uint32_t seq;
+    uint32_t ctrl;          // key control word, 0 if the entry is empty
+    uint64_t operand_a;
+    uint64_t operand_b;
+    uint64_t imm;
+    uint64_t result;
+    uint64_t model_hash;
+    int32_t  flags;
+    uint32_t stamp;         // value of the clock when the entry was written
+    uint64_t reserved;
+} store_entry;
+
+static_assert(sizeof(store_header) == 4096, "store header must fill a page");
+static_assert(sizeof(store_entry) == 64, "store entries must fill a cache line");
+
+// The store is mapped once and never unmapped : lookups and insertions read store_data without lock, the header and the
+// path are set before it is published
+static store_header*             store_map = NULL;
+static std::string               store_path;
+static std::atomic<store_entry*> store_data(NULL);
+static std::mutex                store_mutex;
+
+static std::atomic<uint64_t> store_hits(0);
+static std::atomic<uint64_t> store_misses(0);
+static std::atomic<uint64_t> store_inserts(0);
+static std::atomic<uint64_t> store_evictions(0);
+
+// Read REFMODEL_STORE when the library is loaded
+static struct store_env_init
+{
+    store_env_init()
+    {
+        const char* path = getenv(FPU_STORE_ENV_VAR);
+        if (path != NULL && path[0] != '\0')
+            fpu_store_open(path, 0);
+    }
+} store_env_init_instance;
+
+static uint64_t fnv1a(uint64_t h, const char* s)
+{
+    for (; *s != '\0'; s++)
+    {
+        h ^= (uint8_t) *s;
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+const char* fpu_store_model_version()
+{
+    return "fpu_exec-" FPU_MODEL_SOURCE_HASH;
+}
+
+uint64_t fpu_store_model_hash()
+{
+    static uint64_t hash = 0;
+    if (hash == 0)
+    {
+        uint64_t h = 0xCBF29CE484222325ULL;
+        h = fnv1a(h, fpu_store_model_version());
+        h = fnv1a(h, mpfr_get_version());
+        h = fnv1a(h, gmp_version);
+        hash = h | 1; // never 0
+    }
+    return hash;
+}
+
+int fpu_shared_file_open(const char* path, bool (*valid)(int fd, void* arg), bool (*init)(int fd, void* arg), void* arg)
+{
+    for (;;)
+    {
+        int fd = open(path, O_RDWR | O_CREAT, 0664);
+        if (fd < 0)
+            return -1;
+
+        // The file lock only serialises the creation of the file
+        flock(fd, LOCK_EX);
+
+        // Replaced by another simulation while waiting for the lock, the new file is opened instead
+        struct stat fd_st, path_st;
+        if (fstat(fd, &fd_st) != 0 || stat(path, &path_st) != 0 ||
+            fd_st.st_dev != path_st.st_dev || fd_st.st_ino != path_st.st_ino)
+        {
+            close(fd);
+            continue;
+        }
+        if (valid(fd, arg))
+            return fd;
+
+        // The new file is locked before it is renamed in place, the simulations waiting for the former one then wait
+        // for its initialisation
+        std::string tmp = std::string(path) + "." + std::to_string(getpid()) + ".tmp";
+        int new_fd = open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0664);
+        if (new_fd < 0 || flock(new_fd, LOCK_EX) != 0 || !init(new_fd, arg) || rename(tmp.c_str(), path) != 0)
+        {
+            if (new_fd >= 0)
+            {
+                close(new_fd);
+                unlink(tmp.c_str());
+            }
+            close(fd);
+            return -1;
+        }
+        close(fd);
+        return new_fd;
+    }
+}
+
+// Header of the store to open, read from the file or written to it
+typedef struct
+{
+    store_header header;
+    uint64_t     nbuckets; // size of a new store
+} store_open_args;
+
+static bool store_valid(int fd, void* arg)
+{
+    store_header& header = ((store_open_args*) arg)->header;
+    struct stat   st;
+    return fstat(fd, &st) == 0 && (size_t) st.st_size >= sizeof(store_header) &&
+           pread(fd, &header, sizeof(header), 0) == (ssize_t) sizeof(header) &&
+           header.magic == STORE_MAGIC && header.version == STORE_VERSION &&
+           header.entry_size == sizeof(store_entry) && header.ways == FPU_STORE_WAYS &&
+           header.nbuckets != 0 && (header.nbuckets & (header.nbuckets - 1)) == 0 &&
+           (uint64_t) st.st_size == sizeof(store_header) + header.nbuckets * FPU_STORE_WAYS * sizeof(store_entry);
+}
+
+static bool store_init(int fd, void* arg)
+{
+    store_open_args* args   = (store_open_args*) arg;
+    store_header&    header = args->header;
+
+    memset(&header, 0, sizeof(header));
+    header.magic      = STORE_MAGIC;
+    header.version    = STORE_VERSION;
+    header.entry_size = sizeof(store_entry);
+    header.ways       = FPU_STORE_WAYS;
+    header.nbuckets   = args->nbuckets;
+    header.model_hash = fpu_store_model_hash();
+
+    // Extending the empty file zero-fills the buckets
+    return ftruncate(fd, sizeof(store_header) + header.nbuckets * FPU_STORE_WAYS * sizeof(store_entry)) == 0 &&
+           pwrite(fd, &header, sizeof(header), 0) == (ssize_t) sizeof(header);
+}
+
+int fpu_store_open(const char* path, uint64_t entries)
+{
+    std::lock_guard<std::mutex> lock(store_mutex);
+
+    if (store_map != NULL)
+    {
+        if (store_path == path)
+            return 0;
+        fprintf(stderr, "fpu_store: %s is already opened, %s is not\n", store_path.c_str(), path);
+        return -1;
+    }
+
+    if (entries == 0)
+    {
+        const char* env_entries = getenv(FPU_STORE_ENTRIES_ENV_VAR);
+        entries = (env_entries != NULL) ? strtoull(env_entries, NULL, 0) : FPU_STORE_DEFAULT_ENTRIES;
+    }
+    store_open_args args;
+    args.nbuckets = 1;
+    while (args.nbuckets * FPU_STORE_WAYS < entries)
+        args.nbuckets <<= 1;
+
+    // Lookups and insertions rely on the sequence locks of the entries
+    int fd = fpu_shared_file_open(path, store_valid, store_init, &args);
+    if (fd < 0)
+    {
+        fprintf(stderr, "fpu_store: cannot open %s\n", path);
+        return -1;
+    }
+
+    size_t size = sizeof(store_header) + args.header.nbuckets * FPU_STORE_WAYS * sizeof(store_entry);
+    void* map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    flock(fd, LOCK_UN);
+    close(fd);
+
+    if (map == MAP_FAILED)
+    {
+        fprintf(stderr, "fpu_store: cannot map %s\n", path);
+        return -1;
+    }
+
+    store_map  = (store_header*) map;
+    store_path = path;
+    store_data.store((store_entry*) ((uint8_t*) map + sizeof(store_header)), std::memory_order_release);
+    return 0;
+}
+
+bool fpu_store_enabled()
+{
+    return store_data.load(std::memory_order_relaxed) != NULL;
+}
+
+static inline store_entry* get_bucket(store_entry* data, const fpu_cache_key* key)
+{
+    uint64_t hash = fpu_cache_key_hash(key);
+    // Upper bits of the hash, the lower ones index the in-process cache
+    return &data[((hash >> 32) & (store_map->nbuckets - 1)) * FPU_STORE_WAYS];
+}
+
+#define LOAD(x)     __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELAXED)
+
+bool fpu_store_lookup(const fpu_cache_key* key, uint64_t* result, int* flags)
+{
+    store_entry* data = store_data.load(std::memory_order_acquire);
+    if (data == NULL)
+        return false;
+
+    store_entry* bucket = get_bucket(data, key);
+    uint64_t model_hash = fpu_store_model_hash();
+
+    for (int way = 0; way < FPU_STORE_WAYS; way++)
+    {
+        store_entry* e = &bucket[way];
+
+        uint32_t seq = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1)
+            continue;
+
+        bool match = LOAD(e->ctrl) == key->ctrl && LOAD(e->operand_a) == key->operand_a &&
+                     LOAD(e->operand_b) == key->operand_b && LOAD(e->imm) == key->imm &&
+                     LOAD(e->model_hash) == model_hash;
+        uint64_t e_result = LOAD(e->result);
+        int      e_flags  = LOAD(e->flags);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (match && __atomic_load_n(&e->seq, __ATOMIC_RELAXED) == seq)
+        {
+            *result = e_result;
+            *flags  = e_flags;
+            store_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    store_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void fpu_store_insert(const fpu_cache_key* key, uint64_t result, int flags)
+{
+    store_entry* data = store_data.load(std::memory_order_acquire);
+    if (data == NULL)
+        return;
+
+    store_entry* bucket = get_bucket(data, key);
+    uint64_t model_hash = fpu_store_model_hash();
+    uint32_t clock      = __atomic_load_n(&store_map->clock, __ATOMIC_RELAXED);
+
+    // Victim : same key, else empty entry, else entry of another model, else oldest entry
+    store_entry* victim = NULL;
+    int          victim_rank = -1;
+    uint32_t     victim_age  = 0;
+
+    for (int way = 0; way < FPU_STORE_WAYS; way++)
+    {
+        store_entry* e = &bucket[way];
+        if (__atomic_load_n(&e->seq, __ATOMIC_RELAXED) & 1)
+            continue;
+
+        int      rank;
+        uint32_t age = clock - LOAD(e->stamp);
+        if (LOAD(e->ctrl) == key->ctrl && LOAD(e->operand_a) == key->operand_a && LOAD(e->operand_b) == key->operand_b &&
+            LOAD(e->imm) == key->imm && LOAD(e->model_hash) == model_hash)
+            rank = 3;
+        else if (LOAD(e->ctrl) == 0)
+            rank = 2;
+        else if (LOAD(e->model_hash) != model_hash)
+            rank = 1;
+        else
+            rank = 0;
+
+        if (rank > victim_rank || (rank == victim_rank && age > victim_age))
+        {
+            victim      = e;
+            victim_rank = rank;
+            victim_age  = age;
+        }
+    }
+
+    // Every entry is being written by another simulation
+    if (victim == NULL || victim_rank == 3)
+        return;
+
+    uint32_t seq = __atomic_load_n(&victim->seq, __ATOMIC_RELAXED);
+    if ((seq & 1) || !__atomic_compare_exchange_n(&victim->seq, &seq, seq + 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        return;
+
+    if (victim_rank < 2)
+        store_evictions.fetch_add(1, std::memory_order_relaxed);
+
+    STORE(victim->ctrl,       key->ctrl);
+    STORE(victim->operand_a,  key->operand_a);
+    STORE(victim->operand_b,  key->operand_b);
+    STORE(victim->imm,        key->imm);
+    STORE(victim->result,     result);
+    STORE(victim->model_hash, model_hash);
+    STORE(victim->flags,      flags);
+    STORE(victim->stamp,      __atomic_fetch_add(&store_map->clock, 1, __ATOMIC_RELAXED));
+
+    __atomic_store_n(&victim->seq, seq + 2, __ATOMIC_RELEASE);
+    store_inserts.fetch_add(1, std::memory_order_relaxed);
+}
+
+void fpu_store_get_stats(fpu_store_stats* stats)
+{
+    stats->hits      = store_hits.load(std::memory_order_relaxed);
+    stats->misses    = store_misses.load(std::memory_order_relaxed);
+    stats->inserts   = store_inserts.load(std::memory_order_relaxed);
+    stats->evictions = store_evictions.load(std::memory_order_relaxed);
+}
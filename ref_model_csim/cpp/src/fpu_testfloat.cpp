@@ -0,0 +1,307 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Reader and writer of test vectors in the text format of Berkeley TestFloat
+ *  History       :
+ */
+
+#include "fpu_testfloat.h"
+#include "fpu_exec.h"
+#include "fpu_util.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+//########## FUNCTIONS #################################################################################################
+
+#define INT_OPERAND 0xFF
+
+// Destination formats, then FP16ALT which is only a source of FCVT_F2F
+static const struct
+{
+    int         fmt;
+    const char* name;
+} float_fmts[] = {
+    { FPU_FMT_FP16, "f16" }, { FPU_FMT_FP32, "f32" }, { FPU_FMT_FP64, "f64" }, { FPU_FMT_FP8, "f8" },
+    { FPU_FMT_FP16ALT, "bf16" },
+};
+
+#define FLOAT_FMT_NUM ((int) (sizeof(float_fmts) / sizeof(float_fmts[0])))
+#define DST_FMT_NUM   4
+
+// Operations of a destination format : name suffix, operation, rm selector, request field of each operand as a string
+// of digits, result width (0 for the width of the format)
+static const struct
+{
+    const char* suffix;
+    int         op;
+    int         rm;
+    const char* fields;
+    int         result_bits;
+} float_ops[] = {
+    { "add",    FPU_OP_FADD,     FPU_TESTFLOAT_RM_FIXED, "12",  0  },
+    { "sub",    FPU_OP_FSUB,     FPU_TESTFLOAT_RM_FIXED, "12",  0  },
+    { "mul",    FPU_OP_FMUL,     FPU_TESTFLOAT_RM_FIXED, "01",  0  },
+    { "div",    FPU_OP_FDIV,     FPU_TESTFLOAT_RM_FIXED, "01",  0  },
+    { "mulAdd", FPU_OP_FMADD,    FPU_TESTFLOAT_RM_FIXED, "012", 0  },
+    { "fmsub",  FPU_OP_FMSUB,    FPU_TESTFLOAT_RM_FIXED, "012", 0  },
+    { "fnmadd", FPU_OP_FNMADD,   FPU_TESTFLOAT_RM_FIXED, "012", 0  },
+    { "fnmsub", FPU_OP_FNMSUB,   FPU_TESTFLOAT_RM_FIXED, "012", 0  },
+    { "sqrt",   FPU_OP_FSQRT,    FPU_TESTFLOAT_RM_FIXED, "0",   0  },
+    { "le",     FPU_OP_FCMP,     0,                      "01",  1  },
+    { "lt",     FPU_OP_FCMP,     1,                      "01",  1  },
+    { "eq",     FPU_OP_FCMP,     2,                      "01",  1  },
+    { "min",    FPU_OP_FMIN_MAX, 0,                      "01",  0  },
+    { "max",    FPU_OP_FMIN_MAX, 1,                      "01",  0  },
+    { "class",  FPU_OP_FCLASS,   0,                      "0",   10 },
+    { "sgnj",   FPU_OP_FSGNJ,    0,                      "01",  0  },
+    { "sgnjn",  FPU_OP_FSGNJ,    1,                      "01",  0  },
+    { "sgnjx",  FPU_OP_FSGNJ,    2,                      "01",  0  },
+};
+
+// Integer formats of the conversions, imm is ~is_signed | int_format << 1
+static const struct
+{
+    const char* name;
+    int         imm;
+    int         bits;
+} int_fmts[] = {
+    { "i32", 0, 32 }, { "ui32", 1, 32 }, { "i64", 2, 64 }, { "ui64", 3, 64 },
+};
+
+static fpu_testfloat_function make_function(const char* src, const char* dst, int op, int fmt, int rm, int imm,
+                                            const char* fields, int operand_fmt, int operand_bits, int result_bits)
+{
+    fpu_testfloat_function f;
+
+    memset(&f, 0, sizeof(f));
+    snprintf(f.name, sizeof(f.name), "%s_%s", src, dst);
+    f.op           = op;
+    f.fmt          = fmt;
+    f.rm           = rm;
+    f.imm          = imm;
+    f.noperands    = strlen(fields);
+    for (int i = 0; i < f.noperands; i++)
+        f.fields[i] = fields[i] - '0';
+    f.operand_fmt  = operand_fmt;
+    f.operand_bits = operand_bits;
+    f.result_bits  = result_bits;
+    return f;
+}
+
+static std::vector<fpu_testfloat_function> build_functions()
+{
+    std::vector<fpu_testfloat_function> functions;
+
+    for (int d = 0; d < DST_FMT_NUM; d++)
+    {
+        int         fmt   = float_fmts[d].fmt;
+        int         width = fpu_fmt_get_desc(fmt)->width;
+        const char* name  = float_fmts[d].name;
+
+        for (size_t k = 0; k < sizeof(float_ops) / sizeof(float_ops[0]); k++)
+            functions.push_back(make_function(name, float_ops[k].suffix, float_ops[k].op, fmt, float_ops[k].rm, 0,
+                                              float_ops[k].fields, fmt, width,
+                                              float_ops[k].result_bits ? float_ops[k].result_bits : width));
+
+        for (size_t k = 0; k < sizeof(int_fmts) / sizeof(int_fmts[0]); k++)
+        {
+            char to_int[16];
+            snprintf(to_int, sizeof(to_int), "to_%s", int_fmts[k].name);
+            functions.push_back(make_function(name, to_int, FPU_OP_FCVT_F2I, fmt, FPU_TESTFLOAT_RM_FIXED,
+                                              int_fmts[k].imm, "0", fmt, width, int_fmts[k].bits));
+        }
+    }
+
+    // Conversions, named <source>_to_<destination>
+    for (int d = 0; d < DST_FMT_NUM; d++)
+    {
+        int  fmt   = float_fmts[d].fmt;
+        int  width = fpu_fmt_get_desc(fmt)->width;
+        char to_dst[16];
+        snprintf(to_dst, sizeof(to_dst), "to_%s", float_fmts[d].name);
+
+        for (size_t k = 0; k < sizeof(int_fmts) / sizeof(int_fmts[0]); k++)
+            functions.push_back(make_function(int_fmts[k].name, to_dst, FPU_OP_FCVT_I2F, fmt, FPU_TESTFLOAT_RM_FIXED,
+                                              int_fmts[k].imm, "0", INT_OPERAND, int_fmts[k].bits, width));
+
+        for (int s = 0; s < FLOAT_FMT_NUM; s++)
+            if (s != d)
+                functions.push_back(make_function(float_fmts[s].name, to_dst, FPU_OP_FCVT_F2F, fmt,
+                                                  FPU_TESTFLOAT_RM_FIXED, float_fmts[s].fmt, "0", float_fmts[s].fmt,
+                                                  fpu_fmt_get_desc(float_fmts[s].fmt)->width, width));
+    }
+    return functions;
+}
+
+const fpu_testfloat_function* fpu_testfloat_functions(int* num)
+{
+    static const std::vector<fpu_testfloat_function> functions = build_functions();
+
+    *num = functions.size();
+    return functions.data();
+}
+
+const fpu_testfloat_function* fpu_testfloat_find(const char* name)
+{
+    int num;
+    const fpu_testfloat_function* functions = fpu_testfloat_functions(&num);
+
+    for (int i = 0; i < num; i++)
+        if (strcmp(functions[i].name, name) == 0)
+            return &functions[i];
+    return NULL;
+}
+
+//########## FLAGS #####################################################################################################
+
+// Bit of each TestFloat flag (inexact, underflow, overflow, infinite, invalid) in the flags of the model
+static const int flag_bits[5] = { 0 /* NX */, 1 /* UF */, 2 /* OF */, 3 /* DZ */, 4 /* NV */ };
+
+int fpu_testfloat_flags_to_model(int flags)
+{
+    int model = 0;
+    for (int i = 0; i < 5; i++)
+        if ((flags >> i) & 1)
+            model |= 1 << flag_bits[i];
+    return model;
+}
+
+int fpu_testfloat_flags_from_model(int flags)
+{
+    int testfloat = 0;
+    for (int i = 0; i < 5; i++)
+        if ((flags >> flag_bits[i]) & 1)
+            testfloat |= 1 << i;
+    return testfloat;
+}
+
+//########## TEXT FORMAT ###############################################################################################
+
+static inline int hex_digit(unsigned char c)
+{
+    unsigned d = c - '0';
+    if (d < 10)
+        return d;
+    d = (c | 0x20) - 'a';
+    return d < 6 ? (int) d + 10 : -1;
+}
+
+// Parse a field of at most 16 digits, preceded by spaces and followed by a separator or the end of the line
+static inline bool parse_field(const char** pp, const char* end, uint64_t* value)
+{
+    const char* p = *pp;
+    while (p < end && (*p == ' ' || *p == '\t'))
+        p++;
+
+    const char* first = p;
+    uint64_t    v = 0;
+    int         d;
+    while (p < end && (d = hex_digit(*p)) >= 0)
+    {
+        v = (v << 4) | d;
+        p++;
+    }
+    if (p == first || p - first > 16 || (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n'))
+        return false;
+
+    *value = v;
+    *pp    = p;
+    return true;
+}
+
+const char* fpu_testfloat_parse(const char* p, const char* end, const fpu_testfloat_function* function,
+                                fpu_testfloat_vector* vector)
+{
+    uint64_t flags;
+
+    for (int i = 0; i < function->noperands; i++)
+    {
+        if (!parse_field(&p, end, &vector->operands[i]))
+            return NULL;
+        vector->operands[i] &= fpu_low_mask(function->operand_bits);
+    }
+    for (int i = function->noperands; i < 3; i++)
+        vector->operands[i] = 0;
+
+    if (!parse_field(&p, end, &vector->result) || !parse_field(&p, end, &flags) || flags > 0x1F)
+        return NULL;
+    vector->result &= fpu_low_mask(function->result_bits);
+    vector->flags   = fpu_testfloat_flags_to_model(flags);
+
+    while (p < end && (*p == ' ' || *p == '\t'))
+        p++;
+    if (p < end && *p == '\r')
+        p++;
+    if (p == end)
+        return p;
+    return *p == '\n' ? p + 1 : NULL;
+}
+
+static inline char* format_field(char* out, uint64_t value, int digits)
+{
+    static const char hex[] = "0123456789ABCDEF";
+
+    for (int i = digits - 1; i >= 0; i--, value >>= 4)
+        out[i] = hex[value & 0xF];
+    out[digits] = ' ';
+    return out + digits + 1;
+}
+
+char* fpu_testfloat_format(char* out, const fpu_testfloat_function* function, const fpu_testfloat_vector* vector)
+{
+    for (int i = 0; i < function->noperands; i++)
+        out = format_field(out, vector->operands[i], (function->operand_bits + 3) / 4);
+    out = format_field(out, vector->result, (function->result_bits + 3) / 4);
+    out = format_field(out, fpu_testfloat_flags_from_model(vector->flags), 2);
+    out[-1] = '\n';
+    return out;
+}
+
+//########## EXECUTION #################################################################################################
+
+int fpu_testfloat_exec(const fpu_testfloat_function* function, int rm, fpu_testfloat_vector* vector)
+{
+    uint64_t fields[3] = { 0, 0, function->imm };
+    uint64_t result;
+    int      flags;
+
+    if (rm < 0 || rm >= FPU_RM_NUM)
+        return -1;
+
+    // Floating point operands are NaN-boxed, the conversions from integers read the low bits of operand_a
+    for (int i = 0; i < function->noperands; i++)
+    {
+        uint64_t mask = fpu_low_mask(function->operand_bits);
+        fields[function->fields[i]] = function->operand_fmt == INT_OPERAND ? vector->operands[i] & mask
+                                                                            : vector->operands[i] | ~mask;
+    }
+
+    flags = fpu_exec_compute(&result, function->op, fields[0], fields[1], fields[2], function->fmt,
+                             function->rm != FPU_TESTFLOAT_RM_FIXED ? function->rm : rm, 64, 64);
+
+    if (flags < 0)
+        return -1;
+    vector->result = result & fpu_low_mask(function->result_bits);
+    vector->flags  = flags;
+    return 0;
+}
@@ -0,0 +1,272 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Binary trace recorder of the DPI calls
+ *  History       :
+ */
+
+#include "fpu_trace.h"
+#include "fpu_store.h"
+#include "fpu_util.h"
+#include <gmp.h>
+#include <mpfr.h>
+#include <mutex>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Block of a thread, the block header is kept in front of the records so that a block is written by one call
+typedef struct
+{
+    fpu_trace_block  header;
+    fpu_trace_record records[FPU_TRACE_BLOCK_RECORDS];
+} trace_buffer;
+
+std::atomic<bool> fpu_trace_on(false);
+
+static int        trace_fd       = -1;
+static bool       trace_compress = false;
+static std::mutex trace_mutex;  // file, and list of the blocks
+
+// Blocks of the running threads, written by fpu_trace_close
+static std::vector<trace_buffer*> buffers;
+static uint32_t                   nthreads = 0;
+
+static thread_local uint64_t context_trans_id = 0;
+static thread_local uint64_t context_sim_time = 0;
+
+static void write_buffer(trace_buffer* b);
+
+// Block of the calling thread, written when the thread exits
+static thread_local struct trace_thread
+{
+    trace_buffer* buffer;
+
+    ~trace_thread()
+    {
+        if (buffer == NULL)
+            return;
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        write_buffer(buffer);
+        for (size_t i = 0; i < buffers.size(); i++)
+            if (buffers[i] == buffer)
+            {
+                buffers.erase(buffers.begin() + i);
+                break;
+            }
+        delete buffer;
+    }
+} local_thread = { NULL };
+
+// Read REFMODEL_TRACE when the library is loaded, close the trace at exit
+static struct trace_env_init
+{
+    trace_env_init()
+    {
+        const char* path     = getenv(FPU_TRACE_ENV_VAR);
+        const char* compress = getenv(FPU_TRACE_COMPRESS_ENV_VAR);
+        if (path != NULL && path[0] != '\0')
+            fpu_trace_open(path, compress != NULL && compress[0] != '\0' && strcmp(compress, "0") != 0);
+    }
+
+    ~trace_env_init()
+    {
+        fpu_trace_close();
+    }
+} trace_env_init_instance;
+
+// Write the records of a block and empty it, trace_mutex must be held
+static void write_buffer(trace_buffer* b)
+{
+    if (b->header.nrecords == 0)
+        return;
+
+    if (trace_fd >= 0)
+    {
+        bool ok;
+        if (trace_compress)
+        {
+            std::vector<uint8_t> out(sizeof(fpu_trace_block) + b->header.nrecords * (sizeof(fpu_trace_record) + 8));
+            fpu_trace_block* header = (fpu_trace_block*) &out[0];
+            *header        = b->header;
+            header->nbytes = fpu_trace_encode(&out[sizeof(fpu_trace_block)], b->records, b->header.nrecords);
+            ok = fpu_write_all(trace_fd, &out[0], sizeof(fpu_trace_block) + header->nbytes);
+        }
+        else
+        {
+            b->header.nbytes = b->header.nrecords * sizeof(fpu_trace_record);
+            ok = fpu_write_all(trace_fd, b, sizeof(fpu_trace_block) + b->header.nbytes);
+        }
+        if (!ok)
+        {
+            fprintf(stderr, "fpu_trace: write error, recording stopped\n");
+            fpu_trace_on.store(false);
+            close(trace_fd);
+            trace_fd = -1;
+        }
+    }
+    b->header.nrecords = 0;
+}
+
+int fpu_trace_open(const char* path, bool compress)
+{
+    fpu_trace_close();
+
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    if (fd < 0)
+    {
+        fprintf(stderr, "fpu_trace: cannot open %s\n", path);
+        return -1;
+    }
+
+    fpu_trace_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic         = FPU_TRACE_MAGIC;
+    header.version       = FPU_TRACE_VERSION;
+    header.record_size   = sizeof(fpu_trace_record);
+    header.flags         = compress ? FPU_TRACE_COMPRESSED : 0;
+    header.block_records = FPU_TRACE_BLOCK_RECORDS;
+    header.model_hash    = fpu_store_model_hash();
+    snprintf(header.model, sizeof(header.model), "%s", fpu_store_model_version());
+    snprintf(header.mpfr, sizeof(header.mpfr), "%s", mpfr_get_version());
+    snprintf(header.gmp, sizeof(header.gmp), "%s", gmp_version);
+    snprintf(header.build, sizeof(header.build), "gcc %s, %s %s", __VERSION__, __DATE__, __TIME__);
+
+    if (!fpu_write_all(fd, &header, sizeof(header)))
+    {
+        fprintf(stderr, "fpu_trace: cannot write %s\n", path);
+        close(fd);
+        return -1;
+    }
+
+    trace_fd       = fd;
+    trace_compress = compress;
+    fpu_trace_on.store(true);
+    return 0;
+}
+
+void fpu_trace_close()
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    fpu_trace_on.store(false);
+    for (size_t i = 0; i < buffers.size(); i++)
+        write_buffer(buffers[i]);
+    if (trace_fd >= 0)
+        close(trace_fd);
+    trace_fd = -1;
+}
+
+void fpu_trace_set_context(uint64_t trans_id, uint64_t sim_time)
+{
+    context_trans_id = trans_id;
+    context_sim_time = sim_time;
+}
+
+void fpu_trace_write(const fpu_trace_record* record)
+{
+    trace_buffer* b = local_thread.buffer;
+    if (b == NULL)
+    {
+        b = new trace_buffer;
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        memset(&b->header, 0, sizeof(b->header));
+        b->header.thread = nthreads++;
+        buffers.push_back(b);
+        local_thread.buffer = b;
+    }
+    else if (b->header.nrecords == FPU_TRACE_BLOCK_RECORDS)
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        write_buffer(b);
+    }
+
+    fpu_trace_record* r = &b->records[b->header.nrecords++];
+    *r          = *record;
+    r->trans_id = context_trans_id;
+    r->sim_time = context_sim_time;
+    r->thread   = b->header.thread;
+}
+
+//########## BLOCK ENCODING ############################################################################################
+
+// Each record is XORed with the previous one of the block, then each of its 8 words is written as a mask of its
+// non-zero bytes followed by these bytes
+
+uint32_t fpu_trace_encode(uint8_t* out, const fpu_trace_record* records, uint32_t nrecords)
+{
+    uint64_t prev[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    uint8_t* p       = out;
+
+    for (uint32_t i = 0; i < nrecords; i++)
+    {
+        uint64_t words[8];
+        memcpy(words, &records[i], sizeof(words));
+        for (int w = 0; w < 8; w++)
+        {
+            uint64_t x    = words[w] ^ prev[w];
+            uint8_t* mask = p++;
+            *mask = 0;
+            for (int k = 0; x != 0; k++, x >>= 8)
+                if (x & 0xFF)
+                {
+                    *mask |= 1 << k;
+                    *p++   = x & 0xFF;
+                }
+            prev[w] = words[w];
+        }
+    }
+    return (uint32_t) (p - out);
+}
+
+int fpu_trace_decode(fpu_trace_record* records, uint32_t nrecords, const uint8_t* in, uint32_t nbytes)
+{
+    uint64_t       prev[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    const uint8_t* p       = in;
+    const uint8_t* end     = in + nbytes;
+
+    for (uint32_t i = 0; i < nrecords; i++)
+    {
+        for (int w = 0; w < 8; w++)
+        {
+            if (p >= end)
+                return -1;
+            uint8_t  mask = *p++;
+            uint64_t x    = 0;
+            for (int k = 0; k < 8; k++)
+                if (mask & (1 << k))
+                {
+                    if (p >= end)
+                        return -1;
+                    x |= (uint64_t) *p++ << (8 * k);
+                }
+            prev[w] ^= x;
+        }
+        memcpy(&records[i], prev, sizeof(prev));
+    }
+    return 0;
+}
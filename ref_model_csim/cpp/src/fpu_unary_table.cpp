@@ -0,0 +1,422 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Tables of the unary operations on the 16-bits and 8-bits formats
+ *  History       :
+ */
+
+#include "fpu_unary_table.h"
+#include "fpu_store.h"
+#include "operations.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define TABLE_MAGIC     0x5952414E55555046ULL // "FPUUNARY"
+#define TABLE_VERSION   2
+
+#define SLICE_NUM       (UNARY_SRC_NUM * UNARY_KIND_NUM * FPU_UNARY_TABLE_RM_NUM)
+
+// File header, followed by the supported tables in index order, results then flags
+typedef struct
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t nslices;
+    uint64_t model_hash;
+} unary_table_header;
+
+// Table of one operation, source format and rounding mode, allocated when built
+typedef struct
+{
+    std::atomic<bool> ready;
+    uint64_t*         results;
+    uint8_t*          flags;
+} table_slice;
+
+static const int src_fmts[UNARY_SRC_NUM]  = { FPU_FMT_FP16, FPU_FMT_FP16ALT, FPU_FMT_FP8 };
+static const int f2f_fmts[UNARY_F2I32 - UNARY_F2F_FP32] = { FPU_FMT_FP32, FPU_FMT_FP64, FPU_FMT_FP16, FPU_FMT_FP8, FPU_FMT_FP16ALT };
+
+static const char* kind_names[UNARY_KIND_NUM] = {
+    "SQRT", "FCLASS", "F2F_FP32", "F2F_FP64", "F2F_FP16", "F2F_FP8", "F2F_FP16ALT", "F2I32", "F2U32", "F2I64", "F2U64"
+};
+static const char* rm_names[FPU_UNARY_TABLE_RM_NUM] = { "RNE", "RTZ", "RDN", "RUP" };
+
+static table_slice      slices[SLICE_NUM];
+static std::mutex       table_mutex;
+static std::atomic<int> table_mode(UNARY_TABLE_LAZY);
+static std::once_flag   background_once;
+
+// Thread of the background mode, stopped between two tables and joined when the library is unloaded, before the
+// tables and MPFR are torn down
+static struct unary_table_background
+{
+    std::thread       thread;
+    std::atomic<bool> stop;
+
+    unary_table_background() : stop(false) {}
+    ~unary_table_background()
+    {
+        stop.store(true, std::memory_order_relaxed);
+        if (thread.joinable())
+            thread.join();
+    }
+} background;
+
+// Read REFMODEL_UNARY_TABLES_FILE and REFMODEL_UNARY_TABLES when the library is loaded
+static struct unary_table_env_init
+{
+    unary_table_env_init()
+    {
+        const char* path = getenv(FPU_UNARY_TABLE_FILE_ENV_VAR);
+        if (path != NULL && path[0] != '\0')
+            fpu_unary_table_load(path);
+
+        const char* mode = getenv(FPU_UNARY_TABLE_ENV_VAR);
+        if (mode == NULL || mode[0] == '\0' || strcmp(mode, "lazy") == 0)
+            return;
+        if (strcmp(mode, "off") == 0 || strcmp(mode, "0") == 0)
+            fpu_unary_table_set_mode(UNARY_TABLE_OFF);
+        else if (strcmp(mode, "background") == 0)
+            fpu_unary_table_set_mode(UNARY_TABLE_BACKGROUND);
+        else
+            fprintf(stderr, "fpu_unary_table: unknown mode %s, tables are built on first use\n", mode);
+    }
+} unary_table_env_init_instance;
+
+static inline int input_num(int src)
+{
+    return (src == UNARY_SRC_FP8) ? (1 << 8) : (1 << 16);
+}
+
+static inline int slice_index(int src, int kind, int rm)
+{
+    if (kind == UNARY_FCLASS)
+        rm = 0;
+    return (src * UNARY_KIND_NUM + kind) * FPU_UNARY_TABLE_RM_NUM + rm;
+}
+
+const char* fpu_unary_table_name(int src, int kind, int rm)
+{
+    static char names[SLICE_NUM][32];
+    static std::once_flag names_once;
+
+    if (src < 0 || src >= UNARY_SRC_NUM || kind < 0 || kind >= UNARY_KIND_NUM || rm < 0 || rm >= FPU_UNARY_TABLE_RM_NUM)
+        return "?";
+
+    std::call_once(names_once, []() {
+        for (int s = 0; s < UNARY_SRC_NUM; s++)
+            for (int k = 0; k < UNARY_KIND_NUM; k++)
+                for (int r = 0; r < FPU_UNARY_TABLE_RM_NUM; r++)
+                    snprintf(names[slice_index(s, k, r)], sizeof(names[0]), "%s.%s%s%s", fpu_fmt_name(src_fmts[s]),
+                             kind_names[k], (k == UNARY_FCLASS) ? "" : ".", (k == UNARY_FCLASS) ? "" : rm_names[r]);
+    });
+    return names[slice_index(src, kind, rm)];
+}
+
+int fpu_unary_table_src(int fmt)
+{
+    for (int src = 0; src < UNARY_SRC_NUM; src++)
+    {
+        if (src_fmts[src] == fmt)
+            return src;
+    }
+    return -1;
+}
+
+bool fpu_unary_table_supported(int src, int kind, int rm)
+{
+    if (src < 0 || src >= UNARY_SRC_NUM || kind < 0 || kind >= UNARY_KIND_NUM || rm < 0 || rm >= FPU_UNARY_TABLE_RM_NUM)
+        return false;
+    return kind < UNARY_F2F_FP32 || kind >= UNARY_F2I32 || f2f_fmts[kind - UNARY_F2F_FP32] != src_fmts[src];
+}
+
+//########## COMPUTATION ###############################################################################################
+
+int fpu_unary_table_compute(uint64_t* result, int src, int kind, int rm, uint32_t input)
+{
+    environment env = fpu_fmt_get_desc(src_fmts[src])->env;
+    mpfr_rnd_t  rnd = rnd_rtl_to_c(rm);
+    uint32_t op[2]  = { input, 0 };
+    uint32_t res[2] = { 0, 0 };
+    int flags;
+
+    switch (kind)
+    {
+    case UNARY_SQRT:
+        flags = sqrt(res, op, rnd, env);
+        break;
+    case UNARY_FCLASS:
+        flags = fclass(res, op, env);
+        break;
+    case UNARY_F2I32:
+    case UNARY_F2U32:
+        flags = fcvt_f2i32(res, op, kind == UNARY_F2I32, rnd, env);
+        break;
+    case UNARY_F2I64:
+    case UNARY_F2U64:
+        flags = fcvt_f2i64(res, op, kind == UNARY_F2I64, rnd, env);
+        break;
+    default:
+        flags = fcvt_f2f(res, op, rnd, env, fpu_fmt_get_desc(f2f_fmts[kind - UNARY_F2F_FP32])->env);
+        break;
+    }
+
+    *result = ((uint64_t) res[1] << 32) | res[0];
+    return flags;
+}
+
+// Build a table, table_mutex must be held
+static void build(int src, int kind, int rm)
+{
+    table_slice* slice = &slices[slice_index(src, kind, rm)];
+    if (slice->ready.load(std::memory_order_relaxed))
+        return;
+
+    int n = input_num(src);
+    uint64_t* results = new uint64_t[n];
+    uint8_t*  flags   = new uint8_t[n];
+    for (int i = 0; i < n; i++)
+        flags[i] = fpu_unary_table_compute(&results[i], src, kind, rm, i);
+
+    slice->results = results;
+    slice->flags   = flags;
+    slice->ready.store(true, std::memory_order_release);
+}
+
+// Build every table, until the background thread is stopped
+static void build_all(const std::atomic<bool>* stop)
+{
+    for (int src = 0; src < UNARY_SRC_NUM; src++)
+        for (int kind = 0; kind < UNARY_KIND_NUM; kind++)
+            for (int rm = 0; rm < FPU_UNARY_TABLE_RM_NUM; rm++)
+            {
+                if (!fpu_unary_table_supported(src, kind, rm) || (kind == UNARY_FCLASS && rm != 0))
+                    continue;
+                if (stop != NULL && stop->load(std::memory_order_relaxed))
+                    return;
+                // Released between tables so that a load or a lazy build is not blocked for the whole build
+                std::lock_guard<std::mutex> lock(table_mutex);
+                build(src, kind, rm);
+            }
+}
+
+void fpu_unary_table_build_all()
+{
+    build_all(NULL);
+}
+
+bool fpu_unary_table_lookup(uint64_t* result, int* flags, int src, int kind, int rm, uint32_t input)
+{
+    int mode = table_mode.load(std::memory_order_relaxed);
+    if (mode == UNARY_TABLE_OFF || !fpu_unary_table_supported(src, kind, rm))
+        return false;
+
+    table_slice* slice = &slices[slice_index(src, kind, rm)];
+    if (!slice->ready.load(std::memory_order_acquire))
+    {
+        if (mode != UNARY_TABLE_LAZY)
+            return false;
+        std::lock_guard<std::mutex> lock(table_mutex);
+        build(src, kind, rm);
+    }
+
+    int i = input & (input_num(src) - 1);
+    *result = slice->results[i];
+    *flags  = slice->flags[i];
+    return true;
+}
+
+//########## MODE ######################################################################################################
+
+void fpu_unary_table_set_mode(int mode)
+{
+    if (mode == UNARY_TABLE_BACKGROUND && !mpfr_buildopt_tls_p())
+    {
+        fprintf(stderr, "fpu_unary_table: MPFR is not thread-safe, tables are built on first use\n");
+        mode = UNARY_TABLE_LAZY;
+    }
+    table_mode.store(mode, std::memory_order_relaxed);
+
+    if (mode == UNARY_TABLE_BACKGROUND)
+        std::call_once(background_once, []() { background.thread = std::thread(build_all, &background.stop); });
+}
+
+int fpu_unary_table_get_mode()
+{
+    return table_mode.load(std::memory_order_relaxed);
+}
+
+//########## FILE ######################################################################################################
+
+int fpu_unary_table_load(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "fpu_unary_table: cannot open %s\n", path);
+        return -1;
+    }
+
+    unary_table_header header;
+    bool valid = fread(&header, sizeof(header), 1, file) == 1 && header.magic == TABLE_MAGIC &&
+                 header.version == TABLE_VERSION && header.nslices == SLICE_NUM &&
+                 header.model_hash == fpu_store_model_hash();
+
+    std::lock_guard<std::mutex> lock(table_mutex);
+    for (int index = 0; valid && index < SLICE_NUM; index++)
+    {
+        int src  = index / (UNARY_KIND_NUM * FPU_UNARY_TABLE_RM_NUM);
+        int kind = (index / FPU_UNARY_TABLE_RM_NUM) % UNARY_KIND_NUM;
+        int rm   = index % FPU_UNARY_TABLE_RM_NUM;
+        if (!fpu_unary_table_supported(src, kind, rm) || slice_index(src, kind, rm) != index)
+            continue;
+
+        int n = input_num(src);
+        uint64_t* results = new uint64_t[n];
+        uint8_t*  flags   = new uint8_t[n];
+        valid = fread(results, sizeof(uint64_t), n, file) == (size_t) n && fread(flags, sizeof(uint8_t), n, file) == (size_t) n;
+
+        table_slice* slice = &slices[index];
+        if (valid && !slice->ready.load(std::memory_order_relaxed))
+        {
+            slice->results = results;
+            slice->flags   = flags;
+            slice->ready.store(true, std::memory_order_release);
+        }
+        else
+        {
+            delete[] results;
+            delete[] flags;
+        }
+    }
+    fclose(file);
+
+    // Tables read before an error are kept, they are complete
+    if (!valid)
+    {
+        fprintf(stderr, "fpu_unary_table: %s is not a table file of this model, tables are built by the model\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+int fpu_unary_table_save(const char* path)
+{
+    fpu_unary_table_build_all();
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "fpu_unary_table: cannot create %s\n", path);
+        return -1;
+    }
+
+    unary_table_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic      = TABLE_MAGIC;
+    header.version    = TABLE_VERSION;
+    header.nslices    = SLICE_NUM;
+    header.model_hash = fpu_store_model_hash();
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (int index = 0; ok && index < SLICE_NUM; index++)
+    {
+        int src  = index / (UNARY_KIND_NUM * FPU_UNARY_TABLE_RM_NUM);
+        int kind = (index / FPU_UNARY_TABLE_RM_NUM) % UNARY_KIND_NUM;
+        int rm   = index % FPU_UNARY_TABLE_RM_NUM;
+        if (!fpu_unary_table_supported(src, kind, rm) || slice_index(src, kind, rm) != index)
+            continue;
+
+        int n = input_num(src);
+        ok = fwrite(slices[index].results, sizeof(uint64_t), n, file) == (size_t) n &&
+             fwrite(slices[index].flags, sizeof(uint8_t), n, file) == (size_t) n;
+    }
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok)
+    {
+        fprintf(stderr, "fpu_unary_table: cannot write %s\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+//########## HANDLERS ##################################################################################################
+
+static inline bool table_lookup(uint32_t* result, int* flags, environment env, int kind, int rm, uint32_t input)
+{
+    uint64_t r;
+    int src = fpu_unary_table_src(fpu_fmt_from_env(env));
+    if (src < 0 || !fpu_unary_table_lookup(&r, flags, src, kind, rm, input))
+        return false;
+    result[0] = r & 0xFFFFFFFF;
+    result[1] = r >> 32;
+    return true;
+}
+
+int fpu_unary_exec_fsqrt(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    int flags;
+    if (table_lookup(result, &flags, ctx->dst_env, UNARY_SQRT, ctx->rm, op1[0]))
+        return flags;
+    return sqrt(result, op1, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+int fpu_unary_exec_fclass(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    int flags;
+    if (table_lookup(result, &flags, ctx->dst_env, UNARY_FCLASS, 0, op1[0]))
+        return flags;
+    return fclass(result, op1, ctx->dst_env);
+}
+
+int fpu_unary_exec_fcvt_f2i(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    int flags;
+    int kind = (ctx->int_format == 1) ? (ctx->is_signed ? UNARY_F2I64 : UNARY_F2U64) : (ctx->is_signed ? UNARY_F2I32 : UNARY_F2U32);
+    if (table_lookup(result, &flags, ctx->dst_env, kind, ctx->rm, op1[0]))
+        return flags;
+    if (ctx->int_format == 1) // INT64
+        return fcvt_f2i64(result, op1, ctx->is_signed, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+    return fcvt_f2i32(result, op1, ctx->is_signed, rnd_rtl_to_c(ctx->rm), ctx->dst_env);
+}
+
+// The source format selects the table, the destination format the operation
+int fpu_unary_exec_fcvt_f2f(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32_t* op3, const fpu_exec_ctx* ctx)
+{
+    int flags;
+    int dst = fpu_fmt_from_env(ctx->dst_env);
+    for (int kind = UNARY_F2F_FP32; kind < UNARY_F2I32; kind++)
+    {
+        if (f2f_fmts[kind - UNARY_F2F_FP32] == dst)
+        {
+            if (table_lookup(result, &flags, ctx->src_env, kind, ctx->rm, op1[0]))
+                return flags;
+            break;
+        }
+    }
+    return fcvt_f2f(result, op1, rnd_rtl_to_c(ctx->rm), ctx->src_env, ctx->dst_env);
+}
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Helpers shared by the library and the tools
+ *  History       :
+ */
+
+#include "fpu_util.h"
+#include <gmp.h>
+#include <mpfr.h>
+#include <cstdio>
+#include <cstdlib>
+#include <strings.h>
+#include <unistd.h>
+
+bool fpu_write_all(int fd, const void* data, size_t size)
+{
+    const uint8_t* p = (const uint8_t*) data;
+    while (size > 0)
+    {
+        ssize_t n = write(fd, p, size);
+        if (n <= 0)
+            return false;
+        p    += n;
+        size -= n;
+    }
+    return true;
+}
+
+int fpu_mpfr_threads(int threads)
+{
+    if (!mpfr_buildopt_tls_p() && threads > 1)
+    {
+        fprintf(stderr, "MPFR is not thread-safe, running on one thread\n");
+        return 1;
+    }
+    return threads;
+}
+
+int fpu_parse_code(const char* s, const char* (*name_of)(int), int num)
+{
+    char* end;
+    long code = strtol(s, &end, 10);
+    if (*s != '\0' && *end == '\0')
+        return (code >= 0 && code < num) ? (int) code : -1;
+
+    for (int k = 0; k < num; k++)
+    {
+        const char* name = name_of(k);
+        if (name != NULL && strcasecmp(s, name) == 0)
+            return k;
+    }
+    return -1;
+}
+
+void fpu_progress_init(fpu_progress* progress, long interval)
+{
+    progress->start    = std::chrono::steady_clock::now();
+    progress->last     = 0;
+    progress->interval = interval;
+}
+
+double fpu_progress_elapsed(const fpu_progress* progress)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - progress->start).count();
+}
+
+void fpu_progress_report(fpu_progress* progress, uint64_t done, uint64_t total, const char* unit)
+{
+    double elapsed = fpu_progress_elapsed(progress);
+    if (progress->interval <= 0 || elapsed - progress->last < progress->interval)
+        return;
+
+    double rate = done / elapsed;
+    printf("  %.1f%%, %.2f M%s/s, %.0f s left\n", total > 0 ? 100.0 * done / total : 100.0, rate / 1e6, unit,
+           rate > 0 ? (total - done) / rate : 0.0);
+    fflush(stdout);
+    progress->last = elapsed;
+}
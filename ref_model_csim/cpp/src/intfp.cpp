@@ -0,0 +1,621 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Integer implementation of the arithmetic operations, for formats up to 32 bits
+ *  History       :
+ */
+
+#include "intfp.h"
+
+typedef unsigned __int128 uint128_t;
+
+#define FLAG_NX 0x01
+#define FLAG_UF 0x02
+#define FLAG_OF 0x04
+#define FLAG_DZ 0x08
+#define FLAG_NV 0x10
+
+#define RM_RNE 0
+#define RM_RTZ 1
+#define RM_RDN 2
+#define RM_RUP 3
+#define RM_RMM 4
+
+//########## FORMAT ####################################################################################################
+
+typedef struct
+{
+    int      t;         // explicit significand bits
+    int      bias;
+    int      emin;      // exponent of the smallest normal number
+    int      emax;
+    uint64_t e_max;     // E field of infinities and NaNs
+} fmt_params;
+
+static inline fmt_params get_params(environment env)
+{
+    fmt_params f;
+    f.t     = MBITS(env);
+    f.bias  = (1 << env.es) - 1;
+    f.emin  = 1 - f.bias;
+    f.emax  = f.bias;
+    f.e_max = (1ULL << (env.es + 1)) - 1;
+    return f;
+}
+
+bool intfp_supported(environment env)
+{
+    return env.bis <= INTFP_MAX_BIS && env.es >= 1 && MBITS(env) >= 1;
+}
+
+//########## UNPACKED VALUES ###########################################################################################
+
+enum { CLS_ZERO, CLS_NUM, CLS_INF, CLS_QNAN, CLS_SNAN };
+
+// Value of a number : (-1)^sign * sig * 2^exp
+typedef struct
+{
+    int      cls;
+    bool     sign;
+    int      exp;
+    uint64_t sig;
+} unpacked;
+
+static inline unpacked unpack(uint64_t x, const fmt_params* f)
+{
+    unpacked u;
+    uint64_t T = x & ((1ULL << f->t) - 1);
+    uint64_t E = (x >> f->t) & f->e_max;
+
+    u.sign = (x >> (f->t + (64 - __builtin_clzll(f->e_max)))) & 1;
+    u.exp  = 0;
+    u.sig  = 0;
+
+    if (E == f->e_max)
+        u.cls = (T == 0) ? CLS_INF : ((T >> (f->t - 1)) ? CLS_QNAN : CLS_SNAN);
+    else if (E == 0 && T == 0)
+        u.cls = CLS_ZERO;
+    else
+    {
+        u.cls = CLS_NUM;
+        u.sig = (E == 0) ? T : (T | (1ULL << f->t));
+        u.exp = ((E == 0) ? f->emin : (int) E - f->bias) - f->t;
+    }
+    return u;
+}
+
+static inline bool is_nan(const unpacked* u)
+{
+    return u->cls == CLS_QNAN || u->cls == CLS_SNAN;
+}
+
+static inline int msb_index(uint128_t x)
+{
+    uint64_t hi = (uint64_t) (x >> 64);
+    return hi ? 127 - __builtin_clzll(hi) : 63 - __builtin_clzll((uint64_t) x);
+}
+
+//########## ENCODING ##################################################################################################
+
+static inline uint64_t pack(bool sign, uint64_t E, uint64_t T, const fmt_params* f)
+{
+    int es = 64 - __builtin_clzll(f->e_max);
+    return ((uint64_t) sign << (f->t + es)) | (E << f->t) | T;
+}
+
+static inline uint64_t canonical_nan(const fmt_params* f)
+{
+    return pack(false, f->e_max, 1ULL << (f->t - 1), f);
+}
+
+static inline uint64_t inf(bool sign, const fmt_params* f)
+{
+    return pack(sign, f->e_max, 0, f);
+}
+
+static inline uint64_t zero(bool sign, const fmt_params* f)
+{
+    return pack(sign, 0, 0, f);
+}
+
+// Increment of the truncated significand, regarding the rounding mode
+static inline bool round_increment(int rm, bool sign, bool lsb, bool guard, bool rest)
+{
+    switch (rm)
+    {
+    case RM_RNE: return guard && (rest || lsb);
+    case RM_RDN: return sign && (guard || rest);
+    case RM_RUP: return !sign && (guard || rest);
+    case RM_RMM: return guard;
+    default:     return false;
+    }
+}
+
+// Split sig at bit position shift : returns sig >> shift, the guard bit and the OR of the bits below
+static inline uint128_t split(uint128_t sig, int shift, bool* guard, bool* rest)
+{
+    if (shift <= 0)
+    {
+        *guard = false;
+        *rest  = false;
+        return sig << -shift;
+    }
+    if (shift > 128)
+    {
+        *guard = false;
+        *rest  = sig != 0;
+        return 0;
+    }
+    *guard = (sig >> (shift - 1)) & 1;
+    *rest  = (shift > 1) && (sig & ((((uint128_t) 1) << (shift - 1)) - 1)) != 0;
+    return (shift == 128) ? 0 : sig >> shift;
+}
+
+/**
+ * Round (-1)^sign * (sig + sticky) * 2^exp to the format, sig not null. sticky stands for a non-null value below the
+ * least significant bit of sig, it is only used when sig is wider than the significand.
+ * Tininess is detected after rounding, as MPFR does : the result is tiny if rounding to the precision with an
+ * unbounded exponent range gives a value below the smallest normal number.
+ */
+static uint64_t round_pack(bool sign, uint128_t sig, int exp, bool sticky, int rm, const fmt_params* f, int* flags)
+{
+    int E   = exp + msb_index(sig);
+    int lsb = ((E < f->emin) ? f->emin : E) - f->t;
+
+    bool guard, rest;
+    uint128_t q = split(sig, lsb - exp, &guard, &rest);
+    rest |= sticky;
+
+    bool inexact = guard || rest;
+    q += round_increment(rm, sign, q & 1, guard, rest);
+
+    bool tiny = false;
+    if (E < f->emin)
+    {
+        tiny = true;
+        if (E == f->emin - 1)
+        {
+            // Only a carry out of the unbounded rounding reaches the smallest normal number
+            bool ug, ur;
+            uint128_t uq = split(sig, E - f->t - exp, &ug, &ur);
+            ur |= sticky;
+            uq += round_increment(rm, sign, uq & 1, ug, ur);
+            tiny = (uq >> (f->t + 1)) == 0;
+        }
+    }
+
+    if (inexact)
+        *flags |= FLAG_NX;
+    if (tiny && inexact)
+        *flags |= FLAG_UF;
+
+    if (q == 0)
+        return zero(sign, f);
+
+    if (q >> (f->t + 1))
+    {
+        q >>= 1;
+        lsb++;
+    }
+
+    int Er = lsb + msb_index(q);
+    if (Er > f->emax)
+    {
+        *flags |= FLAG_OF | FLAG_NX;
+        bool to_max = rm == RM_RTZ || (rm == RM_RDN && !sign) || (rm == RM_RUP && sign);
+        return to_max ? pack(sign, f->e_max - 1, (1ULL << f->t) - 1, f) : inf(sign, f);
+    }
+
+    uint64_t T = (uint64_t) q & ((1ULL << f->t) - 1);
+    uint64_t Eb = (q >> f->t) ? (uint64_t) (Er + f->bias) : 0;
+    return pack(sign, Eb, T, f);
+}
+
+int intfp_round(uint64_t* result, bool sign, uint64_t sig, int exp, int rm, environment env)
+{
+    fmt_params f = get_params(env);
+    int flags = 0;
+    *result = round_pack(sign, sig, exp, false, rm, &f, &flags);
+    return flags;
+}
+
+// Sign of an exact zero sum of operands of opposite signs
+static inline bool zero_sum_sign(int rm)
+{
+    return rm == RM_RDN;
+}
+
+//########## EXACT SUM #################################################################################################
+
+#define SUM_WINDOW 100  // the operands are aligned on 2^(top-SUM_WINDOW), where top is the upper bound of both of them
+
+// Align sig * 2^exp on 2^e0, the shifted out bits are kept as a sticky bit
+static inline uint128_t align(uint128_t sig, int exp, int e0)
+{
+    if (exp >= e0)
+        return sig << (exp - e0);
+    int shift = e0 - exp;
+    if (shift >= 128)
+        return sig != 0;
+    return (sig >> shift) | ((sig & ((((uint128_t) 1) << shift) - 1)) != 0);
+}
+
+/**
+ * Round the sum of two non-null finite values. Values narrower than SUM_WINDOW bits below the larger one are only kept
+ * as a sticky bit, which is enough to round correctly a sum whose significands are at most 2*24 bits.
+ */
+static uint64_t add_round(bool sa, uint128_t siga, int ea, bool sb, uint128_t sigb, int eb, int rm, const fmt_params* f, int* flags)
+{
+    int top_a = ea + msb_index(siga) + 1;
+    int top_b = eb + msb_index(sigb) + 1;
+    int top   = (top_a > top_b) ? top_a : top_b;
+    int e0    = (ea < eb) ? ea : eb;
+    if (e0 < top - SUM_WINDOW)
+        e0 = top - SUM_WINDOW;
+
+    uint128_t A = align(siga, ea, e0);
+    uint128_t B = align(sigb, eb, e0);
+
+    bool      sign;
+    uint128_t sum;
+    if (sa == sb)
+    {
+        sign = sa;
+        sum  = A + B;
+    }
+    else if (A >= B)
+    {
+        sign = sa;
+        sum  = A - B;
+    }
+    else
+    {
+        sign = sb;
+        sum  = B - A;
+    }
+
+    if (sum == 0)
+        return zero(zero_sum_sign(rm), f);
+    return round_pack(sign, sum, e0, false, rm, f, flags);
+}
+
+static int add_signed(uint64_t* result, uint64_t op1, uint64_t op2, bool negate2, int rm, environment env)
+{
+    fmt_params f = get_params(env);
+    unpacked a = unpack(op1, &f);
+    unpacked b = unpack(op2, &f);
+    int flags = 0;
+
+    b.sign ^= negate2;
+
+    if (is_nan(&a) || is_nan(&b))
+    {
+        *result = canonical_nan(&f);
+        return (a.cls == CLS_SNAN || b.cls == CLS_SNAN) ? FLAG_NV : 0;
+    }
+    if (a.cls == CLS_INF && b.cls == CLS_INF && a.sign != b.sign)
+    {
+        *result = canonical_nan(&f);
+        return FLAG_NV;
+    }
+    if (a.cls == CLS_INF || b.cls == CLS_INF)
+        *result = inf((a.cls == CLS_INF) ? a.sign : b.sign, &f);
+    else if (a.cls == CLS_ZERO && b.cls == CLS_ZERO)
+        *result = zero((a.sign == b.sign) ? a.sign : zero_sum_sign(rm), &f);
+    else if (a.cls == CLS_ZERO)
+        *result = round_pack(b.sign, b.sig, b.exp, false, rm, &f, &flags);
+    else if (b.cls == CLS_ZERO)
+        *result = round_pack(a.sign, a.sig, a.exp, false, rm, &f, &flags);
+    else
+        *result = add_round(a.sign, a.sig, a.exp, b.sign, b.sig, b.exp, rm, &f, &flags);
+    return flags;
+}
+
+//########## OPERATIONS ################################################################################################
+
+int intfp_add(uint64_t* result, uint64_t op1, uint64_t op2, int rm, environment env)
+{
+    return add_signed(result, op1, op2, false, rm, env);
+}
+
+int intfp_sub(uint64_t* result, uint64_t op1, uint64_t op2, int rm, environment env)
+{
+    return add_signed(result, op1, op2, true, rm, env);
+}
+
+int intfp_mul(uint64_t* result, uint64_t op1, uint64_t op2, int rm, environment env)
+{
+    fmt_params f = get_params(env);
+    unpacked a = unpack(op1, &f);
+    unpacked b = unpack(op2, &f);
+    bool sign = a.sign ^ b.sign;
+    int flags = 0;
+
+    if (is_nan(&a) || is_nan(&b))
+    {
+        *result = canonical_nan(&f);
+        return (a.cls == CLS_SNAN || b.cls == CLS_SNAN) ? FLAG_NV : 0;
+    }
+    if ((a.cls == CLS_INF && b.cls == CLS_ZERO) || (a.cls == CLS_ZERO && b.cls == CLS_INF))
+    {
+        *result = canonical_nan(&f);
+        return FLAG_NV;
+    }
+    if (a.cls == CLS_INF || b.cls == CLS_INF)
+        *result = inf(sign, &f);
+    else if (a.cls == CLS_ZERO || b.cls == CLS_ZERO)
+        *result = zero(sign, &f);
+    else
+        *result = round_pack(sign, (uint128_t) a.sig * b.sig, a.exp + b.exp, false, rm, &f, &flags);
+    return flags;
+}
+
+int intfp_div(uint64_t* result, uint64_t op1, uint64_t op2, int rm, environment env)
+{
+    fmt_params f = get_params(env);
+    unpacked a = unpack(op1, &f);
+    unpacked b = unpack(op2, &f);
+    bool sign = a.sign ^ b.sign;
+    int flags = 0;
+
+    if (is_nan(&a) || is_nan(&b))
+    {
+        *result = canonical_nan(&f);
+        return (a.cls == CLS_SNAN || b.cls == CLS_SNAN) ? FLAG_NV : 0;
+    }
+    if ((a.cls == CLS_INF && b.cls == CLS_INF) || (a.cls == CLS_ZERO && b.cls == CLS_ZERO))
+    {
+        *result = canonical_nan(&f);
+        return FLAG_NV;
+    }
+    if (a.cls == CLS_INF)
+        *result = inf(sign, &f);
+    else if (b.cls == CLS_INF || a.cls == CLS_ZERO)
+        *result = zero(sign, &f);
+    else if (b.cls == CLS_ZERO)
+    {
+        *result = inf(sign, &f);
+        flags = FLAG_DZ;
+    }
+    else
+    {
+        // Quotient of at least t+3 bits, the remainder is the sticky bit
+        int shift = f.t + 3 + msb_index(b.sig) - msb_index(a.sig);
+        if (shift < 0)
+            shift = 0;
+        uint128_t num = (uint128_t) a.sig << shift;
+        uint128_t q   = num / b.sig;
+        bool sticky   = (num % b.sig) != 0;
+        *result = round_pack(sign, q, a.exp - b.exp - shift, sticky, rm, &f, &flags);
+    }
+    return flags;
+}
+
+// Integer square root, floor(sqrt(x))
+static uint128_t isqrt(uint128_t x)
+{
+    uint128_t r   = 0;
+    uint128_t bit = ((uint128_t) 1) << (msb_index(x) & ~1);
+    while (bit != 0)
+    {
+        if (x >= r + bit)
+        {
+            x -= r + bit;
+            r  = (r >> 1) + bit;
+        }
+        else
+            r >>= 1;
+        bit >>= 2;
+    }
+    return r;
+}
+
+int intfp_sqrt(uint64_t* result, uint64_t op1, int rm, environment env)
+{
+    fmt_params f = get_params(env);
+    unpacked a = unpack(op1, &f);
+    int flags = 0;
+
+    if (is_nan(&a))
+    {
+        *result = canonical_nan(&f);
+        return (a.cls == CLS_SNAN) ? FLAG_NV : 0;
+    }
+    if (a.cls == CLS_ZERO)
+        *result = zero(a.sign, &f);
+    else if (a.sign)
+    {
+        *result = canonical_nan(&f);
+        flags = FLAG_NV;
+    }
+    else if (a.cls == CLS_INF)
+        *result = inf(false, &f);
+    else
+    {
+        // Even exponent and radicand of at least 2*(t+3) bits, so that the root has at least t+3 bits
+        uint128_t rad = a.sig;
+        int exp = a.exp;
+        if (exp & 1)
+        {
+            rad <<= 1;
+            exp--;
+        }
+        int shift = 2 * (f.t + 3) - msb_index(rad);
+        shift = (shift < 0) ? 0 : (shift + 1) & ~1;
+        rad <<= shift;
+        exp -= shift;
+
+        uint128_t root = isqrt(rad);
+        *result = round_pack(false, root, exp / 2, root * root != rad, rm, &f, &flags);
+    }
+    return flags;
+}
+
+//########## FUSED OPERATIONS ##########################################################################################
+
+static int fused(uint64_t* result, uint64_t op1, uint64_t op2, uint64_t op3, bool negate_product, bool negate_addend, int rm, environment env)
+{
+    fmt_params f = get_params(env);
+    unpacked a = unpack(op1, &f);
+    unpacked b = unpack(op2, &f);
+    unpacked c = unpack(op3, &f);
+    int flags = 0;
+
+    bool invalid_product = (a.cls == CLS_INF && b.cls == CLS_ZERO) || (a.cls == CLS_ZERO && b.cls == CLS_INF);
+
+    if (is_nan(&a) || is_nan(&b) || is_nan(&c))
+    {
+        *result = canonical_nan(&f);
+        if (a.cls == CLS_SNAN || b.cls == CLS_SNAN || c.cls == CLS_SNAN || invalid_product)
+            return FLAG_NV;
+        return 0;
+    }
+    if (invalid_product)
+    {
+        *result = canonical_nan(&f);
+        return FLAG_NV;
+    }
+
+    bool ps = a.sign ^ b.sign ^ negate_product;
+    bool cs = c.sign ^ negate_addend;
+
+    if (a.cls == CLS_INF || b.cls == CLS_INF)
+    {
+        if (c.cls == CLS_INF && cs != ps)
+        {
+            *result = canonical_nan(&f);
+            return FLAG_NV;
+        }
+        *result = inf(ps, &f);
+    }
+    else if (c.cls == CLS_INF)
+        *result = inf(cs, &f);
+    else if (a.cls == CLS_ZERO || b.cls == CLS_ZERO)
+    {
+        if (c.cls == CLS_ZERO)
+            *result = zero((ps == cs) ? ps : zero_sum_sign(rm), &f);
+        else
+            *result = round_pack(cs, c.sig, c.exp, false, rm, &f, &flags);
+    }
+    else if (c.cls == CLS_ZERO)
+        *result = round_pack(ps, (uint128_t) a.sig * b.sig, a.exp + b.exp, false, rm, &f, &flags);
+    else
+        *result = add_round(ps, (uint128_t) a.sig * b.sig, a.exp + b.exp, cs, c.sig, c.exp, rm, &f, &flags);
+    return flags;
+}
+
+int intfp_fma(uint64_t* result, uint64_t op1, uint64_t op2, uint64_t op3, int rm, environment env)
+{
+    return fused(result, op1, op2, op3, false, false, rm, env);
+}
+
+int intfp_fms(uint64_t* result, uint64_t op1, uint64_t op2, uint64_t op3, int rm, environment env)
+{
+    return fused(result, op1, op2, op3, false, true, rm, env);
+}
+
+int intfp_fnma(uint64_t* result, uint64_t op1, uint64_t op2, uint64_t op3, int rm, environment env)
+{
+    return fused(result, op1, op2, op3, true, true, rm, env);
+}
+
+int intfp_fnms(uint64_t* result, uint64_t op1, uint64_t op2, uint64_t op3, int rm, environment env)
+{
+    return fused(result, op1, op2, op3, true, false, rm, env);
+}
+
+//########## COMPARISONS ###############################################################################################
+
+// Key ordering the non-NaN encodings by value, both zeros having the same key
+static inline int64_t order_key(uint64_t x, const fmt_params* f)
+{
+    int      sign_index = f->t + 64 - __builtin_clzll(f->e_max);
+    int64_t  magnitude  = x & ((1ULL << sign_index) - 1);
+    return ((x >> sign_index) & 1) ? -magnitude : magnitude;
+}
+
+static int min_max(uint64_t* result, uint64_t op1, uint64_t op2, bool is_max, environment env)
+{
+    fmt_params f = get_params(env);
+    unpacked a = unpack(op1, &f);
+    unpacked b = unpack(op2, &f);
+    int flags = (a.cls == CLS_SNAN || b.cls == CLS_SNAN) ? FLAG_NV : 0;
+
+    if (is_nan(&a) && is_nan(&b))
+        *result = canonical_nan(&f);
+    else if (is_nan(&a))
+        *result = op2;
+    else if (is_nan(&b))
+        *result = op1;
+    else if (a.cls == CLS_ZERO && b.cls == CLS_ZERO)
+        *result = zero(is_max ? (a.sign && b.sign) : (a.sign || b.sign), &f);
+    else
+    {
+        bool a_lower = order_key(op1, &f) < order_key(op2, &f);
+        *result = (a_lower != is_max) ? op1 : op2;
+    }
+    return flags;
+}
+
+int intfp_fmin(uint64_t* result, uint64_t op1, uint64_t op2, environment env)
+{
+    return min_max(result, op1, op2, false, env);
+}
+
+int intfp_fmax(uint64_t* result, uint64_t op1, uint64_t op2, environment env)
+{
+    return min_max(result, op1, op2, true, env);
+}
+
+// Comparison selected by lt and eq : FLE lt|eq, FLT lt, FEQ eq
+static int compare(uint64_t* result, uint64_t op1, uint64_t op2, bool lt, bool eq, environment env)
+{
+    fmt_params f = get_params(env);
+    unpacked a = unpack(op1, &f);
+    unpacked b = unpack(op2, &f);
+
+    if (is_nan(&a) || is_nan(&b))
+    {
+        *result = 0;
+        return (lt || a.cls == CLS_SNAN || b.cls == CLS_SNAN) ? FLAG_NV : 0;
+    }
+
+    int64_t ka = order_key(op1, &f);
+    int64_t kb = order_key(op2, &f);
+    *result = (lt && ka < kb) || (eq && ka == kb);
+    return 0;
+}
+
+int intfp_cmp_leq(uint64_t* result, uint64_t op1, uint64_t op2, environment env)
+{
+    return compare(result, op1, op2, true, true, env);
+}
+
+int intfp_cmp_lt(uint64_t* result, uint64_t op1, uint64_t op2, environment env)
+{
+    return compare(result, op1, op2, true, false, env);
+}
+
+int intfp_cmp_eq(uint64_t* result, uint64_t op1, uint64_t op2, environment env)
+{
+    return compare(result, op1, op2, false, true, env);
+}
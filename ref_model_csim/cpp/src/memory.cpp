@@ -32,6 +32,7 @@
 #include <cstdint>
 #include "bitwise.h"
 #include "memory.h"
+#include "fpu_probes.h"
 
 
 int get_flags(bool sNaN_inputs, bool qNaN_inputs)
@@ -383,6 +384,7 @@ void mpfr2IEEElike_subnormal(uint32_t* output_IEEElike, mpfr_t input_mpfr, envir
     uint16_t ms = MS(env);//number of explicit bits for the significand
     mpfr_exp_t exponent = 0;
     char* result_str = mpfr_get_str(NULL,&exponent,2,0,input_mpfr,MPFR_RNDN);//get significand in binary as char array, and exponent
+    FPU_PROBE4(subnormal, env.bis, env.es, exponent, (int) rounding_mode);
 
     if(print_details)
     {
@@ -462,6 +464,7 @@ bool IEEElike_exponent_fits(uint32_t* output, mpfr_t input_mpfr, int64_t exponen
     if(exponent > IEEElike_emax(env.es))
     {
         //overflow towards +/- Inf
+        FPU_PROBE4(overflow, env.bis, env.es, exponent, (int) rounding_mode);
         //set E field to 11...1
         for(int32_t index_in_IEEElike = IEEELIKE_E_MSB_INDEX(ms,env.es); index_in_IEEElike >= IEEELIKE_E_LSB_INDEX(ms); index_in_IEEElike--)//from MSB to LSB
         {
@@ -487,10 +490,12 @@ bool IEEElike_exponent_fits(uint32_t* output, mpfr_t input_mpfr, int64_t exponen
         
             if(print_details) { printf("mpfr rounded = "); mpfr_dump(mpfr_rounded); putchar('\n'); }
             mpfr2IEEElike_subnormal(output, mpfr_rounded, env, rounding_mode);
+            mpfr_clear(mpfr_rounded);
             return false;//no, does not fit
         }
         else {
             //underflow towards +/- 0
+            FPU_PROBE4(underflow, env.bis, env.es, exponent, (int) rounding_mode);
             //set E field to 00...0
             for(int32_t index_in_IEEElike = IEEELIKE_E_MSB_INDEX(ms,env.es); index_in_IEEElike >= IEEELIKE_E_LSB_INDEX(ms); index_in_IEEElike--)//from MSB to LSB
             {
@@ -639,6 +644,7 @@ void IEEElike2mpfr(mpfr_t output_mpfr, const uint32_t* input_IEEElike, environme
     else if(IEEELIKE_IS_NAN(E,E_max,T_is_null))//case NaN
     {
         //MPFR does not distinguish qNaN and sNaN
+        FPU_PROBE2(nan_operand, env.bis, env.es);
         mpfr_set_nan(output_mpfr);
         if(print_details) { printf("IEEE-like input is quiet NaN or signaling NaN -> MPFR output set to NaN\n"); }
     }
@@ -666,6 +672,7 @@ void mpfr2IEEElike(uint32_t* output_IEEElike, mpfr_t input_mpfr, environment env
     //manage special values
     if(mpfr_nan_p(input_mpfr))
     {
+        FPU_PROBE2(nan_result, env.bis, env.es);
         IEEElike_set_to_qNaN(output_IEEElike,env.es,ms);
         if(print_details) { printf("mpfr input is NaN -> IEEE-like output set to qNaN\n"); }
     }
@@ -815,7 +822,7 @@ void mpfr2IEEElike(uint32_t* output_IEEElike, mpfr_t input_mpfr, environment env
             }
 
         }
-        mpfr_free_str(result_str);
     }
+    mpfr_free_str(result_str);
     // if(print_details) { printf("IEEE-like output = "); IEEElike_print_value(output_IEEElike,env); putchar('\n'); }
 }
@@ -61,6 +61,7 @@ int add(uint32_t* result, const uint32_t* op1, const uint32_t* op2, mpfr_rnd_t r
 	// Exception flags
 	int res = get_flags(sNaN_inputs, qNaN_inputs);
 	
+    mpfr_clears(op1_mpfr, op2_mpfr, result_mpfr, (mpfr_ptr) 0);
 	return res;
 }
 
@@ -89,6 +90,7 @@ int sub(uint32_t* result, const uint32_t* op1, const uint32_t* op2, mpfr_rnd_t r
 	// Exception flags
 	int res = get_flags(sNaN_inputs, qNaN_inputs);
 	
+    mpfr_clears(op1_mpfr, op2_mpfr, result_mpfr, (mpfr_ptr) 0);
 	return res;
 }
 
@@ -117,6 +119,7 @@ int mul(uint32_t* result, const uint32_t* op1, const uint32_t* op2, mpfr_rnd_t r
 	// Exception flags
 	int res = get_flags(sNaN_inputs, qNaN_inputs);
 	
+    mpfr_clears(op1_mpfr, op2_mpfr, result_mpfr, (mpfr_ptr) 0);
 	return res;
 }
 
@@ -143,6 +146,7 @@ int div(uint32_t* result, const uint32_t* op1, const uint32_t* op2, mpfr_rnd_t r
 	
 	// Exception flags
 	int res = get_flags(sNaN_inputs, qNaN_inputs);
+    mpfr_clears(op1_mpfr, op2_mpfr, result_mpfr, (mpfr_ptr) 0);
 	return res;
 }
 
@@ -169,6 +173,7 @@ int sqrt(uint32_t* result, const uint32_t* op, mpfr_rnd_t rounding_mode, environ
 	
 	int res = get_flags(sNaN_inputs, qNaN_inputs);
 	
+    mpfr_clears(op_mpfr, result_mpfr, (mpfr_ptr) 0);
 	return res;
 }
 
@@ -200,6 +205,7 @@ int fma(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32
 					
 	int res = special_op ? 16 : get_flags(sNaN_inputs, qNaN_inputs);
 	
+    mpfr_clears(op1_mpfr, op2_mpfr, op3_mpfr, result_mpfr, (mpfr_ptr) 0);
 	return res;
 
 }
@@ -210,7 +216,7 @@ int fnma(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint3
     int inex;
 
     // Initialize working environment
-    int wp = abs(IEEElike_emax(env.es) - IEEElike_emin(env.es)); // Working precision
+    int wp = 2 * (MBITS(env) + 1); // Working precision, the product is exact
 
     mpfr_set_emin(MPFR_EMIN_MIN);
     mpfr_set_emax(MPFR_EMAX_MAX);
@@ -219,7 +225,7 @@ int fnma(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint3
     IEEElike2mpfr(op2_mpfr, op2, env, rounding_mode, 0, false);
     IEEElike2mpfr(op3_mpfr, op3, env, rounding_mode, 0, false);
     
-	mpfr_init2(res_mpfr, wp+1);
+	mpfr_init2(res_mpfr, wp);
 	mpfr_init2(final_res_mpfr, MBITS(env)+1);
 
     mpfr_clear_flags ();
@@ -245,6 +251,7 @@ int fnma(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint3
 					
 	int res = special_op ? 16 : get_flags(sNaN_inputs, qNaN_inputs);
 
+    mpfr_clears(op1_mpfr, op2_mpfr, op3_mpfr, res_mpfr, final_res_mpfr, (mpfr_ptr) 0);
 	return res;
 }
 
@@ -277,6 +284,7 @@ int fms(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint32
 					
 	int res = special_op ? 16 : get_flags(sNaN_inputs, qNaN_inputs);
 	
+    mpfr_clears(op1_mpfr, op2_mpfr, op3_mpfr, result_mpfr, (mpfr_ptr) 0);
 	return res;
 }
 
@@ -286,7 +294,7 @@ int fnms(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint3
     int inex;
 
     // Initialize working environment
-    int wp = abs(IEEElike_emax(env.es) - IEEElike_emin(env.es)); // Working precision
+    int wp = 2 * (MBITS(env) + 1); // Working precision, the product is exact
 
     mpfr_set_emin(MPFR_EMIN_MIN);
     mpfr_set_emax(MPFR_EMAX_MAX);
@@ -295,7 +303,7 @@ int fnms(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint3
     IEEElike2mpfr(op2_mpfr, op2, env, rounding_mode, 0, false);
     IEEElike2mpfr(op3_mpfr, op3, env, rounding_mode, 0, false);
     
-	mpfr_init2(res_mpfr, wp+1);
+	mpfr_init2(res_mpfr, wp);
 	mpfr_init2(final_res_mpfr, MBITS(env)+1);
 
     mpfr_clear_flags ();
@@ -323,6 +331,7 @@ int fnms(uint32_t* result, const uint32_t* op1, const uint32_t* op2, const uint3
 					
 	int res = special_op ? 16 : get_flags(sNaN_inputs, qNaN_inputs);
 
+    mpfr_clears(op1_mpfr, op2_mpfr, op3_mpfr, res_mpfr, final_res_mpfr, (mpfr_ptr) 0);
 	return res;
 }
 
@@ -426,6 +435,7 @@ int fmin(uint32_t* result, const uint32_t* op1, const uint32_t* op2, mpfr_rnd_t
 	// Exception flags
 	if (sNaN_inputs) SET_BIT_TO_1__DWORD(flags, 4);
 
+    mpfr_clears(op1_mpfr, op2_mpfr, result_mpfr, (mpfr_ptr) 0);
 	return flags;
 }
 
@@ -451,6 +461,7 @@ int fmax(uint32_t* result, const uint32_t* op1, const uint32_t* op2, mpfr_rnd_t
 	// Exception flags
 	if (sNaN_inputs) SET_BIT_TO_1__DWORD(flags, 4);
 
+    mpfr_clears(op1_mpfr, op2_mpfr, result_mpfr, (mpfr_ptr) 0);
 	return flags;
 }
 
@@ -477,6 +488,7 @@ int fcvt_f2i32 (uint32_t* result, const uint32_t* op1, int is_signed, mpfr_rnd_t
         mpfr_clear_flags();
         mpfr_init2 (x, prec);
         mpfr_rint (x, op1_mpfr, rounding_mode);
+        mpfr_clear(x);
 
         if (!mpfr_fits_sint_p(op1_mpfr, rounding_mode)) {
             res32 = (mpfr_sgn(op1_mpfr)<0) ? INT32_MIN : INT32_MAX;
@@ -508,6 +520,7 @@ int fcvt_f2i32 (uint32_t* result, const uint32_t* op1, int is_signed, mpfr_rnd_t
     result[0] = temp_result & 0xFFFFFFFF;
     result[1] = (temp_result >> 32) & 0xFFFFFFFF;	
 
+    mpfr_clears(op1_mpfr, mpfr_min, mpfr_max, (mpfr_ptr) 0);
 	return exception;
 }
 
@@ -538,6 +551,7 @@ int fcvt_f2i64(uint32_t* result, const uint32_t* op1, int is_signed, mpfr_rnd_t
     result[0] = temp_result & ((1UL <<32) -1);
     result[1] = (temp_result >> 32) & ((1UL <<32) -1);
 	
+    mpfr_clears(op1_mpfr, mpfr_min, mpfr_max, (mpfr_ptr) 0);
 	return exception;
 }
 
@@ -578,6 +592,7 @@ int fcvt_i2f(uint32_t* result, const uint32_t* op1, int is_signed, int int_forma
 	exception = get_conv_flags();
 
     mpfr2IEEElike(result, result_mpfr, env, rounding_mode, false);
+    mpfr_clear(result_mpfr);
 	return exception;
 }
 
@@ -605,6 +620,7 @@ int fcvt_f2f(uint32_t* result, const uint32_t* op1, mpfr_rnd_t rounding_mode, en
     mpfr2IEEElike(result, op1_mpfr, dst_env, rounding_mode, false);
 	
 	exception = get_flags(sNaN_inputs, qNaN_inputs);
+    mpfr_clear(op1_mpfr);
 	return exception;
 }
 
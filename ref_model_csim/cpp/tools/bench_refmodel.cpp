@@ -0,0 +1,653 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Microbenchmarks of the DPI entries and of the building blocks of the reference model
+ *  History       :
+ */
+
+#include "operations.h"
+#include "fpu_exec.h"
+#include "fpu_store.h"
+#include "fpu_dpi.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define POOL_SIZE           1024    /**< operand triples per (format, class), cycled through by the timed loops */
+#define DEFAULT_TIME_MS     5       /**< minimum timed duration of a repetition of a cell */
+#define DEFAULT_REPEAT      3       /**< repetitions of a cell */
+#define DEFAULT_THRESHOLD   10.0    /**< regression threshold of the compare mode, in percent */
+#define LINE_SIZE           512
+#define PERF_COUNTERS       3
+
+//########## ALLOCATION COUNTER ########################################################################################
+
+// MPFR allocates through the GMP memory functions, they are replaced by counting wrappers
+static long allocations = 0;
+
+static void* count_alloc(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+static void* count_realloc(void* ptr, size_t old_size, size_t new_size)
+{
+    allocations++;
+    return realloc(ptr, new_size);
+}
+
+static void count_free(void* ptr, size_t size)
+{
+    free(ptr);
+}
+
+//########## HARDWARE COUNTERS #########################################################################################
+
+static const char* perf_names[PERF_COUNTERS]  = { "cycles", "instructions", "cache_misses" };
+static const int   perf_configs[PERF_COUNTERS] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES };
+static int         perf_fds[PERF_COUNTERS]     = { -1, -1, -1 };
+
+static bool perf_open()
+{
+    for (int k = 0; k < PERF_COUNTERS; k++)
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.config         = perf_configs[k];
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+
+        perf_fds[k] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if (perf_fds[k] < 0)
+        {
+            perror("perf_event_open");
+            for (int j = 0; j < k; j++)
+                close(perf_fds[j]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void perf_start()
+{
+    for (int k = 0; k < PERF_COUNTERS; k++)
+    {
+        ioctl(perf_fds[k], PERF_EVENT_IOC_RESET, 0);
+        ioctl(perf_fds[k], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static void perf_stop(uint64_t* counts)
+{
+    for (int k = 0; k < PERF_COUNTERS; k++)
+    {
+        ioctl(perf_fds[k], PERF_EVENT_IOC_DISABLE, 0);
+        if (read(perf_fds[k], &counts[k], sizeof(counts[k])) != sizeof(counts[k]))
+            counts[k] = 0;
+    }
+}
+
+//########## OPERANDS ##################################################################################################
+
+typedef enum
+{
+    CLASS_NORMAL = 0,
+    CLASS_SUBNORMAL,
+    CLASS_SPECIAL,     /**< zeros, infinities and NaNs */
+    CLASS_NUM
+} operand_class_e;
+
+static const char* class_names[CLASS_NUM] = { "normal", "subnormal", "special" };
+
+/**
+ * \brief Formats of the benchmark, FP16ALT is only reachable through the DPI entries taking an environment
+ */
+typedef struct
+{
+    const char* name;
+    int         fmt;        /**< format code, see fpu_fmt_e */
+    env_t       env;
+    int         dst_f2f;    /**< index of the destination format of the FCVT_F2F cells */
+} bench_fmt;
+
+#define BENCH_FMT_NUM 5
+
+static const bench_fmt bench_fmts[BENCH_FMT_NUM] = {
+    { "FP32",    FPU_FMT_FP32,    { 31, 7  }, 2 },
+    { "FP64",    FPU_FMT_FP64,    { 63, 10 }, 0 },
+    { "FP16",    FPU_FMT_FP16,    { 15, 4  }, 0 },
+    { "FP8",     FPU_FMT_FP8,     { 7,  4  }, 2 },
+    { "FP16ALT", FPU_FMT_FP16ALT, { 15, 7  }, 0 },
+};
+
+/**
+ * \brief Operands of a (format, class) pair, encodings in dword pairs and NaN-boxed 64-bit values
+ */
+typedef struct
+{
+    uint32_t raw[POOL_SIZE][3][2];
+    uint64_t boxed[POOL_SIZE][3];
+} operand_pool;
+
+static uint64_t random_operand(std::mt19937_64& gen, const env_t& env, int cls)
+{
+    int      width = env.bis + 1;
+    int      t     = width - (env.es + 1) - 1;
+    uint64_t E_max = (1ULL << (env.es + 1)) - 1;
+    uint64_t sign  = gen() & 1;
+    uint64_t T     = gen() & ((1ULL << t) - 1);
+    uint64_t E;
+
+    switch (cls)
+    {
+    case CLASS_NORMAL:
+        E = 1 + gen() % (E_max - 1);
+        break;
+    case CLASS_SUBNORMAL:
+        E = 0;
+        T = T ? T : 1;
+        break;
+    default:
+        switch (gen() % 4)
+        {
+        case 0:  E = 0;     T = 0;                       break; // zero
+        case 1:  E = E_max; T = 0;                       break; // infinity
+        case 2:  E = E_max; T |= 1ULL << (t - 1);        break; // qNaN
+        default: E = E_max; T = (T >> 1) | 1;            break; // sNaN
+        }
+    }
+    return (sign << (width - 1)) | (E << t) | T;
+}
+
+static void fill_pool(operand_pool* pool, const env_t& env, int cls, uint64_t seed)
+{
+    std::mt19937_64 gen(seed);
+    int width = env.bis + 1;
+    uint64_t box = width < 64 ? ~((1ULL << width) - 1) : 0;
+
+    for (int i = 0; i < POOL_SIZE; i++)
+        for (int k = 0; k < 3; k++)
+        {
+            uint64_t x = random_operand(gen, env, cls);
+            pool->raw[i][k][0] = x & 0xFFFFFFFF;
+            pool->raw[i][k][1] = x >> 32;
+            pool->boxed[i][k]  = x | box;
+        }
+}
+
+//########## CELLS #####################################################################################################
+
+/**
+ * \brief Parameters of a benchmarked call
+ */
+typedef struct
+{
+    const bench_fmt*    fmt;
+    const operand_pool* pool;
+    int                 rm;
+    int                 op;     /**< operation of the dpi_fpu_exec cells */
+    environment         env;    /**< environment of the building block cells */
+    mpfr_t*             values; /**< MPFR operands of the mpfr2IEEElike cells */
+} bench_args;
+
+typedef int (*bench_fn)(const bench_args* a, int i);
+
+static int b_fadd(const bench_args* a, int i)     { uint32_t r[4]; return dpi_fadd(r, a->pool->raw[i][0], a->pool->raw[i][1], a->rm, &a->fmt->env); }
+static int b_fsub(const bench_args* a, int i)     { uint32_t r[4]; return dpi_fsub(r, a->pool->raw[i][0], a->pool->raw[i][1], a->rm, &a->fmt->env); }
+static int b_fmul(const bench_args* a, int i)     { uint32_t r[4]; return dpi_fmul(r, a->pool->raw[i][0], a->pool->raw[i][1], a->rm, &a->fmt->env); }
+static int b_fdiv(const bench_args* a, int i)     { uint32_t r[4]; return dpi_fdiv(r, a->pool->raw[i][0], a->pool->raw[i][1], a->rm, &a->fmt->env); }
+static int b_fma(const bench_args* a, int i)      { uint32_t r[4]; return dpi_fma (r, a->pool->raw[i][0], a->pool->raw[i][1], a->pool->raw[i][2], a->rm, &a->fmt->env); }
+static int b_fms(const bench_args* a, int i)      { uint32_t r[4]; return dpi_fms (r, a->pool->raw[i][0], a->pool->raw[i][1], a->pool->raw[i][2], a->rm, &a->fmt->env); }
+static int b_fnma(const bench_args* a, int i)     { uint32_t r[4]; return dpi_fnma(r, a->pool->raw[i][0], a->pool->raw[i][1], a->pool->raw[i][2], a->rm, &a->fmt->env); }
+static int b_fnms(const bench_args* a, int i)     { uint32_t r[4]; return dpi_fnms(r, a->pool->raw[i][0], a->pool->raw[i][1], a->pool->raw[i][2], a->rm, &a->fmt->env); }
+static int b_fsqrt(const bench_args* a, int i)    { uint32_t r[4]; return dpi_fsqrt(r, a->pool->raw[i][0], a->rm, &a->fmt->env); }
+static int b_fcmp(const bench_args* a, int i)     { uint32_t r[4]; return dpi_fcmp(r, a->pool->raw[i][0], a->pool->raw[i][1], a->rm, &a->fmt->env); }
+static int b_fmin_max(const bench_args* a, int i) { uint32_t r[4]; return dpi_fmin_max(r, a->pool->raw[i][0], a->pool->raw[i][1], a->rm, &a->fmt->env); }
+static int b_fsgnj(const bench_args* a, int i)    { uint32_t r[4]; return dpi_fsgnj(r, a->pool->raw[i][0], a->pool->raw[i][1], a->rm, &a->fmt->env); }
+static int b_fmv_f2x(const bench_args* a, int i)  { uint32_t r[4]; return dpi_fmv_f2x(r, a->pool->raw[i][0], &a->fmt->env, 2); }
+static int b_fclass(const bench_args* a, int i)   { uint32_t r[4]; return dpi_fclass(r, a->pool->raw[i][0], &a->fmt->env); }
+
+static int b_fcvt_f2i(const bench_args* a, int i)
+{
+    uint32_t r[4];
+    return dpi_fcvt_f2i(r, a->pool->raw[i][0], a->rm, &a->fmt->env, 1, a->fmt->fmt == FPU_FMT_FP64);
+}
+
+static int b_fcvt_i2f(const bench_args* a, int i)
+{
+    uint32_t r[4];
+    return dpi_fcvt_i2f(r, a->pool->raw[i][0], a->rm, &a->fmt->env, 1, a->fmt->fmt == FPU_FMT_FP64);
+}
+
+static int b_fcvt_f2f(const bench_args* a, int i)
+{
+    uint32_t r[4];
+    return dpi_fcvt_f2f(r, a->pool->raw[i][0], a->rm, &a->fmt->env, &bench_fmts[a->fmt->dst_f2f].env);
+}
+
+static int b_fpu_exec(const bench_args* a, int i)
+{
+    const uint64_t* x = a->pool->boxed[i];
+    uint64_t imm = x[2];
+    int fmt = a->fmt->fmt;
+
+    // Integer conversions from and to signed INT32, FCVT_F2F from the format of the pool
+    if (a->op == FPU_OP_FCVT_F2I || a->op == FPU_OP_FCVT_I2F)
+        imm = 0;
+    if (a->op == FPU_OP_FCVT_F2F)
+    {
+        imm = fmt;
+        fmt = bench_fmts[a->fmt->dst_f2f].fmt;
+    }
+    int flags;
+    return (int) dpi_fpu_exec(a->op, x[0], x[1], imm, fmt, a->rm, 64, 64, &flags);
+}
+
+static int b_fpu_exec_all_rm(const bench_args* a, int i)
+{
+    const uint64_t* x = a->pool->boxed[i];
+    int64_t result[FPU_RM_NUM];
+    int     flags[FPU_RM_NUM];
+    return dpi_fpu_exec_all_rm(a->op, x[0], x[1], x[2], a->fmt->fmt, 64, 64, result, flags);
+}
+
+static int b_IEEElike2mpfr(const bench_args* a, int i)
+{
+    mpfr_t x;
+    IEEElike2mpfr(x, a->pool->raw[i][0], a->env, MPFR_RNDN, 0, false);
+    int sign = mpfr_signbit(x);
+    mpfr_clear(x);
+    return sign;
+}
+
+static int b_mpfr2IEEElike(const bench_args* a, int i)
+{
+    uint32_t r[4] = { 0, 0, 0, 0 };
+    mpfr2IEEElike(r, a->values[i], a->env, MPFR_RNDN, false);
+    return r[0];
+}
+
+static int b_get_flags(const bench_args* a, int i)
+{
+    return get_flags(i & 1, i & 2);
+}
+
+/**
+ * \brief DPI entries taking an environment
+ */
+typedef struct
+{
+    const char* name;
+    bench_fn    fn;
+    int         nrm;        /**< values of rm : rounding modes RNE to RUP, or function selectors */
+    bool        rounding;   /**< rm is a rounding mode */
+} bench_entry;
+
+// RMM is not benchmarked : the MPFR operations do not support MPFR_RNDNA
+static const bench_entry dpi_entries[] = {
+    { "dpi_fadd",     b_fadd,     4, true  },
+    { "dpi_fsub",     b_fsub,     4, true  },
+    { "dpi_fmul",     b_fmul,     4, true  },
+    { "dpi_fdiv",     b_fdiv,     4, true  },
+    { "dpi_fma",      b_fma,      4, true  },
+    { "dpi_fms",      b_fms,      4, true  },
+    { "dpi_fnma",     b_fnma,     4, true  },
+    { "dpi_fnms",     b_fnms,     4, true  },
+    { "dpi_fsqrt",    b_fsqrt,    4, true  },
+    { "dpi_fcmp",     b_fcmp,     3, false },
+    { "dpi_fmin_max", b_fmin_max, 2, false },
+    { "dpi_fsgnj",    b_fsgnj,    3, false },
+    { "dpi_fmv_f2x",  b_fmv_f2x,  1, false },
+    { "dpi_fclass",   b_fclass,   1, false },
+    { "dpi_fcvt_f2i", b_fcvt_f2i, 4, true  },
+    { "dpi_fcvt_i2f", b_fcvt_i2f, 4, true  },
+    { "dpi_fcvt_f2f", b_fcvt_f2f, 4, true  },
+};
+
+static const char* rm_names[4] = { "RNE", "RTZ", "RDN", "RUP" };
+
+//########## MEASURE ###################################################################################################
+
+typedef struct
+{
+    std::string name;
+    std::string entry;
+    std::string fmt;
+    std::string rm;
+    std::string cls;
+    long        iterations;
+    double      ns_per_op;
+    double      allocs_per_op;
+    bool        has_perf;
+    double      perf_per_op[PERF_COUNTERS];
+} bench_result;
+
+typedef struct
+{
+    double      time_ms;
+    int         repeat;
+    bool        perf;
+    const char* filter;
+} bench_options;
+
+static volatile int sink;
+
+static void measure(std::vector<bench_result>& results, const bench_options* opt, const char* entry, const char* fmt,
+                    const char* rm, const char* cls, bench_fn fn, const bench_args* args)
+{
+    bench_result r;
+    r.entry = entry;
+    r.fmt   = fmt;
+    r.rm    = rm;
+    r.cls   = cls;
+    r.name  = r.entry + "/" + r.fmt + "/" + r.rm + "/" + r.cls;
+    if (opt->filter != NULL && strstr(r.name.c_str(), opt->filter) == NULL)
+        return;
+
+    // Warm-up pass, also builds the lazy tables of the model
+    int acc = 0;
+    for (int i = 0; i < POOL_SIZE; i++)
+        acc += fn(args, i);
+
+    // The fastest of the repetitions is kept, it is the least disturbed by the rest of the machine
+    typedef std::chrono::steady_clock clock;
+    r.ns_per_op = 0;
+    for (int rep = 0; rep < opt->repeat; rep++)
+    {
+        uint64_t counts[PERF_COUNTERS] = { 0, 0, 0 };
+        long     iterations = 0;
+        long     allocs_before = allocations;
+        double   elapsed_ns = 0;
+
+        if (opt->perf)
+            perf_start();
+        clock::time_point start = clock::now();
+        do
+        {
+            for (int i = 0; i < POOL_SIZE; i++)
+                acc += fn(args, i);
+            iterations += POOL_SIZE;
+            elapsed_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        } while (elapsed_ns < opt->time_ms * 1e6);
+        if (opt->perf)
+            perf_stop(counts);
+
+        if (rep == 0 || elapsed_ns / iterations < r.ns_per_op)
+        {
+            r.iterations    = iterations;
+            r.ns_per_op     = elapsed_ns / iterations;
+            r.allocs_per_op = (double) (allocations - allocs_before) / iterations;
+            for (int k = 0; k < PERF_COUNTERS; k++)
+                r.perf_per_op[k] = (double) counts[k] / iterations;
+        }
+    }
+    r.has_perf = opt->perf;
+    sink = acc;
+    results.push_back(r);
+
+    fprintf(stderr, "%-48s %10.1f ns/op %8.2f allocs/op\n", r.name.c_str(), r.ns_per_op, r.allocs_per_op);
+}
+
+static void run_all(std::vector<bench_result>& results, const bench_options* opt)
+{
+    static operand_pool pools[BENCH_FMT_NUM][CLASS_NUM];
+    uint64_t seed = 1;
+
+    for (int f = 0; f < BENCH_FMT_NUM; f++)
+        for (int c = 0; c < CLASS_NUM; c++)
+            fill_pool(&pools[f][c], bench_fmts[f].env, c, seed++);
+
+    for (int f = 0; f < BENCH_FMT_NUM; f++)
+    {
+        const bench_fmt* fmt = &bench_fmts[f];
+        bool fpu_fmt = fmt->fmt < FPU_DST_FMT_NUM;
+
+        for (int c = 0; c < CLASS_NUM; c++)
+        {
+            bench_args args;
+            memset(&args, 0, sizeof(args));
+            args.fmt     = fmt;
+            args.pool    = &pools[f][c];
+            args.env.bis = fmt->env.bis;
+            args.env.es  = fmt->env.es;
+
+            // DPI entries taking an environment
+            for (size_t e = 0; e < sizeof(dpi_entries) / sizeof(dpi_entries[0]); e++)
+                for (int rm = 0; rm < dpi_entries[e].nrm; rm++)
+                {
+                    char rm_name[16];
+                    snprintf(rm_name, sizeof(rm_name), "rm%d", rm);
+                    args.rm = rm;
+                    measure(results, opt, dpi_entries[e].name, fmt->name, dpi_entries[e].rounding ? rm_names[rm] : rm_name,
+                            class_names[c], dpi_entries[e].fn, &args);
+                }
+
+            // Opcode-dispatched entries, on the formats of the FPU, in RNE
+            if (fpu_fmt)
+            {
+                args.rm = 0;
+                for (int op = 0; op < FPU_OP_NUM; op++)
+                {
+                    std::string name = std::string("dpi_fpu_exec.") + fpu_op_name(op);
+                    args.op = op;
+                    measure(results, opt, name.c_str(), fmt->name, "RNE", class_names[c], b_fpu_exec, &args);
+                }
+                for (int op = 0; op < FPU_OP_NUM; op++)
+                {
+                    // Only the operations whose rm field is a rounding mode are evaluated in every mode
+                    int64_t result[FPU_RM_NUM];
+                    int     flags[FPU_RM_NUM];
+                    if (dpi_fpu_exec_all_rm(op, 0, 0, 0, fmt->fmt, 64, 64, result, flags) != 0)
+                        continue;
+                    std::string name = std::string("dpi_fpu_exec_all_rm.") + fpu_op_name(op);
+                    args.op = op;
+                    measure(results, opt, name.c_str(), fmt->name, "ALL", class_names[c], b_fpu_exec_all_rm, &args);
+                }
+            }
+
+            // Building blocks of the MPFR operations
+            IEEElike_set_exp_range(args.env.es, MBITS(args.env));
+            measure(results, opt, "IEEElike2mpfr", fmt->name, "-", class_names[c], b_IEEElike2mpfr, &args);
+
+            static mpfr_t values[POOL_SIZE];
+            for (int i = 0; i < POOL_SIZE; i++)
+                IEEElike2mpfr(values[i], args.pool->raw[i][0], args.env, MPFR_RNDN, 0, false);
+            args.values = values;
+            measure(results, opt, "mpfr2IEEElike", fmt->name, "-", class_names[c], b_mpfr2IEEElike, &args);
+            for (int i = 0; i < POOL_SIZE; i++)
+                mpfr_clear(values[i]);
+        }
+    }
+
+    bench_args args;
+    memset(&args, 0, sizeof(args));
+    measure(results, opt, "get_flags", "-", "-", "-", b_get_flags, &args);
+}
+
+//########## REPORT ####################################################################################################
+
+// One cell per line, read back by the compare mode
+static void write_json(FILE* f, const std::vector<bench_result>& results)
+{
+    fprintf(f, "{\n  \"mpfr\": \"%s\",\n  \"model\": \"%s\",\n  \"cells\": [\n", mpfr_get_version(), fpu_store_model_version());
+    for (size_t k = 0; k < results.size(); k++)
+    {
+        const bench_result* r = &results[k];
+        fprintf(f, "    {\"name\": \"%s\", \"entry\": \"%s\", \"fmt\": \"%s\", \"rm\": \"%s\", \"class\": \"%s\", "
+                   "\"iterations\": %ld, \"ns_per_op\": %.3f, \"ops_per_s\": %.1f, \"allocs_per_op\": %.3f",
+                r->name.c_str(), r->entry.c_str(), r->fmt.c_str(), r->rm.c_str(), r->cls.c_str(), r->iterations,
+                r->ns_per_op, 1e9 / r->ns_per_op, r->allocs_per_op);
+        if (r->has_perf)
+            for (int c = 0; c < PERF_COUNTERS; c++)
+                fprintf(f, ", \"%s_per_op\": %.1f", perf_names[c], r->perf_per_op[c]);
+        fprintf(f, "}%s\n", k + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+static bool json_number(const char* line, const char* key, double* value)
+{
+    const char* p = strstr(line, key);
+    return p != NULL && sscanf(p + strlen(key), " : %lf", value) == 1;
+}
+
+// Compare with a baseline written by write_json, return the number of regressions
+static int compare(const std::vector<bench_result>& results, const char* path, double threshold)
+{
+    FILE* f = fopen(path, "r");
+    if (f == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    int  regressions = 0, compared = 0;
+    char line[LINE_SIZE];
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        char   name[128];
+        double ns, allocs;
+        const char* p = strstr(line, "\"name\": \"");
+        if (p == NULL || sscanf(p + 9, "%127[^\"]", name) != 1 ||
+            !json_number(line, "\"ns_per_op\"", &ns) || !json_number(line, "\"allocs_per_op\"", &allocs))
+            continue;
+
+        for (size_t k = 0; k < results.size(); k++)
+        {
+            const bench_result* r = &results[k];
+            if (r->name != name)
+                continue;
+
+            compared++;
+            double limit = 1.0 + threshold / 100.0;
+            if (r->ns_per_op > ns * limit)
+            {
+                printf("REGRESSION %-48s %10.1f ns/op, baseline %10.1f (%+.1f%%)\n", name, r->ns_per_op, ns,
+                       100.0 * (r->ns_per_op / ns - 1.0));
+                regressions++;
+            }
+            if (r->allocs_per_op > allocs * limit + 0.01)
+            {
+                printf("REGRESSION %-48s %10.2f allocs/op, baseline %10.2f\n", name, r->allocs_per_op, allocs);
+                regressions++;
+            }
+            break;
+        }
+    }
+    fclose(f);
+    printf("%d cells compared with %s, %d regressions above %.1f%%\n", compared, path, regressions, threshold);
+    return regressions;
+}
+
+//########## MAIN ######################################################################################################
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [--time <ms>] [--repeat <n>] [--filter <text>] [--perf] [--output <file>] [--baseline <file> [--threshold <pct>]]\n", name);
+    printf("  --time <ms>        minimum timed duration of a repetition of a cell (default %d)\n", DEFAULT_TIME_MS);
+    printf("  --repeat <n>       repetitions of a cell, the fastest one is reported (default %d)\n", DEFAULT_REPEAT);
+    printf("  --filter <text>    only the cells whose name (entry/fmt/rm/class) contains the text\n");
+    printf("  --perf             also count cycles, instructions and cache misses with perf_event_open\n");
+    printf("  --output <file>    write the results as JSON (default: standard output)\n");
+    printf("  --baseline <file>  compare with a previous JSON output, fail if a cell is slower or allocates more\n");
+    printf("  --threshold <pct>  regression threshold of --baseline (default %.0f)\n", DEFAULT_THRESHOLD);
+}
+
+int main(int argc, char** argv)
+{
+    bench_options opt;
+    const char*   output    = NULL;
+    const char*   baseline  = NULL;
+    double        threshold = DEFAULT_THRESHOLD;
+
+    opt.time_ms = DEFAULT_TIME_MS;
+    opt.repeat  = DEFAULT_REPEAT;
+    opt.perf    = false;
+    opt.filter  = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_val = i + 1 < argc;
+        if (strcmp(argv[i], "--perf") == 0)
+            opt.perf = true;
+        else if (has_val && strcmp(argv[i], "--time") == 0)
+            opt.time_ms = atof(argv[++i]);
+        else if (has_val && strcmp(argv[i], "--repeat") == 0)
+            opt.repeat = atoi(argv[++i]);
+        else if (has_val && strcmp(argv[i], "--filter") == 0)
+            opt.filter = argv[++i];
+        else if (has_val && strcmp(argv[i], "--output") == 0)
+            output = argv[++i];
+        else if (has_val && strcmp(argv[i], "--baseline") == 0)
+            baseline = argv[++i];
+        else if (has_val && strcmp(argv[i], "--threshold") == 0)
+            threshold = atof(argv[++i]);
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (opt.repeat < 1 || opt.time_ms <= 0)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (opt.perf && !perf_open())
+    {
+        fprintf(stderr, "hardware counters are not available, running without them\n");
+        opt.perf = false;
+    }
+
+    mp_set_memory_functions(count_alloc, count_realloc, count_free);
+
+    std::vector<bench_result> results;
+    run_all(results, &opt);
+
+    FILE* f = stdout;
+    if (output != NULL && (f = fopen(output, "w")) == NULL)
+    {
+        perror(output);
+        return 1;
+    }
+    write_json(f, results);
+    if (f != stdout)
+        fclose(f);
+
+    if (baseline != NULL)
+        return compare(results, baseline, threshold) == 0 ? 0 : 1;
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Merge and report coverage databases of the reference model
+ *  History       :
+ */
+
+#include "fpu_cov.h"
+#include "fpu_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [--merge <db>] [--json <path>] [--unhit <op> <fmt>] <db>...\n", name);
+    printf("  <db>                coverage databases saved with +REFMODEL_COV, see fpu_cov.h\n");
+    printf("  --merge <db>        add the databases to <db>, created if needed\n");
+    printf("  --json <path>       write the closure of every group and its bins that were not hit\n");
+    printf("  --unhit <op> <fmt>  print the goals of a group that were not hit, <op> and <fmt> are names or codes\n");
+    printf("The closure of the sum of the databases is printed.\n");
+}
+
+static void print_unhit(int op, int fmt)
+{
+    char     name[96];
+    uint64_t unhit = 0;
+
+    printf("%s %s : goals not hit\n", fpu_op_name(op), fpu_fmt_name(fmt));
+    for (int point = 0; point < FPU_COV_POINT_NUM; point++)
+        for (int bin = fpu_cov_next_unhit(op, fmt, point, 0); bin >= 0; bin = fpu_cov_next_unhit(op, fmt, point, bin + 1))
+        {
+            printf("  %-10s %s\n", fpu_cov_point_name(point), fpu_cov_bin_name(name, sizeof(name), op, point, bin));
+            unhit++;
+        }
+    printf("%llu goals not hit\n", (unsigned long long) unhit);
+}
+
+int main(int argc, char** argv)
+{
+    const char*              merge_path = NULL;
+    const char*              json_path  = NULL;
+    int                      unhit_op = -1, unhit_fmt = -1;
+    std::vector<const char*> paths;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = val != NULL;
+
+        if (arg[0] != '-')
+        {
+            paths.push_back(arg);
+            continue;
+        }
+        if (ok && strcmp(arg, "--merge") == 0)
+            merge_path = val;
+        else if (ok && strcmp(arg, "--json") == 0)
+            json_path = val;
+        else if (ok && strcmp(arg, "--unhit") == 0 && i + 2 < argc)
+        {
+            unhit_op  = fpu_parse_code(val, fpu_op_name, FPU_OP_NUM);
+            unhit_fmt = fpu_parse_code(argv[i + 2], fpu_fmt_name, FPU_DST_FMT_NUM);
+            ok = unhit_op >= 0 && unhit_fmt >= 0;
+            i++;
+        }
+        else
+            ok = false;
+
+        if (!ok)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+    if (paths.empty())
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // Databases are only read, nothing is sampled by this process
+    fpu_cov_enable(false);
+
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        if (fpu_cov_load(paths[i]) != 0)
+            return 1;
+        if (merge_path != NULL && fpu_cov_merge(merge_path, paths[i]) != 0)
+            return 1;
+    }
+
+    if (fpu_cov_report(stdout, json_path) != 0)
+        return 1;
+    if (unhit_op >= 0)
+        print_unhit(unhit_op, unhit_fmt);
+    return 0;
+}
@@ -0,0 +1,525 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Evaluation of an operand stream in a sweep of floating point formats
+ *  History       :
+ */
+
+#include "operations.h"
+#include "fpu_exec.h"
+#include "fpu_util.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#define MAX_WIDTH       128 /**< widest format, its encoding fits in 4 dwords */
+#define MAX_EXP_BITS    30
+#define REF_PREC        256 /**< precision of the operands and of the reference results */
+#define LINE_SIZE       1024
+
+typedef enum
+{
+    OP_ADD = 0,
+    OP_SUB,
+    OP_MUL,
+    OP_DIV,
+    OP_SQRT,
+    OP_FMA,
+    OP_NUM
+} explore_op_e;
+
+static const char* op_names[OP_NUM] = { "add", "sub", "mul", "div", "sqrt", "fma" };
+static const int   op_arity[OP_NUM] = { 2, 2, 2, 2, 1, 3 };
+
+/**
+ * \brief One operation of the stream, operands and reference result at REF_PREC bits
+ */
+typedef struct
+{
+    int    op;
+    mpfr_t x[3];
+    mpfr_t ref;
+} sample;
+
+/**
+ * \brief Statistics of a format over the stream
+ */
+typedef struct
+{
+    int         width;
+    int         exp_bits;
+    environment env;
+    long        ops;
+    long        flags[5];       /**< operations raising NX, UF, OF, DZ, NV */
+    long        in_flags[5];    /**< operations with an operand raising NX, UF, OF when rounded to the format */
+    long        measured;       /**< operations with a finite result and a finite non-zero reference */
+    double      err_sum;        /**< sum of the relative errors against the reference */
+    double      err_max;
+} format_stats;
+
+static void usage(const char* name)
+{
+    printf("Usage: %s (--input <file> | --random <n>) (--fmt <w:e> | --sweep <w0-w1:e0-e1>)... [options]\n", name);
+    printf("  --input <file>       one operation per line : add|sub|mul|div|sqrt|fma <operand>...\n");
+    printf("                       operands are real values (1.5, -3e-7, inf, nan) or 0x encodings in the source format\n");
+    printf("  --src <w:e>          format of the 0x operands (default 64:11)\n");
+    printf("  --random <n>         n random operations, operands with a 53-bit significand\n");
+    printf("  --ops <op,...>       operations of --random (default add,sub,mul,div,sqrt,fma)\n");
+    printf("  --exp <lo:hi>        binary exponent range of the --random operands (default -20:20)\n");
+    printf("  --seed <s>           seed of --random (default 1)\n");
+    printf("  --fmt <w:e>          target format of w bits with e exponent bits, e.g. 16:5\n");
+    printf("  --sweep <w0-w1:e0-e1> every target format of w0 to w1 bits with e0 to e1 exponent bits\n");
+    printf("  --rm <rne|rtz|rdn|rup> rounding mode (default rne)\n");
+    printf("  --threads <n>        worker threads (default: hardware threads)\n");
+    printf("  --csv <file>         also write the statistics as CSV\n");
+}
+
+//########## MPFR HELPERS ##############################################################################################
+
+static void set_unbounded_range()
+{
+    mpfr_set_emin(mpfr_get_emin_min());
+    mpfr_set_emax(mpfr_get_emax_max());
+}
+
+// Round a value to the format as fcvt_f2f does, return the flags of the conversion
+static int quantize(uint32_t* enc, mpfr_t value, environment env, mpfr_rnd_t rnd)
+{
+    mpfr_t x;
+
+    set_unbounded_range();
+    mpfr_init2(x, MBITS(env) + 1);
+    mpfr_clear_flags();
+    int inex = mpfr_set(x, value, rnd);
+
+    IEEElike_set_exp_range(env.es, MBITS(env));
+    inex = mpfr_check_range(x, inex, rnd);
+    mpfr_subnormalize(x, inex, rnd);
+    mpfr2IEEElike(enc, x, env, rnd, false);
+    mpfr_clear(x);
+    return get_flags(false, false);
+}
+
+// Relative error of an encoding against the reference, -1 if not measured
+static double rel_error(const uint32_t* enc, mpfr_t ref, environment env)
+{
+    mpfr_t y, d;
+
+    if (!mpfr_regular_p(ref))
+        return -1;
+
+    IEEElike_set_exp_range(env.es, MBITS(env));
+    IEEElike2mpfr(y, enc, env, MPFR_RNDN, 0, false);
+    set_unbounded_range();
+
+    double err = -1;
+    if (mpfr_number_p(y))
+    {
+        mpfr_init2(d, 64);
+        mpfr_sub(d, y, ref, MPFR_RNDN);
+        mpfr_div(d, d, ref, MPFR_RNDN);
+        err = fabs(mpfr_get_d(d, MPFR_RNDN));
+        mpfr_clear(d);
+    }
+    mpfr_clear(y);
+    return err;
+}
+
+//########## OPERAND STREAM ############################################################################################
+
+static bool parse_format(const char* s, int* width, int* exp_bits)
+{
+    return sscanf(s, "%d:%d", width, exp_bits) == 2;
+}
+
+static bool valid_format(int width, int exp_bits)
+{
+    return exp_bits >= 2 && exp_bits <= MAX_EXP_BITS && width <= MAX_WIDTH && width - exp_bits - 1 >= 1;
+}
+
+static environment make_env(int width, int exp_bits)
+{
+    environment env;
+    env.bis = width - 1;
+    env.es  = exp_bits - 1;
+    return env;
+}
+
+static int find_op(const char* name)
+{
+    for (int op = 0; op < OP_NUM; op++)
+        if (strcmp(name, op_names[op]) == 0)
+            return op;
+    return -1;
+}
+
+// Set an operand from a real value or from a 0x encoding in the source format
+static bool parse_operand(mpfr_t x, const char* token, environment src)
+{
+    if (strncmp(token, "0x", 2) == 0 || strncmp(token, "0X", 2) == 0)
+    {
+        char* end;
+        uint64_t bits = strtoull(token + 2, &end, 16);
+        if (*end != '\0' || (src.bis < 63 && (bits >> (src.bis + 1)) != 0))
+            return false;
+
+        uint32_t enc[2] = { (uint32_t) bits, (uint32_t) (bits >> 32) };
+        IEEElike_set_exp_range(src.es, MBITS(src));
+        IEEElike2mpfr(x, enc, src, MPFR_RNDN, REF_PREC, false);
+        set_unbounded_range();
+        return true;
+    }
+
+    mpfr_init2(x, REF_PREC);
+    return mpfr_set_str(x, token, 10, MPFR_RNDN) == 0;
+}
+
+static bool read_stream(std::vector<sample>& samples, const char* path, environment src)
+{
+    FILE* f = fopen(path, "r");
+    if (f == NULL)
+    {
+        perror(path);
+        return false;
+    }
+
+    char line[LINE_SIZE];
+    int  line_number = 0;
+    bool ok = true;
+
+    while (ok && fgets(line, sizeof(line), f) != NULL)
+    {
+        line_number++;
+        char name[16], tokens[3][LINE_SIZE];
+        int n = sscanf(line, "%15s %1023s %1023s %1023s", name, tokens[0], tokens[1], tokens[2]);
+        if (n <= 0 || name[0] == '#')
+            continue;
+
+        int op = find_op(name);
+        if (op < 0 || n - 1 != op_arity[op])
+        {
+            fprintf(stderr, "%s:%d: expected <op> and its operands\n", path, line_number);
+            ok = false;
+            break;
+        }
+
+        samples.push_back(sample());
+        sample* s = &samples.back();
+        s->op = op;
+        for (int i = 0; i < op_arity[op]; i++)
+            if (!parse_operand(s->x[i], tokens[i], src))
+            {
+                fprintf(stderr, "%s:%d: invalid operand %s\n", path, line_number, tokens[i]);
+                ok = false;
+            }
+    }
+    fclose(f);
+    return ok;
+}
+
+static void random_stream(std::vector<sample>& samples, long n, const std::vector<int>& ops, int exp_lo, int exp_hi, uint64_t seed)
+{
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<int> exp_dist(exp_lo, exp_hi);
+
+    samples.resize(n);
+    for (long k = 0; k < n; k++)
+    {
+        sample* s = &samples[k];
+        s->op = ops[gen() % ops.size()];
+        for (int i = 0; i < op_arity[s->op]; i++)
+        {
+            double v = ldexp((double) ((gen() >> 11) | (1ULL << 52)), exp_dist(gen) - 52);
+            if (s->op != OP_SQRT && (gen() & 1))
+                v = -v;
+            mpfr_init2(s->x[i], REF_PREC);
+            mpfr_set_d(s->x[i], v, MPFR_RNDN);
+        }
+    }
+}
+
+static void compute_references(std::vector<sample>& samples)
+{
+    set_unbounded_range();
+    for (size_t k = 0; k < samples.size(); k++)
+    {
+        sample* s = &samples[k];
+        mpfr_init2(s->ref, REF_PREC);
+        switch (s->op)
+        {
+        case OP_ADD:  mpfr_add(s->ref, s->x[0], s->x[1], MPFR_RNDN); break;
+        case OP_SUB:  mpfr_sub(s->ref, s->x[0], s->x[1], MPFR_RNDN); break;
+        case OP_MUL:  mpfr_mul(s->ref, s->x[0], s->x[1], MPFR_RNDN); break;
+        case OP_DIV:  mpfr_div(s->ref, s->x[0], s->x[1], MPFR_RNDN); break;
+        case OP_SQRT: mpfr_sqrt(s->ref, s->x[0], MPFR_RNDN);         break;
+        case OP_FMA:  mpfr_fma(s->ref, s->x[0], s->x[1], s->x[2], MPFR_RNDN); break;
+        }
+    }
+}
+
+//########## EVALUATION ################################################################################################
+
+// Evaluate the stream in a format with the operations of the model
+static void evaluate(format_stats* st, const std::vector<sample>& samples, mpfr_rnd_t rnd)
+{
+    environment env = st->env;
+
+    for (size_t k = 0; k < samples.size(); k++)
+    {
+        const sample* s = &samples[k];
+        uint32_t enc[3][4];
+        uint32_t res[4] = { 0, 0, 0, 0 };
+        int in_flags = 0;
+
+        for (int i = 0; i < op_arity[s->op]; i++)
+        {
+            memset(enc[i], 0, sizeof(enc[i]));
+            in_flags |= quantize(enc[i], (mpfr_ptr) s->x[i], env, rnd);
+        }
+
+        int flags = 0;
+        switch (s->op)
+        {
+        case OP_ADD:  flags = add (res, enc[0], enc[1], rnd, env);         break;
+        case OP_SUB:  flags = sub (res, enc[0], enc[1], rnd, env);         break;
+        case OP_MUL:  flags = mul (res, enc[0], enc[1], rnd, env);         break;
+        case OP_DIV:  flags = div (res, enc[0], enc[1], rnd, env);         break;
+        case OP_SQRT: flags = sqrt(res, enc[0], rnd, env);                 break;
+        case OP_FMA:  flags = fma (res, enc[0], enc[1], enc[2], rnd, env); break;
+        }
+
+        st->ops++;
+        for (int bit = 0; bit < 5; bit++)
+        {
+            st->flags[bit]    += (flags >> bit) & 1;
+            st->in_flags[bit] += (in_flags >> bit) & 1;
+        }
+
+        double err = rel_error(res, (mpfr_ptr) s->ref, env);
+        if (err >= 0)
+        {
+            st->measured++;
+            st->err_sum += err;
+            if (err > st->err_max)
+                st->err_max = err;
+        }
+    }
+}
+
+static void worker(std::vector<format_stats>* formats, const std::vector<sample>* samples, mpfr_rnd_t rnd, std::atomic<size_t>* next)
+{
+    size_t index;
+    while ((index = next->fetch_add(1)) < formats->size())
+        evaluate(&(*formats)[index], *samples, rnd);
+    mpfr_free_cache();
+}
+
+//########## REPORT ####################################################################################################
+
+static double percent(long count, long total)
+{
+    return total ? 100.0 * count / total : 0.0;
+}
+
+// Bits of relative accuracy guaranteed by the largest error
+static double accuracy_bits(double err_max)
+{
+    return err_max > 0 ? 0.0 - log2(err_max) : INFINITY;
+}
+
+static void report(const std::vector<format_stats>& formats, FILE* csv)
+{
+    printf("%-7s %10s %7s %7s %7s %7s %7s %8s %8s %8s %11s %11s %6s\n", "format", "ops", "NX%", "UF%", "OF%", "DZ%",
+           "NV%", "inNX%", "inUF%", "inOF%", "mean-err", "max-err", "bits");
+    if (csv != NULL)
+        fprintf(csv, "width,exp_bits,ops,nx,uf,of,dz,nv,in_nx,in_uf,in_of,measured,mean_err,max_err\n");
+
+    for (size_t k = 0; k < formats.size(); k++)
+    {
+        const format_stats* st = &formats[k];
+        char name[16];
+        double mean = st->measured ? st->err_sum / st->measured : 0.0;
+
+        snprintf(name, sizeof(name), "%d:%d", st->width, st->exp_bits);
+        printf("%-7s %10ld %7.3f %7.3f %7.3f %7.3f %7.3f %8.3f %8.3f %8.3f %11.3e %11.3e %6.1f\n", name, st->ops,
+               percent(st->flags[0], st->ops), percent(st->flags[1], st->ops), percent(st->flags[2], st->ops),
+               percent(st->flags[3], st->ops), percent(st->flags[4], st->ops), percent(st->in_flags[0], st->ops),
+               percent(st->in_flags[1], st->ops), percent(st->in_flags[2], st->ops), mean, st->err_max,
+               accuracy_bits(st->err_max));
+        if (csv != NULL)
+            fprintf(csv, "%d,%d,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%.6e,%.6e\n", st->width, st->exp_bits, st->ops,
+                    st->flags[0], st->flags[1], st->flags[2], st->flags[3], st->flags[4], st->in_flags[0],
+                    st->in_flags[1], st->in_flags[2], st->measured, mean, st->err_max);
+    }
+}
+
+//########## MAIN ######################################################################################################
+
+static void add_format(std::vector<format_stats>& formats, int width, int exp_bits)
+{
+    format_stats st;
+    memset(&st, 0, sizeof(st));
+    st.width    = width;
+    st.exp_bits = exp_bits;
+    st.env      = make_env(width, exp_bits);
+    formats.push_back(st);
+}
+
+int main(int argc, char** argv)
+{
+    const char* input = NULL;
+    const char* csv_path = NULL;
+    long        random = 0;
+    int         exp_lo = -20, exp_hi = 20;
+    uint64_t    seed = 1;
+    int         rm = 0;
+    int         threads = std::thread::hardware_concurrency();
+    environment src = make_env(64, 11);
+    std::vector<int> ops;
+    std::vector<format_stats> formats;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        int w0, w1, e0, e1;
+        bool ok = val != NULL;
+
+        if (ok && strcmp(arg, "--input") == 0)
+            input = val;
+        else if (ok && strcmp(arg, "--csv") == 0)
+            csv_path = val;
+        else if (ok && strcmp(arg, "--random") == 0)
+            ok = (random = atol(val)) > 0;
+        else if (ok && strcmp(arg, "--seed") == 0)
+            seed = strtoull(val, NULL, 0);
+        else if (ok && strcmp(arg, "--threads") == 0)
+            ok = (threads = atoi(val)) > 0;
+        else if (ok && strcmp(arg, "--exp") == 0)
+            ok = sscanf(val, "%d:%d", &exp_lo, &exp_hi) == 2 && exp_lo <= exp_hi && exp_lo >= -1000 && exp_hi <= 1000;
+        else if (ok && strcmp(arg, "--src") == 0)
+        {
+            ok = parse_format(val, &w0, &e0) && valid_format(w0, e0) && w0 <= 64;
+            src = make_env(w0, e0);
+        }
+        else if (ok && strcmp(arg, "--rm") == 0)
+        {
+            static const char* rm_names[4] = { "rne", "rtz", "rdn", "rup" };
+            for (rm = 0; rm < 4 && strcmp(val, rm_names[rm]) != 0; rm++)
+                ;
+            ok = rm < 4;
+        }
+        else if (ok && strcmp(arg, "--ops") == 0)
+        {
+            char list[LINE_SIZE];
+            snprintf(list, sizeof(list), "%s", val);
+            for (char* name = strtok(list, ","); ok && name != NULL; name = strtok(NULL, ","))
+            {
+                int op = find_op(name);
+                ok = op >= 0;
+                ops.push_back(op);
+            }
+        }
+        else if (ok && strcmp(arg, "--fmt") == 0)
+        {
+            ok = parse_format(val, &w0, &e0) && valid_format(w0, e0);
+            if (ok)
+                add_format(formats, w0, e0);
+        }
+        else if (ok && strcmp(arg, "--sweep") == 0)
+        {
+            ok = sscanf(val, "%d-%d:%d-%d", &w0, &w1, &e0, &e1) == 4 && w0 <= w1 && e0 <= e1;
+            for (int w = w0; ok && w <= w1; w++)
+                for (int e = e0; e <= e1; e++)
+                    if (valid_format(w, e))
+                        add_format(formats, w, e);
+        }
+        else
+            ok = false;
+
+        if (!ok)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+
+    if ((input == NULL) == (random == 0) || formats.empty())
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    threads = fpu_mpfr_threads(threads);
+
+    std::vector<sample> samples;
+    if (input != NULL)
+    {
+        if (!read_stream(samples, input, src))
+            return 1;
+    }
+    else
+    {
+        if (ops.empty())
+            for (int op = 0; op < OP_NUM; op++)
+                ops.push_back(op);
+        random_stream(samples, random, ops, exp_lo, exp_hi, seed);
+    }
+    compute_references(samples);
+
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> pool;
+    mpfr_rnd_t rnd = rnd_rtl_to_c(rm);
+
+    if ((size_t) threads > formats.size())
+        threads = formats.size();
+    for (int t = 1; t < threads; t++)
+        pool.push_back(std::thread(worker, &formats, &samples, rnd, &next));
+    worker(&formats, &samples, rnd, &next);
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+
+    FILE* csv = NULL;
+    if (csv_path != NULL && (csv = fopen(csv_path, "w")) == NULL)
+    {
+        perror(csv_path);
+        return 1;
+    }
+    printf("%zu operations, %zu formats, %s\n", samples.size(), formats.size(), mpfr_print_rnd_mode(rnd));
+    report(formats, csv);
+    if (csv != NULL)
+        fclose(csv);
+
+    for (size_t k = 0; k < samples.size(); k++)
+    {
+        for (int i = 0; i < op_arity[samples[k].op]; i++)
+            mpfr_clear(samples[k].x[i]);
+        mpfr_clear(samples[k].ref);
+    }
+    return 0;
+}
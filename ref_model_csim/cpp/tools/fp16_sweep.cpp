@@ -0,0 +1,711 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Exhaustive sweep of the FP16 binary operations, comparison of the MPFR and integer operations or
+ *                  golden file of the results
+ *  History       :
+ */
+
+#include "fpu_exec.h"
+#include "intfp.h"
+#include "operations.h"
+#include "fpu_util.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define CHUNK_A             16                      /**< values of the first operand in a chunk */
+#define CHUNK_PAIRS         (CHUNK_A << 16)         /**< operand pairs of a chunk */
+#define PASS_CHUNKS         (65536 / CHUNK_A)       /**< chunks of a pass, i.e. of an (operation, rounding mode) pair */
+#define GOLDEN_MAGIC        0x444C4F4736315046ULL   /**< "FP16GOLD" */
+#define CHECKPOINT_MAGIC    0x54504B4336315046ULL   /**< "FP16CKPT" */
+#define SWEEP_VERSION       1
+#define CHECKPOINT_INTERVAL 60                      /**< seconds between two checkpoints */
+#define DEFAULT_SHOW        20                      /**< mismatches printed */
+
+static const environment half_env = HALF_ENV_INITIALIZER;
+
+typedef enum
+{
+    OP_ADD = 0, OP_SUB, OP_MUL, OP_DIV, OP_CMP_LEQ, OP_CMP_LT, OP_CMP_EQ, OP_FMIN, OP_FMAX, OP_NUM
+} sweep_op_e;
+
+static const char* op_names[OP_NUM] = { "add", "sub", "mul", "div", "cmp_leq", "cmp_lt", "cmp_eq", "fmin", "fmax" };
+static const bool  op_rounds[OP_NUM] = { true, true, true, true, false, false, false, false, false };
+
+// RMM is left out, the MPFR operations do not support it
+#define SWEEP_RM_NUM 4
+static const char* rm_names[SWEEP_RM_NUM] = { "rne", "rtz", "rdn", "rup" };
+
+typedef enum { BACKEND_MPFR = 0, BACKEND_INTFP, BACKEND_NUM } backend_e;
+
+static const char* backend_names[BACKEND_NUM] = { "mpfr", "intfp" };
+
+typedef enum { MODE_COMPARE = 0, MODE_RECORD, MODE_AGAINST } mode_e;
+
+static void usage(const char* name)
+{
+    printf("Usage: %s (--compare | --record <file> | --against <file>) [options]\n", name);
+    printf("  --compare            compare the MPFR operations with the integer ones (intfp.h)\n");
+    printf("  --record <file>      write the results of --backend to a golden file\n");
+    printf("  --against <file>     compare --backend with a golden file, on the operations it holds\n");
+    printf("  --backend <name>     mpfr or intfp, model of --record and --against (default mpfr)\n");
+    printf("  --ops <op,...>       operations (default add,sub,mul,div,cmp_leq,cmp_lt,cmp_eq,fmin,fmax)\n");
+    printf("  --rm <rm,...>        rounding modes of the operations that round (default rne,rtz,rdn,rup)\n");
+    printf("  --range <lo:hi>      encodings of the first operand, in hexadecimal (default 0:ffff), e.g. to share a\n");
+    printf("                       sweep between machines\n");
+    printf("  --threads <n>        worker threads (default: hardware threads)\n");
+    printf("  --checkpoint <file>  save the progress every %d s and on SIGINT, resume from it when it exists\n", CHECKPOINT_INTERVAL);
+    printf("  --progress <s>       seconds between two progress lines (default %d, 0 for none)\n", FPU_DEFAULT_PROGRESS);
+    printf("  --show <n>           mismatches printed (default %d)\n", DEFAULT_SHOW);
+    printf("Every pair of FP16 operands is evaluated, i.e. 2^32 pairs per operation and rounding mode. The exit status\n");
+    printf("is 1 on a mismatch, 3 if the sweep was interrupted.\n");
+}
+
+//########## BACKENDS ##################################################################################################
+
+static int eval_mpfr(int op, uint32_t a, uint32_t b, int rm, uint16_t* result)
+{
+    uint32_t   x[2] = { a, 0 }, y[2] = { b, 0 }, r[2] = { 0, 0 };
+    mpfr_rnd_t rnd = rnd_rtl_to_c(rm);
+    int        flags;
+
+    switch (op)
+    {
+    case OP_ADD:     flags = add(r, x, y, rnd, half_env);  break;
+    case OP_SUB:     flags = sub(r, x, y, rnd, half_env);  break;
+    case OP_MUL:     flags = mul(r, x, y, rnd, half_env);  break;
+    case OP_DIV:     flags = div(r, x, y, rnd, half_env);  break;
+    case OP_CMP_LEQ: flags = cmp_leq(r, x, y, half_env);   break;
+    case OP_CMP_LT:  flags = cmp_lt(r, x, y, half_env);    break;
+    case OP_CMP_EQ:  flags = cmp_eq(r, x, y, half_env);    break;
+    case OP_FMIN:    flags = fmin(r, x, y, rnd, half_env); break;
+    default:         flags = fmax(r, x, y, rnd, half_env); break;
+    }
+    *result = r[0] & 0xFFFF;
+    return flags;
+}
+
+static int eval_intfp(int op, uint32_t a, uint32_t b, int rm, uint16_t* result)
+{
+    uint64_t r = 0;
+    int      flags;
+
+    switch (op)
+    {
+    case OP_ADD:     flags = intfp_add(&r, a, b, rm, half_env); break;
+    case OP_SUB:     flags = intfp_sub(&r, a, b, rm, half_env); break;
+    case OP_MUL:     flags = intfp_mul(&r, a, b, rm, half_env); break;
+    case OP_DIV:     flags = intfp_div(&r, a, b, rm, half_env); break;
+    case OP_CMP_LEQ: flags = intfp_cmp_leq(&r, a, b, half_env); break;
+    case OP_CMP_LT:  flags = intfp_cmp_lt(&r, a, b, half_env);  break;
+    case OP_CMP_EQ:  flags = intfp_cmp_eq(&r, a, b, half_env);  break;
+    case OP_FMIN:    flags = intfp_fmin(&r, a, b, half_env);    break;
+    default:         flags = intfp_fmax(&r, a, b, half_env);    break;
+    }
+    *result = r & 0xFFFF;
+    return flags;
+}
+
+// Results and flags of the pairs (a0 + i / 65536, i % 65536) of a chunk
+static void eval_chunk(int backend, int op, int rm, uint32_t a0, uint16_t* results, uint8_t* flags)
+{
+    for (uint32_t i = 0; i < CHUNK_PAIRS; i++)
+        flags[i] = (backend == BACKEND_MPFR ? eval_mpfr : eval_intfp)(op, a0 + (i >> 16), i & 0xFFFF, rm, &results[i]);
+}
+
+//########## GOLDEN FILE ###############################################################################################
+
+/*
+ * A golden file is a header followed by chunks in completion order. A chunk is a chunk header followed by the encoding
+ * of its results : the difference of each result with the previous one, zigzag and LEB128 coded, then the runs of
+ * identical flags, as a flags byte and the LEB128 coded length of the run.
+ */
+
+typedef struct
+{
+    uint64_t magic;         /**< GOLDEN_MAGIC */
+    uint32_t version;       /**< SWEEP_VERSION */
+    uint32_t chunk_pairs;   /**< CHUNK_PAIRS */
+    uint32_t ops;           /**< mask of the operations, bit k for sweep_op_e k */
+    uint32_t rms;           /**< mask of the rounding modes of the operations that round */
+    uint32_t backend;       /**< backend_e of the results */
+    uint32_t range;         /**< first operands of the sweep, lo | hi << 16 */
+    uint32_t reserved[8];
+} golden_header;
+
+typedef struct
+{
+    uint32_t task;          /**< pass * PASS_CHUNKS + chunk */
+    uint32_t nbytes;        /**< size of the encoding */
+} golden_chunk;
+
+static inline uint8_t* put_varint(uint8_t* p, uint32_t v)
+{
+    while (v >= 0x80)
+    {
+        *p++ = (v & 0x7F) | 0x80;
+        v >>= 7;
+    }
+    *p++ = v;
+    return p;
+}
+
+static inline const uint8_t* get_varint(const uint8_t* p, const uint8_t* end, uint32_t* v)
+{
+    *v = 0;
+    for (int shift = 0; p < end && shift < 35; shift += 7)
+    {
+        *v |= (uint32_t) (*p & 0x7F) << shift;
+        if (!(*p++ & 0x80))
+            return p;
+    }
+    return NULL;
+}
+
+// Encode a chunk, out holds at least 8 * CHUNK_PAIRS bytes
+static uint32_t golden_encode(uint8_t* out, const uint16_t* results, const uint8_t* flags)
+{
+    uint8_t* p = out;
+    uint16_t prev = 0;
+    for (int i = 0; i < CHUNK_PAIRS; i++)
+    {
+        int16_t d = (int16_t) (results[i] - prev);
+        p = put_varint(p, ((uint32_t) d << 1) ^ (uint32_t) (d >> 15));
+        prev = results[i];
+    }
+    for (int i = 0; i < CHUNK_PAIRS;)
+    {
+        int run = 1;
+        while (i + run < CHUNK_PAIRS && flags[i + run] == flags[i])
+            run++;
+        *p++ = flags[i];
+        p = put_varint(p, run);
+        i += run;
+    }
+    return p - out;
+}
+
+static bool golden_decode(uint16_t* results, uint8_t* flags, const uint8_t* in, uint32_t nbytes)
+{
+    const uint8_t* p = in;
+    const uint8_t* end = in + nbytes;
+    uint16_t prev = 0;
+    uint32_t v;
+    for (int i = 0; i < CHUNK_PAIRS; i++)
+    {
+        if ((p = get_varint(p, end, &v)) == NULL)
+            return false;
+        prev += (uint16_t) ((v >> 1) ^ -(v & 1));
+        results[i] = prev;
+    }
+    for (int i = 0; i < CHUNK_PAIRS;)
+    {
+        if (p >= end)
+            return false;
+        uint8_t f = *p++;
+        if ((p = get_varint(p, end, &v)) == NULL || v == 0 || v > (uint32_t) (CHUNK_PAIRS - i))
+            return false;
+        memset(&flags[i], f, v);
+        i += v;
+    }
+    return p == end;
+}
+
+//########## SWEEP #####################################################################################################
+
+typedef struct
+{
+    int op, rm;
+} pass;
+
+typedef struct
+{
+    uint32_t task;          /**< pass * PASS_CHUNKS + chunk */
+    off_t    offset;        /**< --against : offset of the encoding in the golden file */
+    uint32_t nbytes;
+} task_ref;
+
+// State shared by the workers
+typedef struct
+{
+    int                   mode;
+    int                   backend;
+    std::vector<pass>     passes;
+    std::vector<task_ref> tasks;
+    std::vector<uint8_t>  done;         /**< per task id, 1 when the chunk is checked or written */
+    std::vector<uint64_t> mismatches;   /**< per pass */
+    long                  show;
+    int                   golden_fd;
+    off_t                 golden_size;  /**< --record : size of the golden file with the chunks of done tasks */
+    std::atomic<size_t>   next;
+    std::atomic<uint64_t> pairs;        /**< pairs evaluated by this run */
+    std::mutex            mutex;        /**< done, mismatches, shown, golden file and checkpoint */
+    long                  shown;
+} sweep_state;
+
+static std::atomic<bool> interrupted(false);
+
+static void on_sigint(int)
+{
+    interrupted.store(true);
+}
+
+static bool read_at(int fd, void* data, size_t size, off_t offset)
+{
+    return pread(fd, data, size, offset) == (ssize_t) size;
+}
+
+static void worker(sweep_state* st)
+{
+    std::vector<uint16_t> results(CHUNK_PAIRS), expected(CHUNK_PAIRS);
+    std::vector<uint8_t>  flags(CHUNK_PAIRS), expected_flags(CHUNK_PAIRS);
+    std::vector<uint8_t>  buffer(sizeof(golden_chunk) + 8 * CHUNK_PAIRS);
+
+    for (size_t k = st->next++; k < st->tasks.size() && !interrupted.load(); k = st->next++)
+    {
+        const task_ref* t = &st->tasks[k];
+        if (st->done[t->task])
+            continue;
+
+        const pass* p  = &st->passes[t->task / PASS_CHUNKS];
+        uint32_t    a0 = (t->task % PASS_CHUNKS) * CHUNK_A;
+
+        eval_chunk(st->mode == MODE_COMPARE ? BACKEND_MPFR : st->backend, p->op, p->rm, a0, &results[0], &flags[0]);
+
+        uint32_t nbytes = 0;
+        bool     valid  = true;
+        if (st->mode == MODE_COMPARE)
+            eval_chunk(BACKEND_INTFP, p->op, p->rm, a0, &expected[0], &expected_flags[0]);
+        else if (st->mode == MODE_AGAINST)
+            valid = read_at(st->golden_fd, &buffer[0], t->nbytes, t->offset) &&
+                    golden_decode(&expected[0], &expected_flags[0], &buffer[0], t->nbytes);
+        else
+        {
+            golden_chunk* h = (golden_chunk*) &buffer[0];
+            h->task   = t->task;
+            h->nbytes = golden_encode(&buffer[sizeof(golden_chunk)], &results[0], &flags[0]);
+            nbytes    = sizeof(golden_chunk) + h->nbytes;
+        }
+
+        uint64_t mismatches = 0;
+        std::lock_guard<std::mutex> lock(st->mutex);
+        if (!valid)
+        {
+            fprintf(stderr, "chunk %u of the golden file cannot be read, skipped\n", t->task);
+            continue;
+        }
+        if (st->mode == MODE_RECORD)
+        {
+            if (!fpu_write_all(st->golden_fd, &buffer[0], nbytes))
+            {
+                fprintf(stderr, "cannot write the golden file\n");
+                interrupted.store(true);
+                return;
+            }
+            st->golden_size += nbytes;
+        }
+        else
+            for (uint32_t i = 0; i < CHUNK_PAIRS; i++)
+                if (results[i] != expected[i] || flags[i] != expected_flags[i])
+                {
+                    mismatches++;
+                    if (st->shown++ < st->show)
+                        printf("  %s %s 0x%04x 0x%04x : %s 0x%04x/0x%02x, %s 0x%04x/0x%02x\n", op_names[p->op],
+                               op_rounds[p->op] ? rm_names[p->rm] : "-", a0 + (i >> 16), i & 0xFFFF,
+                               st->mode == MODE_COMPARE ? "mpfr" : backend_names[st->backend], results[i], flags[i],
+                               st->mode == MODE_COMPARE ? "intfp" : "golden", expected[i], expected_flags[i]);
+                }
+        st->mismatches[t->task / PASS_CHUNKS] += mismatches;
+        st->done[t->task] = 1;
+        st->pairs += CHUNK_PAIRS;
+    }
+}
+
+//########## CHECKPOINT ################################################################################################
+
+/*
+ * A checkpoint is a header, the mismatches of each pass, then one byte per task id set when the task is done. The
+ * golden file of --record is truncated to the size saved in the checkpoint when resuming, which drops the chunks written
+ * after it.
+ */
+
+typedef struct
+{
+    uint64_t magic;         /**< CHECKPOINT_MAGIC */
+    uint32_t version;       /**< SWEEP_VERSION */
+    uint32_t mode;
+    uint32_t backend;
+    uint32_t npasses;
+    uint64_t passes_hash;   /**< of the (operation, rounding mode) list and of the tasks */
+    uint64_t golden_size;
+} checkpoint_header;
+
+static uint64_t passes_hash(const sweep_state* st)
+{
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t k = 0; k < st->passes.size(); k++)
+        h = (h ^ (st->passes[k].op << 8 | st->passes[k].rm)) * 1099511628211ULL;
+    for (size_t k = 0; k < st->tasks.size(); k++)
+        h = (h ^ st->tasks[k].task) * 1099511628211ULL;
+    return h;
+}
+
+// Called with the mutex held, or after the workers are joined
+static bool checkpoint_save(sweep_state* st, const char* path)
+{
+    std::string tmp = std::string(path) + ".tmp";
+    checkpoint_header h;
+    memset(&h, 0, sizeof(h));
+    h.magic       = CHECKPOINT_MAGIC;
+    h.version     = SWEEP_VERSION;
+    h.mode        = st->mode;
+    h.backend     = st->backend;
+    h.npasses     = st->passes.size();
+    h.passes_hash = passes_hash(st);
+    h.golden_size = st->golden_size;
+
+    int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    bool ok = fd >= 0 && fpu_write_all(fd, &h, sizeof(h)) &&
+              fpu_write_all(fd, &st->mismatches[0], st->mismatches.size() * sizeof(uint64_t)) &&
+              fpu_write_all(fd, &st->done[0], st->done.size()) && fsync(fd) == 0;
+    if (st->mode == MODE_RECORD)
+        ok = ok && fsync(st->golden_fd) == 0;
+    if (fd >= 0)
+        close(fd);
+    if (!ok || rename(tmp.c_str(), path) != 0)
+    {
+        fprintf(stderr, "cannot write the checkpoint %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+// Return 1 if resumed, 0 if there is no checkpoint, -1 if it does not match the sweep
+static int checkpoint_load(sweep_state* st, const char* path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return 0;
+
+    checkpoint_header h;
+    bool ok = read_at(fd, &h, sizeof(h), 0) && h.magic == CHECKPOINT_MAGIC && h.version == SWEEP_VERSION &&
+              h.mode == (uint32_t) st->mode && h.backend == (uint32_t) st->backend &&
+              h.npasses == st->passes.size() && h.passes_hash == passes_hash(st) &&
+              read_at(fd, &st->mismatches[0], st->mismatches.size() * sizeof(uint64_t), sizeof(h)) &&
+              read_at(fd, &st->done[0], st->done.size(), sizeof(h) + st->mismatches.size() * sizeof(uint64_t));
+    close(fd);
+    if (!ok)
+    {
+        fprintf(stderr, "%s : not a checkpoint of this sweep\n", path);
+        return -1;
+    }
+    st->golden_size = h.golden_size;
+    return 1;
+}
+
+//########## MAIN ######################################################################################################
+
+// Parse a comma separated list of names into a mask
+static bool parse_list(const char* list, const char* const* names, int num, uint32_t* mask)
+{
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", list);
+    *mask = 0;
+    for (char* name = strtok(buf, ","); name != NULL; name = strtok(NULL, ","))
+    {
+        int k = 0;
+        while (k < num && strcmp(name, names[k]) != 0)
+            k++;
+        if (k == num)
+            return false;
+        *mask |= 1u << k;
+    }
+    return *mask != 0;
+}
+
+// Operations that do not round are swept once
+static void make_passes(std::vector<pass>& passes, uint32_t ops, uint32_t rms)
+{
+    for (int op = 0; op < OP_NUM; op++)
+        if ((ops >> op) & 1)
+            for (int rm = 0; rm < SWEEP_RM_NUM; rm++)
+                if (op_rounds[op] ? (rms >> rm) & 1 : rm == 0)
+                {
+                    pass p = { op, rm };
+                    passes.push_back(p);
+                }
+}
+
+// Index the chunks of a golden file
+static bool golden_index(sweep_state* st, const char* path, uint32_t* ops, uint32_t* rms)
+{
+    golden_header h;
+    if (!read_at(st->golden_fd, &h, sizeof(h), 0) || h.magic != GOLDEN_MAGIC || h.version != SWEEP_VERSION ||
+        h.chunk_pairs != CHUNK_PAIRS)
+    {
+        fprintf(stderr, "%s : not a golden file of version %d\n", path, SWEEP_VERSION);
+        return false;
+    }
+    *ops = h.ops;
+    *rms = h.rms;
+    make_passes(st->passes, h.ops, h.rms);
+
+    off_t end = lseek(st->golden_fd, 0, SEEK_END);
+    off_t offset = sizeof(h);
+    golden_chunk c;
+    while (offset + (off_t) sizeof(c) <= end && read_at(st->golden_fd, &c, sizeof(c), offset))
+    {
+        if (c.task >= st->passes.size() * PASS_CHUNKS || offset + (off_t) sizeof(c) + c.nbytes > end)
+            break;
+        task_ref t = { c.task, offset + (off_t) sizeof(c), c.nbytes };
+        st->tasks.push_back(t);
+        offset += sizeof(c) + c.nbytes;
+    }
+    if (offset != end)
+        fprintf(stderr, "%s : truncated at offset %lld, the rest of the file is ignored\n", path, (long long) offset);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    int         mode = -1;
+    int         backend = BACKEND_MPFR;
+    int         threads = std::thread::hardware_concurrency();
+    long        progress = FPU_DEFAULT_PROGRESS;
+    long        show = DEFAULT_SHOW;
+    uint32_t    ops = (1u << OP_NUM) - 1, rms = (1u << SWEEP_RM_NUM) - 1;
+    const char* golden = NULL;
+    const char* checkpoint = NULL;
+    unsigned    a_lo = 0, a_hi = 0xFFFF;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = val != NULL;
+
+        if (strcmp(arg, "--compare") == 0)
+        {
+            mode = MODE_COMPARE;
+            continue;
+        }
+        if (ok && strcmp(arg, "--record") == 0)
+        {
+            mode = MODE_RECORD;
+            golden = val;
+        }
+        else if (ok && strcmp(arg, "--against") == 0)
+        {
+            mode = MODE_AGAINST;
+            golden = val;
+        }
+        else if (ok && strcmp(arg, "--backend") == 0)
+        {
+            for (backend = 0; backend < BACKEND_NUM && strcmp(val, backend_names[backend]) != 0; backend++)
+                ;
+            ok = backend < BACKEND_NUM;
+        }
+        else if (ok && strcmp(arg, "--ops") == 0)
+            ok = parse_list(val, op_names, OP_NUM, &ops);
+        else if (ok && strcmp(arg, "--rm") == 0)
+            ok = parse_list(val, rm_names, SWEEP_RM_NUM, &rms);
+        else if (ok && strcmp(arg, "--range") == 0)
+            ok = sscanf(val, "%x:%x", &a_lo, &a_hi) == 2 && a_lo <= a_hi && a_hi <= 0xFFFF;
+        else if (ok && strcmp(arg, "--threads") == 0)
+            ok = (threads = atoi(val)) > 0;
+        else if (ok && strcmp(arg, "--checkpoint") == 0)
+            checkpoint = val;
+        else if (ok && strcmp(arg, "--progress") == 0)
+            ok = (progress = atol(val)) >= 0;
+        else if (ok && strcmp(arg, "--show") == 0)
+            ok = (show = atol(val)) >= 0;
+        else
+            ok = false;
+
+        if (!ok)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+    if (mode < 0)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    threads = fpu_mpfr_threads(threads);
+
+    sweep_state st;
+    st.mode        = mode;
+    st.backend     = mode == MODE_COMPARE ? BACKEND_MPFR : backend;
+    st.show        = show;
+    st.shown       = 0;
+    st.golden_fd   = -1;
+    st.golden_size = 0;
+    st.next        = 0;
+    st.pairs       = 0;
+
+    if (mode == MODE_AGAINST)
+    {
+        if ((st.golden_fd = open(golden, O_RDONLY)) < 0)
+        {
+            perror(golden);
+            return 2;
+        }
+        if (!golden_index(&st, golden, &ops, &rms))
+            return 2;
+    }
+    else
+    {
+        // Chunks are aligned, the range is widened to whole chunks
+        make_passes(st.passes, ops, rms);
+        for (uint32_t k = 0; k < st.passes.size(); k++)
+            for (uint32_t chunk = a_lo / CHUNK_A; chunk <= a_hi / CHUNK_A; chunk++)
+            {
+                task_ref t = { k * PASS_CHUNKS + chunk, 0, 0 };
+                st.tasks.push_back(t);
+            }
+    }
+    st.done.assign(st.passes.size() * PASS_CHUNKS, 0);
+    st.mismatches.assign(st.passes.size(), 0);
+
+    int resumed = checkpoint != NULL ? checkpoint_load(&st, checkpoint) : 0;
+    if (resumed < 0)
+        return 2;
+
+    if (mode == MODE_RECORD)
+    {
+        st.golden_fd = open(golden, resumed ? O_RDWR : O_RDWR | O_CREAT | O_TRUNC, 0664);
+        if (st.golden_fd < 0)
+        {
+            perror(golden);
+            return 2;
+        }
+        if (resumed)
+        {
+            if (ftruncate(st.golden_fd, st.golden_size) != 0 || lseek(st.golden_fd, 0, SEEK_END) != st.golden_size)
+            {
+                perror(golden);
+                return 2;
+            }
+        }
+        else
+        {
+            golden_header h;
+            memset(&h, 0, sizeof(h));
+            h.magic       = GOLDEN_MAGIC;
+            h.version     = SWEEP_VERSION;
+            h.chunk_pairs = CHUNK_PAIRS;
+            h.ops         = ops;
+            h.rms         = rms;
+            h.backend     = backend;
+            h.range       = a_lo | a_hi << 16;
+            if (!fpu_write_all(st.golden_fd, &h, sizeof(h)))
+            {
+                perror(golden);
+                return 2;
+            }
+            st.golden_size = sizeof(h);
+        }
+    }
+
+    size_t todo = 0;
+    for (size_t k = 0; k < st.tasks.size(); k++)
+        todo += !st.done[st.tasks[k].task];
+    printf("%zu passes, %zu chunks of %d pairs, %zu to do%s, %d threads\n", st.passes.size(), st.tasks.size(),
+           CHUNK_PAIRS, todo, resumed ? " (resumed)" : "", threads);
+    fflush(stdout);
+
+    signal(SIGINT, on_sigint);
+    fpu_progress meter;
+    fpu_progress_init(&meter, progress);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++)
+        pool.push_back(std::thread(worker, &st));
+
+    // Progress and periodic checkpoints, until the workers are done
+    double last_checkpoint = 0;
+    while (st.pairs.load() < (uint64_t) todo * CHUNK_PAIRS && st.next.load() < st.tasks.size() + threads &&
+           !interrupted.load())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        fpu_progress_report(&meter, st.pairs.load(), (uint64_t) todo * CHUNK_PAIRS, "pairs");
+        double elapsed = fpu_progress_elapsed(&meter);
+        if (checkpoint != NULL && elapsed - last_checkpoint >= CHECKPOINT_INTERVAL)
+        {
+            std::lock_guard<std::mutex> lock(st.mutex);
+            checkpoint_save(&st, checkpoint);
+            last_checkpoint = elapsed;
+        }
+    }
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+    double seconds = fpu_progress_elapsed(&meter);
+
+    if (checkpoint != NULL && !checkpoint_save(&st, checkpoint))
+        return 2;
+    if (st.golden_fd >= 0)
+        close(st.golden_fd);
+
+    size_t remaining = 0;
+    for (size_t k = 0; k < st.tasks.size(); k++)
+        remaining += !st.done[st.tasks[k].task];
+
+    uint64_t total = 0;
+    for (size_t k = 0; k < st.passes.size(); k++)
+    {
+        if (mode != MODE_RECORD)
+            printf("%-8s %-4s %s\n", op_names[st.passes[k].op], op_rounds[st.passes[k].op] ? rm_names[st.passes[k].rm] : "-",
+                   st.mismatches[k] ? "FAIL" : "ok");
+        total += st.mismatches[k];
+    }
+    printf("%llu pairs in %.1f s, %.2f Mpairs/s", (unsigned long long) st.pairs.load(), seconds,
+           seconds > 0 ? st.pairs.load() / seconds / 1e6 : 0.0);
+    if (mode == MODE_RECORD)
+        printf(", golden file of %lld bytes", (long long) st.golden_size);
+    printf("\n");
+
+    if (remaining > 0)
+    {
+        printf("%zu chunks left%s\n", remaining, checkpoint != NULL ? ", run the same command to resume" : "");
+        return total ? 1 : 3;
+    }
+    if (total)
+    {
+        printf("FP16 sweep FAILED : %llu mismatches\n", (unsigned long long) total);
+        return 1;
+    }
+    return 0;
+}
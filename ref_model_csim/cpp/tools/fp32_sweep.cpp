@@ -0,0 +1,461 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Exhaustive sweep of the FP32 unary operations and of the conversions from 32-bit integers, in every
+ *                  rounding mode, summarised by hashes or dumped
+ *  History       :
+ */
+
+#include "fpu_all_rm.h"
+#include "fpu_exec.h"
+#include "fpu_store.h"
+#include "fpu_util.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define CHUNK_SIZE          (1 << 20)               /**< inputs of a chunk */
+#define PASS_CHUNKS         (1 << 12)               /**< chunks of a pass, 2^32 inputs */
+#define DEFAULT_SHOW        20                      /**< mismatches printed by --check */
+#define LINE_SIZE           256
+
+static const environment float_env = FLOAT_ENV_INITIALIZER;
+
+static const char* rm_names[FPU_RM_NUM] = { "rne", "rtz", "rdn", "rup", "rmm" };
+
+/**
+ * \brief A swept operation, on every FP32 encoding or every 32-bit integer
+ */
+typedef struct
+{
+    const char* name;
+    int         op;             /**< fpu_op_e */
+    int         fmt;            /**< destination format, FP32 for the conversions to integers */
+    int         is_signed;      /**< integer conversions */
+    int         int_format;     /**< integer conversions : 0 for INT32, 1 for INT64 */
+    int         bits;           /**< width of the result */
+} sweep_op;
+
+static const sweep_op sweep_ops[] = {
+    { "sqrt",        FPU_OP_FSQRT,    FPU_FMT_FP32,    0, 0, 32 },
+    { "fclass",      FPU_OP_FCLASS,   FPU_FMT_FP32,    0, 0, 10 },
+    { "f2i32",       FPU_OP_FCVT_F2I, FPU_FMT_FP32,    1, 0, 32 },
+    { "f2u32",       FPU_OP_FCVT_F2I, FPU_FMT_FP32,    0, 0, 32 },
+    { "f2i64",       FPU_OP_FCVT_F2I, FPU_FMT_FP32,    1, 1, 64 },
+    { "f2u64",       FPU_OP_FCVT_F2I, FPU_FMT_FP32,    0, 1, 64 },
+    { "f2f_fp64",    FPU_OP_FCVT_F2F, FPU_FMT_FP64,    0, 0, 64 },
+    { "f2f_fp16",    FPU_OP_FCVT_F2F, FPU_FMT_FP16,    0, 0, 16 },
+    { "f2f_fp8",     FPU_OP_FCVT_F2F, FPU_FMT_FP8,     0, 0, 8  },
+    { "i2f",         FPU_OP_FCVT_I2F, FPU_FMT_FP32,    1, 0, 32 },
+    { "u2f",         FPU_OP_FCVT_I2F, FPU_FMT_FP32,    0, 0, 32 },
+};
+
+#define SWEEP_OP_NUM ((int) (sizeof(sweep_ops) / sizeof(sweep_ops[0])))
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [options]\n", name);
+    printf("  --ops <op,...>       operations (default every one) :\n");
+    printf("                      ");
+    for (int k = 0; k < SWEEP_OP_NUM; k++)
+        printf(" %s", sweep_ops[k].name);
+    printf("\n");
+    printf("  --range <lo:hi>      inputs, in hexadecimal (default 0:ffffffff)\n");
+    printf("  --check              compare each rounding mode but RMM with the handler of fpu_exec\n");
+    printf("  --hashes <file>      write the hash of each operation and rounding mode\n");
+    printf("  --expect <file>      compare the hashes with a file written by --hashes\n");
+    printf("  --dump <dir>         write the results of each operation and rounding mode to <dir>/<op>_<rm>.bin, or\n");
+    printf("                       <dir>/fclass.bin : one record per input in increasing order, the result on 1, 2,\n");
+    printf("                       4 or 8 bytes (little endian) followed by the flags on 1 byte\n");
+    printf("  --threads <n>        worker threads (default: hardware threads)\n");
+    printf("  --progress <s>       seconds between two progress lines (default %d, 0 for none)\n", FPU_DEFAULT_PROGRESS);
+    printf("  --show <n>           mismatches printed by --check (default %d)\n", DEFAULT_SHOW);
+    printf("The five rounding modes are computed at once by fpu_all_rm_compute, fclass does not round.\n");
+}
+
+static inline int result_bytes(const sweep_op* s)
+{
+    return s->bits <= 8 ? 1 : s->bits <= 16 ? 2 : s->bits <= 32 ? 4 : 8;
+}
+
+static inline int rm_count(const sweep_op* s)
+{
+    return fpu_all_rm_supported(s->op) ? FPU_RM_NUM : 1;
+}
+
+//########## SWEEP #####################################################################################################
+
+// State shared by the workers
+typedef struct
+{
+    std::vector<int>      ops;          /**< indexes of sweep_ops */
+    uint32_t              lo, hi;       /**< inputs */
+    uint32_t              first_chunk, nchunks;
+    bool                  check;
+    const char*           dump;
+    std::vector<int>      dump_fds;     /**< per pass and rounding mode */
+    std::vector<uint64_t> hashes;       /**< per task and rounding mode */
+    std::atomic<size_t>   next;
+    std::atomic<uint64_t> inputs;       /**< inputs evaluated */
+    std::atomic<uint64_t> mismatches;
+    std::atomic<bool>     failed;       /**< a dump cannot be written */
+    long                  show;
+    long                  shown;
+    std::mutex            mutex;        /**< shown and the output of the mismatches */
+} sweep_state;
+
+static inline uint64_t hash_step(uint64_t h, uint64_t result, int flags)
+{
+    h ^= result + 0x9E3779B97F4A7C15ULL + ((uint64_t) flags << 56);
+    h *= 0xBF58476D1CE4E5B9ULL;
+    return h ^ (h >> 31);
+}
+
+static bool pwrite_all(int fd, const uint8_t* data, size_t size, off_t offset)
+{
+    while (size > 0)
+    {
+        ssize_t n = pwrite(fd, data, size, offset);
+        if (n <= 0)
+            return false;
+        data += n;
+        size -= n;
+        offset += n;
+    }
+    return true;
+}
+
+static void worker(sweep_state* st)
+{
+    std::vector<std::vector<uint8_t> > buffers(st->dump != NULL ? FPU_RM_NUM : 0);
+    size_t ntasks = st->ops.size() * st->nchunks;
+
+    for (size_t task = st->next++; task < ntasks && !st->failed.load(); task = st->next++)
+    {
+        int             pass = task / st->nchunks;
+        const sweep_op* s = &sweep_ops[st->ops[pass]];
+        uint32_t        chunk = st->first_chunk + task % st->nchunks;
+        uint64_t        first = std::max<uint64_t>((uint64_t) chunk * CHUNK_SIZE, st->lo);
+        uint64_t        last = std::min<uint64_t>((uint64_t) chunk * CHUNK_SIZE + CHUNK_SIZE - 1, st->hi);
+        int             nrm = rm_count(s);
+        int             width = result_bytes(s);
+        uint64_t        mask = s->bits == 64 ? ~0ULL : (1ULL << s->bits) - 1;
+        uint64_t        h[FPU_RM_NUM] = { 0, 0, 0, 0, 0 };
+
+        fpu_exec_ctx ctx;
+        ctx.dst_env    = fpu_fmt_get_desc(s->fmt)->env;
+        ctx.src_env    = s->op == FPU_OP_FCVT_F2F ? float_env : ctx.dst_env;
+        ctx.rm         = 0;
+        ctx.is_signed  = s->is_signed;
+        ctx.int_format = s->int_format;
+        ctx.nchunks    = 2;
+        fpu_exec_fn handler = fpu_exec_get_handler(s->op, s->fmt);
+
+        for (int rm = 0; rm < (int) buffers.size(); rm++)
+            buffers[rm].resize((last - first + 1) * (width + 1));
+
+        for (uint64_t x = first; x <= last; x++)
+        {
+            uint32_t op1[2] = { (uint32_t) x, 0 }, op2[2] = { 0, 0 }, op3[2] = { 0, 0 };
+            uint64_t raw[FPU_RM_NUM];
+            int      flags[FPU_RM_NUM];
+
+            if (nrm == FPU_RM_NUM)
+                fpu_all_rm_compute(raw, flags, s->op, s->fmt, op1, op2, op3, &ctx);
+            else
+            {
+                uint32_t res[4] = { 0, 0, 0, 0 };
+                flags[0] = handler(res, op1, op2, op3, &ctx);
+                raw[0]   = ((uint64_t) res[1] << 32) | res[0];
+            }
+
+            for (int rm = 0; rm < nrm; rm++)
+            {
+                uint64_t result = raw[rm] & mask;
+                h[rm] = hash_step(h[rm], result, flags[rm]);
+                if (!buffers.empty())
+                {
+                    uint8_t* p = &buffers[rm][(x - first) * (width + 1)];
+                    for (int b = 0; b < width; b++)
+                        p[b] = result >> (8 * b);
+                    p[width] = flags[rm];
+                }
+            }
+
+            // Independent evaluation of each mode but RMM, that MPFR does not support
+            if (st->check && nrm == FPU_RM_NUM)
+                for (int rm = 0; rm < FPU_RM_NUM - 1; rm++)
+                {
+                    uint32_t     res[4] = { 0, 0, 0, 0 };
+                    fpu_exec_ctx rm_ctx = ctx;
+                    rm_ctx.rm = rm;
+                    int      ref_flags  = handler(res, op1, op2, op3, &rm_ctx);
+                    uint64_t ref_result = (((uint64_t) res[1] << 32) | res[0]) & mask;
+                    if (ref_result == (raw[rm] & mask) && ref_flags == flags[rm])
+                        continue;
+
+                    st->mismatches++;
+                    std::lock_guard<std::mutex> lock(st->mutex);
+                    if (st->shown++ < st->show)
+                        printf("  %s %s 0x%08x : all_rm 0x%llx/0x%02x, handler 0x%llx/0x%02x\n", s->name, rm_names[rm],
+                               (uint32_t) x, (unsigned long long) (raw[rm] & mask), flags[rm],
+                               (unsigned long long) ref_result, ref_flags);
+                }
+        }
+
+        for (int rm = 0; rm < nrm; rm++)
+        {
+            st->hashes[task * FPU_RM_NUM + rm] = h[rm];
+            if (!buffers.empty() &&
+                !pwrite_all(st->dump_fds[pass * FPU_RM_NUM + rm], &buffers[rm][0], buffers[rm].size(),
+                            (first - st->lo) * (width + 1)))
+            {
+                fprintf(stderr, "cannot write the dump of %s %s\n", s->name, rm_names[rm]);
+                st->failed.store(true);
+            }
+        }
+        st->inputs += last - first + 1;
+    }
+}
+
+//########## HASHES ####################################################################################################
+
+// Hash of a pass and rounding mode, from the hashes of its chunks in input order
+static uint64_t pass_hash(const sweep_state* st, int pass, int rm)
+{
+    uint64_t h = 0;
+    for (uint32_t k = 0; k < st->nchunks; k++)
+        h = hash_step(h, st->hashes[((size_t) pass * st->nchunks + k) * FPU_RM_NUM + rm], 0);
+    return h;
+}
+
+// Compare with the lines "<op> <rm> <hash>" of a file, return the number of differences
+static long compare_hashes(const sweep_state* st, const char* path)
+{
+    FILE* f = fopen(path, "r");
+    if (f == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    char line[LINE_SIZE];
+    long differences = 0, matched = 0;
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        char name[64], rm_name[16];
+        unsigned long long expected;
+        if (line[0] == '#' || sscanf(line, "%63s %15s %llx", name, rm_name, &expected) != 3)
+            continue;
+        for (size_t pass = 0; pass < st->ops.size(); pass++)
+        {
+            const sweep_op* s = &sweep_ops[st->ops[pass]];
+            for (int rm = 0; rm < rm_count(s); rm++)
+                if (strcmp(name, s->name) == 0 && strcmp(rm_name, rm_count(s) > 1 ? rm_names[rm] : "-") == 0)
+                {
+                    matched++;
+                    if (pass_hash(st, pass, rm) != expected)
+                    {
+                        printf("  %s %s : hash %016llx, expected %016llx\n", name, rm_name,
+                               (unsigned long long) pass_hash(st, pass, rm), expected);
+                        differences++;
+                    }
+                }
+        }
+    }
+    fclose(f);
+    if (matched == 0)
+        fprintf(stderr, "%s : no hash of these operations\n", path);
+    return differences;
+}
+
+//########## MAIN ######################################################################################################
+
+int main(int argc, char** argv)
+{
+    int         threads = std::thread::hardware_concurrency();
+    long        progress = FPU_DEFAULT_PROGRESS;
+    long        show = DEFAULT_SHOW;
+    unsigned    lo = 0, hi = 0xFFFFFFFF;
+    bool        check = false;
+    const char* hashes = NULL;
+    const char* expect = NULL;
+    const char* dump = NULL;
+    std::vector<int> ops;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = val != NULL;
+
+        if (strcmp(arg, "--check") == 0)
+        {
+            check = true;
+            continue;
+        }
+        if (ok && strcmp(arg, "--ops") == 0)
+        {
+            char list[LINE_SIZE];
+            snprintf(list, sizeof(list), "%s", val);
+            for (char* name = strtok(list, ","); ok && name != NULL; name = strtok(NULL, ","))
+            {
+                int k = 0;
+                while (k < SWEEP_OP_NUM && strcmp(name, sweep_ops[k].name) != 0)
+                    k++;
+                ok = k < SWEEP_OP_NUM;
+                ops.push_back(k);
+            }
+        }
+        else if (ok && strcmp(arg, "--range") == 0)
+            ok = sscanf(val, "%x:%x", &lo, &hi) == 2 && lo <= hi;
+        else if (ok && strcmp(arg, "--hashes") == 0)
+            hashes = val;
+        else if (ok && strcmp(arg, "--expect") == 0)
+            expect = val;
+        else if (ok && strcmp(arg, "--dump") == 0)
+            dump = val;
+        else if (ok && strcmp(arg, "--threads") == 0)
+            ok = (threads = atoi(val)) > 0;
+        else if (ok && strcmp(arg, "--progress") == 0)
+            ok = (progress = atol(val)) >= 0;
+        else if (ok && strcmp(arg, "--show") == 0)
+            ok = (show = atol(val)) >= 0;
+        else
+            ok = false;
+
+        if (!ok)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+    if (ops.empty())
+        for (int k = 0; k < SWEEP_OP_NUM; k++)
+            ops.push_back(k);
+
+    threads = fpu_mpfr_threads(threads);
+
+    sweep_state st;
+    st.ops         = ops;
+    st.lo          = lo;
+    st.hi          = hi;
+    st.first_chunk = lo / CHUNK_SIZE;
+    st.nchunks     = hi / CHUNK_SIZE - lo / CHUNK_SIZE + 1;
+    st.check       = check;
+    st.dump        = dump;
+    st.next        = 0;
+    st.inputs      = 0;
+    st.mismatches  = 0;
+    st.failed      = false;
+    st.show        = show;
+    st.shown       = 0;
+    st.hashes.assign(ops.size() * st.nchunks * FPU_RM_NUM, 0);
+
+    if (dump != NULL)
+        for (size_t pass = 0; pass < ops.size(); pass++)
+            for (int rm = 0; rm < FPU_RM_NUM; rm++)
+            {
+                const sweep_op* s = &sweep_ops[ops[pass]];
+                int fd = -1;
+                if (rm < rm_count(s))
+                {
+                    std::string path = std::string(dump) + "/" + s->name + (rm_count(s) > 1 ? std::string("_") + rm_names[rm] : "") + ".bin";
+                    if ((fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0664)) < 0)
+                    {
+                        perror(path.c_str());
+                        return 2;
+                    }
+                }
+                st.dump_fds.push_back(fd);
+            }
+
+    uint64_t total = ((uint64_t) hi - lo + 1) * ops.size();
+    printf("%zu operations, %llu inputs each, %d threads\n", ops.size(), (unsigned long long) hi - lo + 1, threads);
+    fflush(stdout);
+
+    fpu_progress meter;
+    fpu_progress_init(&meter, progress);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++)
+        pool.push_back(std::thread(worker, &st));
+
+    while (progress > 0 && st.inputs.load() < total && !st.failed.load())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        fpu_progress_report(&meter, st.inputs.load(), total, "inputs");
+    }
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+    double seconds = fpu_progress_elapsed(&meter);
+
+    for (size_t k = 0; k < st.dump_fds.size(); k++)
+        if (st.dump_fds[k] >= 0)
+            close(st.dump_fds[k]);
+    if (st.failed.load())
+        return 2;
+
+    FILE* out = NULL;
+    if (hashes != NULL && (out = fopen(hashes, "w")) == NULL)
+    {
+        perror(hashes);
+        return 2;
+    }
+    if (out != NULL)
+        fprintf(out, "# %s, range %08x:%08x\n", fpu_store_model_version(), lo, hi);
+    for (size_t pass = 0; pass < ops.size(); pass++)
+    {
+        const sweep_op* s = &sweep_ops[ops[pass]];
+        for (int rm = 0; rm < rm_count(s); rm++)
+        {
+            const char* rm_name = rm_count(s) > 1 ? rm_names[rm] : "-";
+            printf("%-12s %-4s %016llx\n", s->name, rm_name, (unsigned long long) pass_hash(&st, pass, rm));
+            if (out != NULL)
+                fprintf(out, "%s %s %016llx\n", s->name, rm_name, (unsigned long long) pass_hash(&st, pass, rm));
+        }
+    }
+    if (out != NULL)
+        fclose(out);
+    printf("%llu inputs in %.1f s, %.2f Minputs/s\n", (unsigned long long) total, seconds,
+           seconds > 0 ? total / seconds / 1e6 : 0.0);
+
+    long differences = expect != NULL ? compare_hashes(&st, expect) : 0;
+    if (differences < 0)
+        return 2;
+    if (st.mismatches.load() != 0 || differences != 0)
+    {
+        printf("FP32 sweep FAILED : %llu mismatches, %ld hashes differ\n", (unsigned long long) st.mismatches.load(),
+               differences);
+        return 1;
+    }
+    return 0;
+}
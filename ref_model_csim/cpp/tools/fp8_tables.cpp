@@ -0,0 +1,251 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Exhaustive self-check of the MPFR operations on FP8 and writer of the FP8 table file
+ *  History       :
+ */
+
+#include "fpu_fp8_table.h"
+#include "intfp.h"
+#include "operations.h"
+#include "fpu_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define MAX_REPORTED 20 /**< mismatches printed per operation */
+
+static const environment fp8_env = FP8_ENV_INITIALIZER;
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [--check] [--full] [--threads <n>] [--output <file>]\n", name);
+    printf("  --check          compare the MPFR operations with the integer ones on every FP8 operand, and the RMM\n");
+    printf("                   results of the model with the RNE ones except on exact ties\n");
+    printf("  --full           with --check, every addend of the fused operations instead of 16 of them\n");
+    printf("  --threads <n>    worker threads of the fused operations (default: hardware threads)\n");
+    printf("  --output <file>  write the table file read through REFMODEL_FP8_TABLES\n");
+}
+
+// Every entry of the tables, MPFR against intfp
+static long check_tables()
+{
+    long total = 0;
+    for (int table = 0; table < FP8_TABLE_NUM; table++)
+    {
+        long mismatches = 0;
+        for (int i = 0; i < FPU_FP8_TABLE_SIZE; i++)
+        {
+            uint8_t  a = i & 0xFF, b = i >> 8;
+            uint16_t ref = fpu_fp8_table_mpfr(table, a, b);
+            uint16_t val = fpu_fp8_table_intfp(table, a, b);
+            if (ref != val && mismatches++ < MAX_REPORTED)
+                printf("  %s 0x%02x 0x%02x : mpfr 0x%02x/0x%02x, intfp 0x%02x/0x%02x\n", fpu_fp8_table_name(table), a, b,
+                       FP8_TABLE_RESULT(ref), FP8_TABLE_FLAGS(ref), FP8_TABLE_RESULT(val), FP8_TABLE_FLAGS(val));
+        }
+        printf("%-8s %s\n", fpu_fp8_table_name(table), mismatches ? "FAIL" : "ok");
+        total += mismatches;
+    }
+    return total;
+}
+
+// Request of the model on FP8 operands, NaN-boxed
+static inline uint64_t boxed(uint32_t x)
+{
+    return ~0xFFULL | x;
+}
+
+// RMM result of the model against RNE, RDN and RUP, see fpu_exec_rmm_expected. Returns true if they agree.
+static bool check_rmm(int op, uint32_t a, uint32_t b, uint32_t c, uint64_t* result, int* flags, uint64_t* ref, int* ref_flags)
+{
+    *flags     = fpu_exec_compute(result, op, boxed(a), boxed(b), boxed(c), FPU_FMT_FP8, 4, 64, 64);
+    *ref_flags = fpu_exec_rmm_expected(ref, op, boxed(a), boxed(b), boxed(c), FPU_FMT_FP8, 64, 64);
+    return *result == *ref && *flags == *ref_flags;
+}
+
+// Additions, subtractions, multiplications and divisions in RMM, on every operand pair
+static long check_rmm_binary()
+{
+    static const int   ops[4]   = { FPU_OP_FADD, FPU_OP_FSUB, FPU_OP_FMUL, FPU_OP_FDIV };
+    static const char* names[4] = { "ADD.RMM", "SUB.RMM", "MUL.RMM", "DIV.RMM" };
+    long total = 0;
+
+    for (int k = 0; k < 4; k++)
+    {
+        long mismatches = 0;
+        for (int i = 0; i < FPU_FP8_TABLE_SIZE; i++)
+        {
+            uint32_t x = i & 0xFF, y = i >> 8;
+            uint64_t result, ref;
+            int flags, ref_flags;
+            // Additions read operand_b and imm, multiplications and divisions operand_a and operand_b
+            bool ok = ops[k] == FPU_OP_FADD || ops[k] == FPU_OP_FSUB
+                    ? check_rmm(ops[k], 0, x, y, &result, &flags, &ref, &ref_flags)
+                    : check_rmm(ops[k], x, y, 0, &result, &flags, &ref, &ref_flags);
+            if (!ok && mismatches++ < MAX_REPORTED)
+                printf("  %s 0x%02x 0x%02x : model 0x%02x/0x%02x, expected 0x%02x/0x%02x\n", names[k], x, y,
+                       (unsigned) (result & 0xFF), flags, (unsigned) (ref & 0xFF), ref_flags);
+        }
+        printf("%-8s %s\n", names[k], mismatches ? "FAIL" : "ok");
+        total += mismatches;
+    }
+    return total;
+}
+
+typedef int (*mpfr_fused_fn)(uint32_t*, const uint32_t*, const uint32_t*, const uint32_t*, mpfr_rnd_t, environment);
+typedef int (*intfp_fused_fn)(uint64_t*, uint64_t, uint64_t, uint64_t, int, environment);
+
+static const char*          fused_names[4]     = { "FMADD", "FMSUB", "FNMADD", "FNMSUB" };
+static const int            fused_ops[4]       = { FPU_OP_FMADD, FPU_OP_FMSUB, FPU_OP_FNMADD, FPU_OP_FNMSUB };
+static const mpfr_fused_fn  fused_mpfr_ops[4]  = { fma, fms, fnma, fnms };
+static const intfp_fused_fn fused_intfp_ops[4] = { intfp_fma, intfp_fms, intfp_fnma, intfp_fnms };
+
+// Work shared by the threads of check_fused : one task per operation, rounding mode (RMM last) and operand b
+typedef struct
+{
+    int                step;
+    std::atomic<int>   next;
+    std::atomic<long>  mismatches[4];
+    std::mutex         print_mutex;
+} fused_state;
+
+static void fused_worker(fused_state* st)
+{
+    for (int task = st->next++; task < 4 * 5 * 256; task = st->next++)
+    {
+        int op = task / (5 * 256), rm = (task / 256) % 5;
+        uint32_t b[2] = { (uint32_t) (task % 256), 0 };
+
+        for (int i = 0; i < 256; i++)
+            for (int c = 0; c < 256; c += st->step)
+            {
+                uint32_t a[2] = { (uint32_t) i, 0 };
+                uint32_t d[2] = { (uint32_t) c, 0 };
+                uint32_t ref[2] = { 0, 0 };
+                uint64_t val = 0;
+
+                if (rm == 4)
+                {
+                    uint64_t result, expected;
+                    int flags, expected_flags;
+                    if (!check_rmm(fused_ops[op], a[0], b[0], d[0], &result, &flags, &expected, &expected_flags) &&
+                        st->mismatches[op]++ < MAX_REPORTED)
+                    {
+                        std::lock_guard<std::mutex> lock(st->print_mutex);
+                        printf("  %s rm 4 0x%02x 0x%02x 0x%02x : model 0x%02x/0x%02x, expected 0x%02x/0x%02x\n",
+                               fused_names[op], a[0], b[0], d[0], (unsigned) (result & 0xFF), flags,
+                               (unsigned) (expected & 0xFF), expected_flags);
+                    }
+                    continue;
+                }
+
+                int ref_flags = fused_mpfr_ops[op](ref, a, b, d, rnd_rtl_to_c(rm), fp8_env);
+                int val_flags = fused_intfp_ops[op](&val, a[0], b[0], d[0], rm, fp8_env);
+
+                if (((ref[0] & 0xFF) != val || ref_flags != val_flags) && st->mismatches[op]++ < MAX_REPORTED)
+                {
+                    std::lock_guard<std::mutex> lock(st->print_mutex);
+                    printf("  %s rm %d 0x%02x 0x%02x 0x%02x : mpfr 0x%02x/0x%02x, intfp 0x%02x/0x%02x\n", fused_names[op],
+                           rm, a[0], b[0], d[0], ref[0] & 0xFF, ref_flags, (unsigned) val, val_flags);
+                }
+            }
+    }
+}
+
+// Fused operations on every product and every addend (a sample of them without full), MPFR against intfp in every
+// rounding mode but RMM, and the model against check_rmm in RMM
+static long check_fused(bool full, int threads)
+{
+    fused_state st;
+    st.step = full ? 1 : 17;
+    st.next = 0;
+    for (int op = 0; op < 4; op++)
+        st.mismatches[op] = 0;
+
+    threads = fpu_mpfr_threads(threads);
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++)
+        pool.push_back(std::thread(fused_worker, &st));
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+
+    long total = 0;
+    for (int op = 0; op < 4; op++)
+    {
+        printf("%-8s %s\n", fused_names[op], st.mismatches[op] ? "FAIL" : "ok");
+        total += st.mismatches[op];
+    }
+    return total;
+}
+
+int main(int argc, char** argv)
+{
+    bool check = false, full = false;
+    int  threads = std::thread::hardware_concurrency();
+    const char* output = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--check") == 0)
+            check = true;
+        else if (strcmp(argv[i], "--full") == 0)
+            full = true;
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+            output = argv[++i];
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!check && output == NULL)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (check)
+    {
+        long mismatches = check_tables() + check_rmm_binary() + check_fused(full, threads > 0 ? threads : 1);
+        if (mismatches != 0)
+        {
+            printf("FP8 self-check FAILED : %ld mismatches\n", mismatches);
+            return 1;
+        }
+        printf("FP8 self-check passed\n");
+    }
+
+    if (output != NULL)
+    {
+        if (fpu_fp8_table_save(output) != 0)
+            return 1;
+        printf("FP8 tables written to %s\n", output);
+    }
+    return 0;
+}
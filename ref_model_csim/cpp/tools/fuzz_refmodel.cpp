@@ -0,0 +1,536 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Differential fuzzing target of the MPFR operations, against the integer operations and the host FPU
+ *  History       :
+ */
+
+#include "operations.h"
+#include "intfp.h"
+#include "fpu_exec.h"
+#include "fpu_util.h"
+#include <algorithm>
+#include <cfenv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <dirent.h>
+#include <sys/stat.h>
+
+/*
+ * An input is decoded into a case : operation, environment, rounding mode and operands. Missing bytes are read as 0.
+ *   byte 0        operation, see fuzz_op_e
+ *   byte 1        bit 0 clear : standard format (bits 7:1), bit 0 set : custom format of 8 x (1 + bits 2:1) bits
+ *   byte 2        exponent bits of a custom format
+ *   byte 3        rounding mode RNE, RTZ, RDN or RUP (the MPFR operations do not support RMM)
+ *   bytes 4-27    three operands, 64-bit little endian, masked to the width of the format
+ * FUZZ_ROUND rounds (-1)^s * sig * 2^exp to the format through mpfr2IEEElike, as the operations do : sig is the first
+ * operand, s bit 63 of the second one and its low 16 bits select the exponent of the value around the range of the
+ * format, subnormals included.
+ */
+
+#define FUZZ_INPUT_SIZE 28
+#define DEFAULT_RUNS    1000000
+
+typedef enum
+{
+    FUZZ_ADD = 0, FUZZ_SUB, FUZZ_MUL, FUZZ_DIV, FUZZ_SQRT, FUZZ_FMA, FUZZ_FMS, FUZZ_FNMA, FUZZ_FNMS,
+    FUZZ_FMIN, FUZZ_FMAX, FUZZ_CMP_LEQ, FUZZ_CMP_LT, FUZZ_CMP_EQ, FUZZ_ROUND, FUZZ_OP_NUM
+} fuzz_op_e;
+
+static const char* op_names[FUZZ_OP_NUM] = { "add", "sub", "mul", "div", "sqrt", "fma", "fms", "fnma", "fnms",
+                                             "fmin", "fmax", "cmp_leq", "cmp_lt", "cmp_eq", "round" };
+
+static const struct
+{
+    const char* name;
+    environment env;
+} std_fmts[] = {
+    { "fp8",     FP8_ENV_INITIALIZER     },
+    { "fp16",    HALF_ENV_INITIALIZER    },
+    { "fp16alt", FP16ALT_ENV_INITIALIZER },
+    { "fp32",    FLOAT_ENV_INITIALIZER   },
+    { "fp64",    DOUBLE_ENV_INITIALIZER  },
+};
+
+#define STD_FMT_NUM ((int) (sizeof(std_fmts) / sizeof(std_fmts[0])))
+
+typedef struct
+{
+    int         op;
+    environment env;
+    int         rm;
+    uint64_t    operands[3];
+} fuzz_case;
+
+static inline bool same_env(environment a, environment b)
+{
+    return a.bis == b.bis && a.es == b.es;
+}
+
+//########## DECODING ##################################################################################################
+
+static void decode(const uint8_t* data, size_t size, fuzz_case* c)
+{
+    uint8_t in[FUZZ_INPUT_SIZE];
+
+    memset(in, 0, sizeof(in));
+    memcpy(in, data, std::min(size, sizeof(in)));
+
+    c->op = in[0] % FUZZ_OP_NUM;
+    if ((in[1] & 1) == 0)
+        c->env = std_fmts[(in[1] >> 1) % STD_FMT_NUM].env;
+    else
+    {
+        int width    = 8 * (1 + ((in[1] >> 1) & 3));
+        int max_bits = std::min(width - 2, 15);
+        c->env.bis = width - 1;
+        c->env.es  = 2 + in[2] % (max_bits - 1) - 1;
+    }
+    c->rm = in[3] % 4;
+
+    for (int k = 0; k < 3; k++)
+    {
+        uint64_t v = 0;
+        for (int i = 7; i >= 0; i--)
+            v = (v << 8) | in[4 + 8 * k + i];
+        c->operands[k] = (c->op == FUZZ_ROUND) ? v : v & fpu_low_mask(c->env.bis + 1);
+    }
+}
+
+static void encode(uint8_t* out, const fuzz_case* c, int fmt_index)
+{
+    memset(out, 0, FUZZ_INPUT_SIZE);
+    out[0] = c->op;
+    out[1] = fmt_index << 1;
+    out[3] = c->rm;
+    for (int k = 0; k < 3; k++)
+        for (int i = 0; i < 8; i++)
+            out[4 + 8 * k + i] = c->operands[k] >> (8 * i);
+}
+
+// Exponent of the value of FUZZ_ROUND, from 3 below the smallest subnormal to 2 above the largest normal
+static int round_exponent(const fuzz_case* c)
+{
+    int64_t lo = IEEElike_emin(c->env.es) - MBITS(c->env) - 3;
+    int64_t hi = IEEElike_emax(c->env.es) + 2;
+    return lo + (int64_t) ((c->operands[1] & 0xFFFF) % (hi - lo + 1));
+}
+
+static inline int bit_length(uint64_t x)
+{
+    return 64 - __builtin_clzll(x);
+}
+
+//########## MPFR OPERATIONS ###########################################################################################
+
+static inline void split_dwords(uint32_t* dst, uint64_t src)
+{
+    dst[0] = src & 0xFFFFFFFF;
+    dst[1] = src >> 32;
+}
+
+// Round as fcvt_f2f does : to the precision with an unbounded range, then to the range of the format
+static int model_round(uint32_t* result, const fuzz_case* c)
+{
+    uint64_t   sig = c->operands[0] ? c->operands[0] : 1;
+    int        exp = round_exponent(c) - (bit_length(sig) - 1);
+    mpfr_rnd_t rnd = rnd_rtl_to_c(c->rm);
+    mpfr_t     x, y;
+
+    mpfr_set_emin(mpfr_get_emin_min());
+    mpfr_set_emax(mpfr_get_emax_max());
+    mpfr_init2(x, 64);
+    mpfr_set_ui(x, sig >> 32, MPFR_RNDN);
+    mpfr_mul_2ui(x, x, 32, MPFR_RNDN);
+    mpfr_add_ui(x, x, sig & 0xFFFFFFFF, MPFR_RNDN);
+    mpfr_mul_2si(x, x, exp, MPFR_RNDN);
+    if (c->operands[1] >> 63)
+        mpfr_neg(x, x, MPFR_RNDN);
+
+    mpfr_init2(y, MBITS(c->env) + 1);
+    mpfr_clear_flags();
+    int inex = mpfr_set(y, x, rnd);
+    IEEElike_set_exp_range(c->env.es, MBITS(c->env));
+    inex = mpfr_check_range(y, inex, rnd);
+    mpfr_subnormalize(y, inex, rnd);
+    mpfr2IEEElike(result, y, c->env, rnd, false);
+    mpfr_clears(x, y, (mpfr_ptr) 0);
+    return get_flags(false, false);
+}
+
+static int model_exec(uint64_t* result, const fuzz_case* c)
+{
+    uint32_t   a[2], b[2], d[2], r[4] = { 0, 0, 0, 0 };
+    mpfr_rnd_t rnd = rnd_rtl_to_c(c->rm);
+    int        flags = 0;
+
+    split_dwords(a, c->operands[0]);
+    split_dwords(b, c->operands[1]);
+    split_dwords(d, c->operands[2]);
+
+    switch (c->op)
+    {
+    case FUZZ_ADD:     flags = add(r, a, b, rnd, c->env); break;
+    case FUZZ_SUB:     flags = sub(r, a, b, rnd, c->env); break;
+    case FUZZ_MUL:     flags = mul(r, a, b, rnd, c->env); break;
+    case FUZZ_DIV:     flags = div(r, a, b, rnd, c->env); break;
+    case FUZZ_SQRT:    flags = sqrt(r, a, rnd, c->env); break;
+    case FUZZ_FMA:     flags = fma(r, a, b, d, rnd, c->env); break;
+    case FUZZ_FMS:     flags = fms(r, a, b, d, rnd, c->env); break;
+    case FUZZ_FNMA:    flags = fnma(r, a, b, d, rnd, c->env); break;
+    case FUZZ_FNMS:    flags = fnms(r, a, b, d, rnd, c->env); break;
+    case FUZZ_FMIN:    flags = fmin(r, a, b, rnd, c->env); break;
+    case FUZZ_FMAX:    flags = fmax(r, a, b, rnd, c->env); break;
+    case FUZZ_CMP_LEQ: flags = cmp_leq(r, a, b, c->env); break;
+    case FUZZ_CMP_LT:  flags = cmp_lt(r, a, b, c->env); break;
+    case FUZZ_CMP_EQ:  flags = cmp_eq(r, a, b, c->env); break;
+    case FUZZ_ROUND:   flags = model_round(r, c); break;
+    }
+    *result = (((uint64_t) r[1] << 32) | r[0]) & fpu_low_mask(c->env.bis + 1);
+    return flags;
+}
+
+//########## INTEGER OPERATIONS ########################################################################################
+
+// Return -1 if the case is not supported by the integer operations
+static int intfp_exec(uint64_t* result, const fuzz_case* c)
+{
+    const uint64_t* o = c->operands;
+
+    if (c->op == FUZZ_ROUND)
+    {
+        uint64_t sig = o[0] ? o[0] : 1;
+        return intfp_round(result, o[1] >> 63, sig, round_exponent(c) - (bit_length(sig) - 1), c->rm, c->env);
+    }
+    if (!intfp_supported(c->env))
+        return -1;
+
+    switch (c->op)
+    {
+    case FUZZ_ADD:     return intfp_add(result, o[0], o[1], c->rm, c->env);
+    case FUZZ_SUB:     return intfp_sub(result, o[0], o[1], c->rm, c->env);
+    case FUZZ_MUL:     return intfp_mul(result, o[0], o[1], c->rm, c->env);
+    case FUZZ_DIV:     return intfp_div(result, o[0], o[1], c->rm, c->env);
+    case FUZZ_SQRT:    return intfp_sqrt(result, o[0], c->rm, c->env);
+    case FUZZ_FMA:     return intfp_fma(result, o[0], o[1], o[2], c->rm, c->env);
+    case FUZZ_FMS:     return intfp_fms(result, o[0], o[1], o[2], c->rm, c->env);
+    case FUZZ_FNMA:    return intfp_fnma(result, o[0], o[1], o[2], c->rm, c->env);
+    case FUZZ_FNMS:    return intfp_fnms(result, o[0], o[1], o[2], c->rm, c->env);
+    case FUZZ_FMIN:    return intfp_fmin(result, o[0], o[1], c->env);
+    case FUZZ_FMAX:    return intfp_fmax(result, o[0], o[1], c->env);
+    case FUZZ_CMP_LEQ: return intfp_cmp_leq(result, o[0], o[1], c->env);
+    case FUZZ_CMP_LT:  return intfp_cmp_lt(result, o[0], o[1], c->env);
+    case FUZZ_CMP_EQ:  return intfp_cmp_eq(result, o[0], o[1], c->env);
+    }
+    return -1;
+}
+
+//########## HOST FPU ##################################################################################################
+
+template <typename T, typename U>
+static int host_compute(uint64_t* result, const fuzz_case* c, U canonical_nan)
+{
+    static const int host_rm[4] = { FE_TONEAREST, FE_TOWARDZERO, FE_DOWNWARD, FE_UPWARD };
+    volatile T a, b, d, r;
+    T          x;
+    U          bits;
+
+    bits = c->operands[0]; memcpy(&x, &bits, sizeof(x)); a = x;
+    bits = c->operands[1]; memcpy(&x, &bits, sizeof(x)); b = x;
+    bits = c->operands[2]; memcpy(&x, &bits, sizeof(x)); d = x;
+
+    // Operands are volatile so that the operation stays between the changes of the floating point environment
+    fesetround(host_rm[c->rm]);
+    feclearexcept(FE_ALL_EXCEPT);
+    switch (c->op)
+    {
+    case FUZZ_ADD:  r = a + b; break;
+    case FUZZ_SUB:  r = a - b; break;
+    case FUZZ_MUL:  r = a * b; break;
+    case FUZZ_DIV:  r = a / b; break;
+    case FUZZ_SQRT: r = std::sqrt((T) a); break;
+    case FUZZ_FMA:  r = std::fma((T) a, (T) b, (T) d); break;
+    case FUZZ_FMS:  r = std::fma((T) a, (T) b, (T) -d); break;
+    case FUZZ_FNMA: r = std::fma((T) -a, (T) b, (T) -d); break;
+    case FUZZ_FNMS: r = std::fma((T) -a, (T) b, (T) d); break;
+    }
+    int ex = fetestexcept(FE_ALL_EXCEPT);
+    fesetround(FE_TONEAREST);
+
+    int flags = ((ex & FE_INEXACT) ? 1 : 0) | ((ex & FE_UNDERFLOW) ? 2 : 0) | ((ex & FE_OVERFLOW) ? 4 : 0) |
+                ((ex & FE_DIVBYZERO) ? 8 : 0) | ((ex & FE_INVALID) ? 16 : 0);
+
+    // RISC-V raises NV on 0 x Inf + qNaN, which IEEE 754 leaves to the implementation
+    if (c->op >= FUZZ_FMA && c->op <= FUZZ_FNMS &&
+        ((a == 0 && std::isinf((T) b)) || (std::isinf((T) a) && b == 0)))
+        flags |= 16;
+
+    x = r;
+    memcpy(&bits, &x, sizeof(bits));
+    *result = std::isnan(x) ? canonical_nan : bits;
+    return flags;
+}
+
+// Return -1 if the case is not supported by the host FPU
+static int host_exec(uint64_t* result, const fuzz_case* c)
+{
+    static const environment fp32 = FLOAT_ENV_INITIALIZER, fp64 = DOUBLE_ENV_INITIALIZER;
+
+    if (c->op > FUZZ_FNMS)
+        return -1;
+    if (same_env(c->env, fp32))
+        return host_compute<float, uint32_t>(result, c, 0x7FC00000U);
+    if (same_env(c->env, fp64))
+        return host_compute<double, uint64_t>(result, c, 0x7FF8000000000000ULL);
+    return -1;
+}
+
+//########## CHECK #####################################################################################################
+
+static void check_backend(const fuzz_case* c, uint64_t model, int model_flags, const char* name,
+                          int (*backend)(uint64_t*, const fuzz_case*))
+{
+    uint64_t result = 0;
+    int      flags  = backend(&result, c);
+
+    if (flags < 0 || (result == model && flags == model_flags))
+        return;
+
+    fprintf(stderr, "fuzz_refmodel : %s, format %d:%d, rm %d, operands 0x%llx 0x%llx 0x%llx : MPFR 0x%llx flags 0x%02x,"
+            " %s 0x%llx flags 0x%02x\n", op_names[c->op], c->env.bis + 1, c->env.es + 1, c->rm,
+            (unsigned long long) c->operands[0], (unsigned long long) c->operands[1],
+            (unsigned long long) c->operands[2], (unsigned long long) model, model_flags, name,
+            (unsigned long long) result, flags);
+    abort();
+}
+
+static void check_case(const fuzz_case* c)
+{
+    uint64_t model = 0;
+    int      flags = model_exec(&model, c);
+
+    check_backend(c, model, flags, "intfp", intfp_exec);
+    check_backend(c, model, flags, "host", host_exec);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    fuzz_case c;
+    decode(data, size, &c);
+    check_case(&c);
+    return 0;
+}
+
+#ifndef REFMODEL_LIBFUZZER
+
+//########## STANDALONE DRIVER #########################################################################################
+
+// Built without libFuzzer : run the given inputs (corpus, crash files), then random ones, and write the seed corpus
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [--runs <n>] [--seed <n>] [<file|dir> ...]\n", name);
+    printf("       %s --write-corpus <dir>\n", name);
+    printf("  <file|dir>             inputs run first, e.g. a corpus or a crash file of libFuzzer\n");
+    printf("  --runs <n>             random inputs run after them, biased towards special encodings (default %d)\n", DEFAULT_RUNS);
+    printf("  --seed <n>             seed of the random inputs (default 1)\n");
+    printf("  --write-corpus <dir>   write the seed corpus of special encodings to <dir>\n");
+    printf("The MPFR operations are checked against the integer ones (intfp.h) and the host FPU (FP32, FP64), the\n");
+    printf("first difference is printed and aborts.\n");
+}
+
+#define SPECIAL_NUM 11
+
+// Zero, smallest and largest subnormals, smallest normal, 0.5, 0.75, 1, largest normal, infinity, quiet and signaling NaN
+static uint64_t special_encoding(environment env, int k)
+{
+    int      ms   = MBITS(env);
+    uint64_t emax = fpu_low_mask(env.es + 1), bias = fpu_low_mask(env.es);
+    const uint64_t specials[SPECIAL_NUM] = {
+        0, 1, fpu_low_mask(ms), 1ULL << ms, (bias - 1) << ms, ((bias - 1) << ms) | (1ULL << (ms - 1)), bias << ms,
+        (emax << ms) - 1, emax << ms, (emax << ms) | (1ULL << (ms - 1)), (emax << ms) | 1
+    };
+    return specials[k % SPECIAL_NUM];
+}
+
+static bool run_file(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (f == NULL)
+    {
+        perror(path);
+        return false;
+    }
+    uint8_t data[FUZZ_INPUT_SIZE];
+    size_t  size = fread(data, 1, sizeof(data), f);
+    fclose(f);
+    LLVMFuzzerTestOneInput(data, size);
+    return true;
+}
+
+static bool run_path(const char* path, long* ninputs)
+{
+    struct stat st;
+    if (stat(path, &st) != 0)
+    {
+        perror(path);
+        return false;
+    }
+    if (!S_ISDIR(st.st_mode))
+    {
+        (*ninputs)++;
+        return run_file(path);
+    }
+
+    DIR* dir = opendir(path);
+    if (dir == NULL)
+    {
+        perror(path);
+        return false;
+    }
+    bool ok = true;
+    for (struct dirent* e = readdir(dir); e != NULL && ok; e = readdir(dir))
+        if (e->d_name[0] != '.')
+            ok = run_path((std::string(path) + "/" + e->d_name).c_str(), ninputs);
+    closedir(dir);
+    return ok;
+}
+
+static bool write_input(const char* dir, const char* name, const uint8_t* data)
+{
+    std::string path = std::string(dir) + "/" + name;
+    FILE* f = fopen(path.c_str(), "wb");
+    if (f == NULL || fwrite(data, 1, FUZZ_INPUT_SIZE, f) != FUZZ_INPUT_SIZE || fclose(f) != 0)
+    {
+        perror(path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Every operation and standard format with the special encodings, FUZZ_ROUND around the subnormal range and the
+// overflow threshold
+static int write_corpus(const char* dir)
+{
+    static const uint64_t round_sigs[4] = { 1, 3, 0xFFFFFFFFFFFFFFFFULL, 0x8000000000000001ULL };
+    int n = 0;
+
+    mkdir(dir, 0777);
+    for (int op = 0; op < FUZZ_OP_NUM; op++)
+        for (int f = 0; f < STD_FMT_NUM; f++)
+            for (int k = 0; k < SPECIAL_NUM; k++)
+            {
+                environment env = std_fmts[f].env;
+                fuzz_case   c;
+                uint8_t     data[FUZZ_INPUT_SIZE];
+                char        name[64];
+
+                c.op  = op;
+                c.env = env;
+                c.rm  = k % 4;
+                if (op == FUZZ_ROUND)
+                {
+                    // Exponents from the one below the smallest subnormal, then around the largest normal
+                    int64_t lo  = IEEElike_emin(env.es) - MBITS(env) - 3;
+                    int64_t e   = k < 7 ? IEEElike_emin(env.es) - MBITS(env) - 2 + k : IEEElike_emax(env.es) - 8 + k;
+                    c.operands[0] = round_sigs[k % 4];
+                    c.operands[1] = ((uint64_t) (k & 1) << 63) | (uint64_t) (e - lo);
+                    c.operands[2] = 0;
+                }
+                else
+                    for (int i = 0; i < 3; i++)
+                        c.operands[i] = special_encoding(env, k + 4 * i) |
+                                        ((uint64_t) ((k + i) & 1) << env.bis);
+
+                encode(data, &c, f);
+                snprintf(name, sizeof(name), "%s_%s_%02d", op_names[op], std_fmts[f].name, k);
+                if (!write_input(dir, name, data))
+                    return 2;
+                n++;
+            }
+    printf("%d inputs written to %s\n", n, dir);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    long        runs = DEFAULT_RUNS, ninputs = 0;
+    uint64_t    seed = 1;
+    const char* corpus = NULL;
+    int         i = 1;
+
+    for (; i < argc && strncmp(argv[i], "--", 2) == 0; i += 2)
+    {
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = val != NULL;
+
+        if (ok && strcmp(argv[i], "--runs") == 0)
+            ok = (runs = atol(val)) >= 0;
+        else if (ok && strcmp(argv[i], "--seed") == 0)
+            seed = strtoull(val, NULL, 0);
+        else if (ok && strcmp(argv[i], "--write-corpus") == 0)
+            corpus = val;
+        else
+            ok = false;
+
+        if (!ok)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (corpus != NULL)
+        return write_corpus(corpus);
+
+    for (; i < argc; i++)
+        if (!run_path(argv[i], &ninputs))
+            return 2;
+
+    // Random inputs, half of the operands replaced by a special encoding of the format
+    for (long r = 0; r < runs; r++)
+    {
+        uint8_t data[FUZZ_INPUT_SIZE];
+        for (int k = 0; k < FUZZ_INPUT_SIZE; k += 8)
+        {
+            uint64_t v = fpu_splitmix64(&seed);
+            memcpy(data + k, &v, std::min(8, FUZZ_INPUT_SIZE - k));
+        }
+
+        fuzz_case c;
+        decode(data, sizeof(data), &c);
+        if (c.op != FUZZ_ROUND)
+            for (int k = 0; k < 3; k++)
+            {
+                uint64_t v = fpu_splitmix64(&seed);
+                if (v & 1)
+                    c.operands[k] = special_encoding(c.env, (v >> 1) % SPECIAL_NUM) | ((v >> 8) & 1) << c.env.bis;
+            }
+        check_case(&c);
+    }
+    printf("%ld inputs and %ld random inputs checked\n", ninputs, runs);
+    return 0;
+}
+
+#endif // REFMODEL_LIBFUZZER
@@ -0,0 +1,540 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Generator of the golden-vector files replayed by fpu_golden_test
+ *  History       :
+ */
+
+#include "fpu_exec.h"
+#include "fpu_gen.h"
+#include "fpu_hard.h"
+#include "fpu_golden.h"
+#include "fpu_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <mpfr.h>
+
+#define DEFAULT_COUNT    10000
+#define DEFAULT_UNBOXED  10       /**< percentage of narrow operands left unboxed, as m_nan_box_c of fpu_txn */
+#define MAX_DRAWS        1000     /**< requests drawn for a record before the operations and formats are rejected */
+#define DEFAULT_CHECKS   10000    /**< hard cases checked by --check per format, operation and property */
+#define CHECK_SHOW       20       /**< failures printed by --check */
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [options] <file>\n", name);
+    printf("       %s --print <file>\n", name);
+    printf("       %s --check [--count <n>] [--seed <n>] [--fmts <list>]\n", name);
+    printf("  <file>               golden-vector file written, see fpu_golden.h\n");
+    printf("  --print <file>       print the header and the records of a golden-vector file or of a recorded stream\n");
+    printf("  --check              check the exact results of the hard-case generator with MPFR, and their RMM results,\n");
+    printf("                       n cases per format, operation and property (default %d, all the formats)\n",
+           DEFAULT_CHECKS);
+    printf("  --count <n>          number of records (default %d)\n", DEFAULT_COUNT);
+    printf("  --seed <n>           seed of the operand generator (default 1)\n");
+    printf("  --ops <list>         comma separated operations (default fadd to fclass, as fpu_txn)\n");
+    printf("  --fmts <list>        comma separated formats, fp32, fp64, fp16 or fp8 (default fp32,fp64)\n");
+    printf("  --xlen <n>           integer register width of the core, 32 or 64 (default 64)\n");
+    printf("  --flen <n>           floating point register width of the core, 32 or 64 (default 64)\n");
+    printf("  --hard <n>           percentage of the arithmetic requests built by the hard-case generator (default 0)\n");
+    printf("  --corner-w <n>       weight of the corner values of the formats, next to the class weights of fpu_txn\n");
+    printf("                       (default 0)\n");
+    printf("  --unboxed <n>        percentage of narrow floating point operands left unboxed (default %d)\n",
+           DEFAULT_UNBOXED);
+    printf("  --max-delay <n>      clock cycles before a request, drawn up to n (default 0, back to back)\n");
+    printf("The requests follow the constraints of fpu_txn on the rounding modes and the conversion selectors.\n");
+}
+
+// Parse a comma separated list of names or codes of a table into a mask
+static bool parse_list(const char* s, const char* (*name_of)(int), int num, uint32_t* mask)
+{
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", s);
+    *mask = 0;
+    for (char* tok = strtok(buf, ","); tok != NULL; tok = strtok(NULL, ","))
+    {
+        int k = fpu_parse_code(tok, name_of, num);
+        if (k < 0)
+        {
+            fprintf(stderr, "unknown name : %s\n", tok);
+            return false;
+        }
+        *mask |= 1u << k;
+    }
+    return *mask != 0;
+}
+
+// Draw a value of a non-empty mask
+static int draw_of(fpu_gen* gen, uint32_t mask)
+{
+    int values[32], n = 0;
+    for (int k = 0; k < 32; k++)
+        if ((mask >> k) & 1)
+            values[n++] = k;
+    return values[fpu_gen_next(gen) % n];
+}
+
+// Rounding mode field of fpu_txn : rm_c, rm_fcmp_c, rm_fmv_c and rm_fmin_max_c
+static int draw_rm(fpu_gen* gen, int op)
+{
+    switch (op)
+    {
+        case FPU_OP_FCMP:
+        case FPU_OP_FSGNJ:    return fpu_gen_next(gen) % 3;
+        case FPU_OP_FMIN_MAX: return fpu_gen_next(gen) % 2;
+        case FPU_OP_FMV_F2X:
+        case FPU_OP_FMV_X2F:  return 3;
+        default:              return fpu_gen_next(gen) % 4;
+    }
+}
+
+// NaN-box an operand of width bits in a register of flen bits, or leave its high bits clear
+static uint64_t box(uint64_t value, int width, int flen, bool boxed)
+{
+    if (width >= flen || !boxed)
+        return value;
+    return value | (fpu_low_mask(flen) & ~fpu_low_mask(width));
+}
+
+// Draw the fields of a request
+static void draw_request(fpu_gen* gen, fpu_golden_record* r, uint32_t ops, uint32_t fmts, int xlen, int flen,
+                         int hard_pct, int unboxed_pct, int max_delay)
+{
+    memset(r, 0, sizeof(*r));
+    r->op    = draw_of(gen, ops);
+    r->fmt   = draw_of(gen, fmts);
+    r->rm    = draw_rm(gen, r->op);
+    r->delay = max_delay > 0 ? fpu_gen_next(gen) % (max_delay + 1) : 0;
+
+    // imm selects the source format of FCVT_F2F, the integer format and signedness of the other conversions
+    bool conversion = r->op == FPU_OP_FCVT_F2F || r->op == FPU_OP_FCVT_F2I || r->op == FPU_OP_FCVT_I2F;
+    if (r->op == FPU_OP_FCVT_F2F)
+        r->imm = draw_of(gen, fmts);
+    else if (conversion)
+        r->imm = fpu_gen_next(gen) % 4;
+
+    int                 src   = (r->op == FPU_OP_FCVT_F2F) ? (int) r->imm : r->fmt;
+    const fpu_fmt_desc* desc  = fpu_fmt_get_desc(src);
+    bool                boxed = (int) (fpu_gen_next(gen) % 100) >= unboxed_pct;
+
+    uint64_t a, b, c;
+    if ((int) (fpu_gen_next(gen) % 100) < hard_pct &&
+        fpu_hard_operands(gen, r->op, desc->env, fpu_gen_next(gen) % FPU_HARD_NUM, &a, &b, &c) == 0)
+    {
+        r->operand_a = box(a, desc->width, flen, true);
+        r->operand_b = box(b, desc->width, flen, true);
+        r->imm       = box(c, desc->width, flen, true);
+        return;
+    }
+
+    r->operand_a = (r->op == FPU_OP_FCVT_I2F) ? fpu_gen_int(gen) & fpu_low_mask(xlen)
+                                              : box(fpu_gen_float(gen, desc->env), desc->width, flen, boxed);
+    r->operand_b = box(fpu_gen_float(gen, desc->env), desc->width, flen, boxed);
+    if (!conversion)
+        r->imm = box(fpu_gen_float(gen, desc->env), desc->width, flen, boxed);
+}
+
+static int run_gen(const char* path, uint64_t count, uint64_t seed, uint32_t ops, uint32_t fmts, int xlen, int flen,
+                   int hard_pct, int corner_w, int unboxed_pct, int max_delay)
+{
+    fpu_gen gen;
+    fpu_gen_init(&gen, seed);
+    if (corner_w > 0)
+    {
+        uint32_t class_w[FPU_GEN_CLASS_NUM] = { 1, 1, 1, 1, 30, 66, (uint32_t) corner_w };
+        fpu_gen_set_weights(&gen, class_w, NULL, NULL);
+    }
+
+    std::vector<fpu_golden_record> records(count);
+    uint64_t unsupported = 0;
+    for (uint64_t i = 0; i < count; i++)
+    {
+        fpu_golden_record* r = &records[i];
+        uint64_t result;
+        int      flags = -1;
+
+        // Requests the model does not support are drawn again, the expectations of a file are all defined
+        for (int draw = 0; draw < MAX_DRAWS && flags < 0; draw++)
+        {
+            draw_request(&gen, r, ops, fmts, xlen, flen, hard_pct, unboxed_pct, max_delay);
+            flags = fpu_exec_compute(&result, r->op, r->operand_a, r->operand_b, r->imm, r->fmt, r->rm, xlen, flen);
+            unsupported += flags < 0;
+        }
+        if (flags < 0)
+        {
+            fprintf(stderr, "the model supports none of the requests of these operations and formats\n");
+            return 1;
+        }
+
+        r->result = result;
+        r->flags  = flags;
+    }
+
+    if (fpu_golden_write(path, records.data(), count, xlen, flen, seed) != 0)
+        return 1;
+    printf("%llu records written to %s (%llu unsupported requests drawn again)\n", (unsigned long long) count, path,
+           (unsigned long long) unsupported);
+    return 0;
+}
+
+static int run_print(const char* path)
+{
+    int status = fpu_golden_open(path, 0, 0);
+    if (status < 0)
+        return 1;
+
+    const fpu_golden_header* h        = fpu_golden_get_header();
+    bool                     recorded = h->flags & FPU_GOLDEN_RECORDED;
+    printf("# %llu %s, XLEN=%d FLEN=%d, seed %llu, model %s, MPFR %s, GMP %s%s\n", (unsigned long long) fpu_golden_count(),
+           recorded ? "recorded transactions" : "records", h->xlen, h->flen, (unsigned long long) h->seed, h->model,
+           h->mpfr, h->gmp, status == 1 ? " (another version of the model)" : "");
+    // A recorded stream has no expectations, its transaction ids are printed instead
+    printf("# op fmt rm operand_a operand_b imm %s delay\n", recorded ? "trans_id" : "result flags");
+    for (uint64_t i = 0; i < fpu_golden_count(); i++)
+    {
+        const fpu_golden_record* r = fpu_golden_get(i);
+        printf("%s %s %d %016llx %016llx %016llx ", fpu_op_name(r->op), fpu_fmt_name(r->fmt), r->rm,
+               (unsigned long long) r->operand_a, (unsigned long long) r->operand_b, (unsigned long long) r->imm);
+        if (recorded)
+            printf("%llu %u\n", (unsigned long long) r->trans_id, r->delay);
+        else
+            printf("%016llx %02x %u\n", (unsigned long long) r->result, r->flags, r->delay);
+    }
+    fpu_golden_close();
+    return 0;
+}
+
+//########## HARD-CASE CHECK ###########################################################################################
+
+// Operations of the hard-case generator, see fpu_hard_operands
+static const int hard_ops[] = { FPU_OP_FADD, FPU_OP_FSUB, FPU_OP_FMUL, FPU_OP_FDIV, FPU_OP_FMADD, FPU_OP_FNMADD,
+                                FPU_OP_FMSUB, FPU_OP_FNMSUB, FPU_OP_FSQRT };
+
+// Parameters of a format, the exponents are the ones of the values 1.f * 2^E
+typedef struct
+{
+    int p;
+    int width;
+    int bias;
+    int emin;
+    int emax;
+} check_fmt;
+
+// Property the generator promises for hard, see the substitutions of fpu_hard_operands
+static int promised(int op, int hard, int p)
+{
+    bool sum = op != FPU_OP_FMUL && op != FPU_OP_FDIV && op != FPU_OP_FSQRT;
+    if (hard == FPU_HARD_CANCELLATION && !sum)
+        hard = FPU_HARD_TIE;
+    if (hard == FPU_HARD_TIE && (op == FPU_OP_FDIV || op == FPU_OP_FSQRT))
+        return FPU_HARD_ABOVE_TIE;
+    if ((hard == FPU_HARD_ABOVE_TIE || hard == FPU_HARD_BELOW_TIE) && op == FPU_OP_FMUL && p < 4)
+        return FPU_HARD_TIE;
+    return hard;
+}
+
+// Exact value of an encoding, false for an infinity or a NaN
+static bool decode(mpfr_t v, uint64_t x, const check_fmt& f)
+{
+    uint64_t m = x & fpu_low_mask(f.p - 1);
+    int      e = (int) ((x >> (f.p - 1)) & fpu_low_mask(f.width - f.p));
+    if (e == 2 * f.bias + 1)
+        return false;
+    if (e != 0)
+        m |= 1ULL << (f.p - 1);
+    mpfr_set_ui_2exp(v, m, (e != 0 ? e : 1) - f.bias - (f.p - 1), MPFR_RNDN);
+    if ((x >> (f.width - 1)) & 1)
+        mpfr_neg(v, v, MPFR_RNDN);
+    return true;
+}
+
+// Position of |v| against the midpoints of the format : 0 on a midpoint, 1 (-1) at most a quarter of ulp above (below)
+// one, 2 otherwise. inex is the sign of the error of v, which is rounded toward zero.
+static int midpoint_side(mpfr_t v, int inex, const check_fmt& f)
+{
+    mpfr_t t, floor, half, quarter;
+    mpfr_inits2(mpfr_get_prec(v), t, floor, half, quarter, (mpfr_ptr) 0);
+    mpfr_set_d(half, 0.5, MPFR_RNDN);
+    mpfr_set_d(quarter, 0.25, MPFR_RNDN);
+
+    // Fraction of ulp of |v|, subnormal ulp below the normal range
+    int E = (int) mpfr_get_exp(v) - 1;
+    mpfr_abs(t, v, MPFR_RNDN);
+    mpfr_mul_2si(t, t, -((E > f.emin ? E : f.emin) - (f.p - 1)), MPFR_RNDN);
+    mpfr_rint(floor, t, MPFR_RNDD);
+    mpfr_sub(t, t, floor, MPFR_RNDN);
+
+    int side = mpfr_cmp(t, half);
+    if (side == 0 && inex != 0)
+        side = 1;
+    mpfr_sub(t, t, half, MPFR_RNDN);
+    if (mpfr_cmpabs(t, quarter) > 0)
+        side = 2;
+    mpfr_clears(t, floor, half, quarter, (mpfr_ptr) 0);
+    return side < 0 ? -1 : side > 0 ? side : 0;
+}
+
+// Check the exact result of a hard case, NULL or the property it misses
+static const char* check_case(int op, int hard, const check_fmt& f, uint64_t a, uint64_t b, uint64_t c)
+{
+    mpfr_prec_t prec = 4 * f.bias + 4 * f.p + 64; // exact sums and products of the format
+    mpfr_t      x, y, z, t1, t2, v, lo, hi;
+    const char* error = NULL;
+    int         inex  = 0;
+
+    // The model leaves the exponent range of the last format it evaluated
+    mpfr_exp_t emin = mpfr_get_emin(), emax = mpfr_get_emax();
+    mpfr_set_emin(mpfr_get_emin_min());
+    mpfr_set_emax(mpfr_get_emax_max());
+
+    mpfr_inits2(prec, x, y, z, t1, t2, v, lo, hi, (mpfr_ptr) 0);
+    if (!decode(x, a, f) || !decode(y, b, f) || !decode(z, c, f))
+        error = "infinite or NaN operand";
+
+    // Exact result, the quotients and square roots are rounded toward zero
+    switch (op)
+    {
+    case FPU_OP_FADD:
+    case FPU_OP_FSUB:
+        mpfr_set(t1, y, MPFR_RNDN);
+        mpfr_set(t2, z, MPFR_RNDN);
+        if (op == FPU_OP_FSUB)
+            mpfr_neg(t2, t2, MPFR_RNDN);
+        break;
+    case FPU_OP_FMUL:
+        mpfr_mul(t1, x, y, MPFR_RNDN);
+        mpfr_set_zero(t2, 1);
+        break;
+    case FPU_OP_FDIV:
+        inex = mpfr_div(t1, x, y, MPFR_RNDZ);
+        mpfr_set_zero(t2, 1);
+        break;
+    case FPU_OP_FSQRT:
+        inex = mpfr_sqrt(t1, x, MPFR_RNDZ);
+        mpfr_set_zero(t2, 1);
+        break;
+    default:
+        mpfr_mul(t1, x, y, MPFR_RNDN);
+        mpfr_set(t2, z, MPFR_RNDN);
+        if (op == FPU_OP_FNMADD || op == FPU_OP_FNMSUB)
+            mpfr_neg(t1, t1, MPFR_RNDN);
+        if (op == FPU_OP_FNMADD || op == FPU_OP_FMSUB)
+            mpfr_neg(t2, t2, MPFR_RNDN);
+        break;
+    }
+    mpfr_add(v, t1, t2, MPFR_RNDN);
+
+    int property = promised(op, hard, f.p);
+    if (error != NULL)
+        ;
+    else if (op == FPU_OP_FSQRT && (property == FPU_HARD_UNDERFLOW || property == FPU_HARD_OVERFLOW))
+    {
+        // Smallest subnormal and largest normal operands
+        uint64_t expected = property == FPU_HARD_UNDERFLOW ? 1 : ((uint64_t) 2 * f.bias << (f.p - 1)) | fpu_low_mask(f.p - 1);
+        if ((a & fpu_low_mask(f.width)) != expected)
+            error = property == FPU_HARD_UNDERFLOW ? "operand is not the smallest subnormal"
+                                                   : "operand is not the largest normal";
+    }
+    else if (property == FPU_HARD_UNDERFLOW)
+    {
+        // Largest subnormal for an exact sum, strictly between it and the smallest normal otherwise
+        mpfr_set_ui_2exp(lo, fpu_low_mask(f.p - 1), f.emin - (f.p - 1), MPFR_RNDN);
+        mpfr_set_ui_2exp(hi, 1, f.emin, MPFR_RNDN);
+        if (op == FPU_OP_FADD || op == FPU_OP_FSUB ? mpfr_cmpabs(v, lo) != 0
+                                                   : mpfr_cmpabs(v, lo) <= 0 || mpfr_cmpabs(v, hi) >= 0)
+            error = "not between the largest subnormal and the smallest normal";
+    }
+    else if (property == FPU_HARD_OVERFLOW)
+    {
+        // Overflow threshold 2^(emax+1) for a quotient, the midpoint above the largest normal otherwise, or up to two
+        // ulps below it for a product when p+1 is prime
+        mpfr_set_ui_2exp(hi, fpu_low_mask(f.p + 1), f.emax - f.p, MPFR_RNDN);
+        mpfr_set_ui_2exp(lo, (1ULL << (f.p + 1)) - 5, f.emax - f.p, MPFR_RNDN);
+        if (op == FPU_OP_FDIV)
+            mpfr_set_ui_2exp(hi, 1, f.emax + 1, MPFR_RNDN);
+        if (op == FPU_OP_FMUL ? mpfr_cmpabs(v, lo) <= 0 || mpfr_cmpabs(v, hi) > 0 : mpfr_cmpabs(v, hi) != 0)
+            error = "not on the overflow midpoint";
+    }
+    else if (property == FPU_HARD_CANCELLATION)
+    {
+        // Terms of opposite signs, at least p - p/2 - 1 leading bits cancel
+        if (mpfr_sgn(t1) * mpfr_sgn(t2) >= 0)
+            error = "terms of the same sign";
+        else if (!mpfr_zero_p(v) && mpfr_get_exp(v) > mpfr_get_exp(mpfr_cmpabs(t1, t2) >= 0 ? t1 : t2) - (f.p - f.p / 2 - 1))
+            error = "no cancellation";
+    }
+    else if (mpfr_zero_p(v))
+        error = "zero result";
+    else
+    {
+        int side = midpoint_side(v, inex, f);
+        if (side != (property == FPU_HARD_TIE ? 0 : property == FPU_HARD_ABOVE_TIE ? 1 : -1))
+            error = side == 0 ? "on a midpoint" : side == 1 ? "just above a midpoint" : side == -1 ? "just below a midpoint"
+                                                                                             : "far from a midpoint";
+    }
+
+    mpfr_clears(x, y, z, t1, t2, v, lo, hi, (mpfr_ptr) 0);
+    mpfr_set_emin(emin);
+    mpfr_set_emax(emax);
+    return error;
+}
+
+// Check the properties of the hard cases of every operation in the formats of fmts, and that the model rounds them
+// to nearest, ties away from zero, as the other rounding modes predict it
+static int run_check(uint64_t count, uint64_t seed, uint32_t fmts)
+{
+    fpu_gen  gen;
+    uint64_t checked = 0, failures = 0;
+    fpu_gen_init(&gen, seed);
+
+    for (int fmt = 0; fmt < FPU_DST_FMT_NUM; fmt++)
+    {
+        if (!((fmts >> fmt) & 1))
+            continue;
+        const fpu_fmt_desc* desc = fpu_fmt_get_desc(fmt);
+        check_fmt           f;
+        f.p     = MBITS(desc->env) + 1;
+        f.width = desc->width;
+        f.bias  = (1 << (ES(desc->env.es) - 1)) - 1;
+        f.emin  = 1 - f.bias;
+        f.emax  = f.bias;
+
+        for (size_t k = 0; k < sizeof(hard_ops) / sizeof(hard_ops[0]); k++)
+        {
+            int op = hard_ops[k];
+            for (int hard = 0; hard < FPU_HARD_NUM; hard++)
+            {
+                for (uint64_t i = 0; i < count; i++)
+                {
+                    uint64_t a, b, c, result, expected;
+                    if (fpu_hard_operands(&gen, op, desc->env, hard, &a, &b, &c) != 0)
+                    {
+                        fprintf(stderr, "no hard case of %s in %s\n", fpu_op_name(op), fpu_fmt_name(fmt));
+                        return 1;
+                    }
+
+                    const char* error = check_case(op, hard, f, a, b, c);
+                    a = box(a, f.width, 64, true);
+                    b = box(b, f.width, 64, true);
+                    c = box(c, f.width, 64, true);
+                    int flags     = fpu_exec_compute(&result, op, a, b, c, fmt, 4, 64, 64);
+                    int rmm_flags = fpu_exec_rmm_expected(&expected, op, a, b, c, fmt, 64, 64);
+                    if (error == NULL && (flags != rmm_flags || (flags >= 0 && result != expected)))
+                        error = "RMM result";
+
+                    checked++;
+                    if (error != NULL && failures++ < CHECK_SHOW)
+                        printf("  %s %s %s %016llx %016llx %016llx : %s\n", fpu_op_name(op), fpu_fmt_name(fmt),
+                               fpu_hard_name(hard), (unsigned long long) a, (unsigned long long) b,
+                               (unsigned long long) c, error);
+                }
+            }
+        }
+    }
+
+    printf("%llu hard cases checked, %llu failures\n", (unsigned long long) checked, (unsigned long long) failures);
+    if (failures != 0)
+        return 1;
+    printf("Hard-case self-check passed\n");
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    const char* path = NULL;
+    const char* print = NULL;
+    bool        check = false;
+    uint64_t    count = 0, seed = 1;
+    uint32_t    ops = 0, fmts = 0;
+    int         xlen = 64, flen = 64;
+    int         hard_pct = 0, corner_w = 0, unboxed_pct = DEFAULT_UNBOXED, max_delay = 0;
+
+    // fadd to fclass, the operations of fpu_operator_c
+    for (int op = FPU_OP_FADD; op <= FPU_OP_FCLASS; op++)
+        ops |= 1u << op;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = val != NULL;
+
+        if (arg[0] != '-' && path == NULL)
+        {
+            path = arg;
+            continue;
+        }
+        if (strcmp(arg, "--check") == 0)
+        {
+            check = true;
+            continue;
+        }
+        if (ok && strcmp(arg, "--print") == 0)
+            print = val;
+        else if (ok && strcmp(arg, "--count") == 0)
+            ok = (count = strtoull(val, NULL, 0)) > 0;
+        else if (ok && strcmp(arg, "--seed") == 0)
+            seed = strtoull(val, NULL, 0);
+        else if (ok && strcmp(arg, "--ops") == 0)
+            ok = parse_list(val, fpu_op_name, FPU_OP_NUM, &ops);
+        else if (ok && strcmp(arg, "--fmts") == 0)
+            ok = parse_list(val, fpu_fmt_name, FPU_DST_FMT_NUM, &fmts);
+        else if (ok && strcmp(arg, "--xlen") == 0)
+            xlen = atoi(val);
+        else if (ok && strcmp(arg, "--flen") == 0)
+            flen = atoi(val);
+        else if (ok && strcmp(arg, "--hard") == 0)
+            ok = (hard_pct = atoi(val)) >= 0 && hard_pct <= 100;
+        else if (ok && strcmp(arg, "--corner-w") == 0)
+            ok = (corner_w = atoi(val)) >= 0;
+        else if (ok && strcmp(arg, "--unboxed") == 0)
+            ok = (unboxed_pct = atoi(val)) >= 0 && unboxed_pct <= 100;
+        else if (ok && strcmp(arg, "--max-delay") == 0)
+            ok = (max_delay = atoi(val)) >= 0;
+        else
+            ok = false;
+
+        if (!ok)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+
+    if (print != NULL)
+        return run_print(print);
+    if (check)
+        return run_check(count != 0 ? count : DEFAULT_CHECKS, seed, fmts != 0 ? fmts : (1u << FPU_DST_FMT_NUM) - 1);
+    if (path == NULL || (xlen != 32 && xlen != 64) || (flen != 32 && flen != 64))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    if (count == 0)
+        count = DEFAULT_COUNT;
+    if (fmts == 0)
+        fmts = (1u << FPU_FMT_FP32) | (1u << FPU_FMT_FP64);
+    return run_gen(path, count, seed, ops, fmts, xlen, flen, hard_pct, corner_w, unboxed_pct, max_delay);
+}
@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Command line front-end of the reference model
+ *  History       :
+ */
+
+#include "fpu_exec.h"
+#include "fpu_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define LINE_SIZE 256
+
+static const char* rm_names[5]   = { "rne", "rtz", "rdn", "rup", "rmm" };
+static const char* flag_names[5] = { "NX", "UF", "OF", "DZ", "NV" };
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [--xlen <n>] [--flen <n>] [--compute] <op> <fmt> <rm> <a> [<b> [<c>]]\n", name);
+    printf("       %s [--xlen <n>] [--flen <n>] [--compute] -\n", name);
+    printf("  <op>          operation name (fadd, fcvt_f2i, ...) or code, see fpu_op_e\n");
+    printf("  <fmt>         destination format name (fp32, fp64, fp16, fp8) or code\n");
+    printf("  <rm>          rounding mode name (rne, rtz, rdn, rup, rmm) or rm field value\n");
+    printf("  <a> <b> <c>   operand_a, operand_b and imm fields, in hexadecimal (default 0)\n");
+    printf("  -             read one request per line on the standard input, print one response per line\n");
+    printf("  --xlen <n>    integer register width, 32 or 64 (default 64)\n");
+    printf("  --flen <n>    floating point register width, 32 or 64 (default 64)\n");
+    printf("  --compute     bypass the result cache and the persistent store\n");
+    printf("The response is the expected result and exception flags, in hexadecimal.\n");
+}
+
+static const char* rm_name(int rm)
+{
+    return rm < 5 ? rm_names[rm] : NULL;
+}
+
+static const char* fmt_name(int fmt)
+{
+    return fpu_fmt_get_desc(fmt)->valid ? fpu_fmt_name(fmt) : NULL;
+}
+
+static bool parse_hex(const char* s, uint64_t* value)
+{
+    char* end;
+    *value = strtoull(s, &end, 16);
+    return *s != '\0' && *end == '\0';
+}
+
+// Parse and execute a request, print the response
+static bool run(int argc, char** argv, int xlen, int flen, bool compute, bool verbose)
+{
+    uint64_t operands[3] = { 0, 0, 0 };
+    int op  = fpu_parse_code(argv[0], fpu_op_name, FPU_OP_NUM);
+    int fmt = fpu_parse_code(argv[1], fmt_name, FPU_FMT_NUM);
+    int rm  = fpu_parse_code(argv[2], rm_name, 8);
+
+    if (op < 0 || fmt < 0 || rm < 0)
+    {
+        fprintf(stderr, "invalid %s : %s\n", op < 0 ? "operation" : fmt < 0 ? "format" : "rounding mode",
+                op < 0 ? argv[0] : fmt < 0 ? argv[1] : argv[2]);
+        return false;
+    }
+    for (int i = 3; i < argc; i++)
+        if (!parse_hex(argv[i], &operands[i - 3]))
+        {
+            fprintf(stderr, "invalid operand : %s\n", argv[i]);
+            return false;
+        }
+
+    uint64_t result = 0;
+    int flags = compute ? fpu_exec_compute(&result, op, operands[0], operands[1], operands[2], fmt, rm, xlen, flen)
+                        : fpu_exec(&result, op, operands[0], operands[1], operands[2], fmt, rm, xlen, flen);
+    if (flags < 0)
+    {
+        printf("unsupported\n");
+        return true;
+    }
+
+    printf("%016llx %02x", (unsigned long long) result, flags);
+    if (verbose)
+        for (int bit = 0; bit < 5; bit++)
+            if ((flags >> bit) & 1)
+                printf(" %s", flag_names[bit]);
+    printf("\n");
+    return true;
+}
+
+// One request per line, blank lines and comments are skipped
+static int run_stream(int xlen, int flen, bool compute)
+{
+    char line[LINE_SIZE];
+    int  line_number = 0, errors = 0;
+
+    while (fgets(line, sizeof(line), stdin) != NULL)
+    {
+        char* fields[6];
+        int   n = 0;
+
+        line_number++;
+        for (char* tok = strtok(line, " \t\r\n"); tok != NULL && n < 6; tok = strtok(NULL, " \t\r\n"))
+            fields[n++] = tok;
+        if (n == 0 || fields[0][0] == '#')
+            continue;
+
+        if (n < 4 || !run(n, fields, xlen, flen, compute, false))
+        {
+            fprintf(stderr, "line %d : expected <op> <fmt> <rm> <a> [<b> [<c>]]\n", line_number);
+            errors++;
+        }
+    }
+    return errors ? 1 : 0;
+}
+
+int main(int argc, char** argv)
+{
+    int  xlen = 64, flen = 64;
+    bool compute = false;
+    int  i = 1;
+
+    for (; i < argc && strncmp(argv[i], "--", 2) == 0; i++)
+    {
+        if (strcmp(argv[i], "--compute") == 0)
+            compute = true;
+        else if (strcmp(argv[i], "--xlen") == 0 && i + 1 < argc)
+            xlen = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--flen") == 0 && i + 1 < argc)
+            flen = atoi(argv[++i]);
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if ((xlen != 32 && xlen != 64) || (flen != 32 && flen != 64))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (argc - i == 1 && strcmp(argv[i], "-") == 0)
+        return run_stream(xlen, flen, compute);
+
+    if (argc - i < 4 || argc - i > 6)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    return run(argc - i, argv + i, xlen, flen, compute, true) ? 0 : 2;
+}
@@ -0,0 +1,519 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Check and generation of test vectors in the text format of Berkeley TestFloat
+ *  History       :
+ */
+
+#include "fpu_exec.h"
+#include "fpu_testfloat.h"
+#include "fpu_util.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define DEFAULT_SHOW      20
+#define DEFAULT_COUNT     100000
+#define CHECK_CHUNKS      16      /**< chunks of the input per thread */
+#define GEN_CHUNK_VECTORS 65536   /**< vectors generated by a task */
+
+// Rounding modes, by RTL encoding : names of the model and of TestFloat (-rnear_even, ...)
+static const char* rm_names[FPU_RM_NUM]           = { "rne", "rtz", "rdn", "rup", "rmm" };
+static const char* rm_testfloat_names[FPU_RM_NUM] = { "near_even", "minMag", "min", "max", "near_maxMag" };
+
+static void usage(const char* name)
+{
+    printf("Usage: %s --list\n", name);
+    printf("       %s --check <function> [options] <file>\n", name);
+    printf("       %s --gen <function> [options]\n", name);
+    printf("  --list               print the functions supported by the model\n");
+    printf("  --check <function>   compare the vectors of <file> (- for the standard input) with the model\n");
+    printf("  --gen <function>     write vectors computed by the model\n");
+    printf("  --rm <rm>            rounding mode of the vectors, rne, rtz, rdn, rup, rmm or near_even, minMag, min,\n");
+    printf("                       max, near_maxMag (default rne)\n");
+    printf("  --threads <n>        worker threads (default: hardware threads)\n");
+    printf("  --show <n>           --check : mismatches printed in line order (default %d)\n", DEFAULT_SHOW);
+    printf("  --count <n>          --gen : number of vectors (default %d)\n", DEFAULT_COUNT);
+    printf("  --seed <n>           --gen : seed of the operands (default 1)\n");
+    printf("  --output <file>      --gen : output file (default: standard output)\n");
+    printf("Functions are named as in TestFloat, e.g. f32_mulAdd or ui64_to_f16, see fpu_testfloat.h. The exit status\n");
+    printf("of --check is 1 when a vector differs from the model or a line is malformed.\n");
+}
+
+static int parse_rm(const char* s)
+{
+    for (int rm = 0; rm < FPU_RM_NUM; rm++)
+        if (strcmp(s, rm_names[rm]) == 0 || strcmp(s, rm_testfloat_names[rm]) == 0)
+            return rm;
+    return -1;
+}
+
+//########## CHECK #####################################################################################################
+
+typedef struct
+{
+    uint64_t             line;      /**< line number in the chunk, from 0 */
+    const char*          text;      /**< start of the line */
+    bool                 malformed;
+    fpu_testfloat_vector model;     /**< result and flags of the model */
+} mismatch;
+
+typedef struct
+{
+    const char*           begin;
+    const char*           end;
+    uint64_t              lines;
+    uint64_t              vectors;
+    uint64_t              mismatches;
+    uint64_t              malformed;
+    std::vector<mismatch> first;
+} check_chunk;
+
+typedef struct
+{
+    const fpu_testfloat_function* function;
+    int                           rm;
+    size_t                        show;
+    std::vector<check_chunk>      chunks;
+    std::atomic<size_t>           next;
+} check_state;
+
+static void check_worker(check_state* s)
+{
+    for (size_t c = s->next.fetch_add(1); c < s->chunks.size(); c = s->next.fetch_add(1))
+    {
+        check_chunk* k = &s->chunks[c];
+        const char*  p = k->begin;
+
+        while (p < k->end)
+        {
+            const char* line = p;
+            const char* eol  = (const char*) memchr(p, '\n', k->end - p);
+            const char* next = eol != NULL ? eol + 1 : k->end;
+            k->lines++;
+
+            // Blank lines are skipped
+            const char* q = line;
+            while (q < next && (*q == ' ' || *q == '\t' || *q == '\r' || *q == '\n'))
+                q++;
+            if (q == next)
+            {
+                p = next;
+                continue;
+            }
+
+            fpu_testfloat_vector vector, model;
+            bool malformed = fpu_testfloat_parse(line, k->end, s->function, &vector) == NULL;
+            model = vector;
+            if (!malformed)
+            {
+                k->vectors++;
+                malformed = fpu_testfloat_exec(s->function, s->rm, &model) < 0;
+            }
+
+            if (malformed || model.result != vector.result || model.flags != vector.flags)
+            {
+                if (malformed)
+                    k->malformed++;
+                else
+                    k->mismatches++;
+                if (k->first.size() < s->show)
+                {
+                    mismatch m = { k->lines - 1, line, malformed, model };
+                    k->first.push_back(m);
+                }
+            }
+            p = next;
+        }
+    }
+}
+
+// Map a regular file, read a pipe into memory
+static bool load_input(const char* path, const char** data, size_t* size, std::string* buffer)
+{
+    int fd = strcmp(path, "-") == 0 ? 0 : open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0)
+    {
+        perror(path);
+        return false;
+    }
+
+    if (S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        void* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            madvise(map, st.st_size, MADV_SEQUENTIAL);
+            *data = (const char*) map;
+            *size = st.st_size;
+            if (fd != 0)
+                close(fd);
+            return true;
+        }
+    }
+
+    char    block[1 << 16];
+    ssize_t n;
+    while ((n = read(fd, block, sizeof(block))) > 0)
+        buffer->append(block, n);
+    if (fd != 0)
+        close(fd);
+    if (n < 0)
+    {
+        perror(path);
+        return false;
+    }
+    *data = buffer->data();
+    *size = buffer->size();
+    return true;
+}
+
+static int run_check(const fpu_testfloat_function* function, int rm, const char* path, int threads, size_t show)
+{
+    const char* data = NULL;
+    size_t      size = 0;
+    std::string buffer;
+    if (!load_input(path, &data, &size, &buffer))
+        return 2;
+
+    check_state s;
+    s.function = function;
+    s.rm       = rm;
+    s.show     = show;
+    s.next     = 0;
+
+    // Chunks end on line boundaries
+    size_t nchunks = (size_t) threads * CHECK_CHUNKS;
+    const char* end = data + size;
+    for (const char* p = data; p < end; )
+    {
+        const char* cut = p + std::max(size / nchunks, (size_t) 1);
+        if (cut >= end)
+            cut = end;
+        else
+        {
+            const char* eol = (const char*) memchr(cut, '\n', end - cut);
+            cut = eol != NULL ? eol + 1 : end;
+        }
+        check_chunk k = { p, cut, 0, 0, 0, 0, std::vector<mismatch>() };
+        s.chunks.push_back(k);
+        p = cut;
+    }
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.push_back(std::thread(check_worker, &s));
+    check_worker(&s);
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // Chunks are in file order, their first mismatches are numbered by the lines of the previous chunks
+    uint64_t vectors = 0, mismatches = 0, malformed = 0, line_base = 0;
+    size_t   shown = 0;
+    for (size_t c = 0; c < s.chunks.size(); c++)
+    {
+        const check_chunk* k = &s.chunks[c];
+        for (size_t i = 0; i < k->first.size() && shown < show; i++, shown++)
+        {
+            const mismatch* m   = &k->first[i];
+            const char*     eol = (const char*) memchr(m->text, '\n', k->end - m->text);
+            int             len = (eol != NULL ? eol : k->end) - m->text;
+            if (len > 0 && m->text[len - 1] == '\r')
+                len--;
+
+            if (m->malformed)
+                printf("line %llu : %.*s : malformed\n", (unsigned long long) (line_base + m->line + 1), len, m->text);
+            else
+                printf("line %llu : %.*s : model %0*llX %02X\n", (unsigned long long) (line_base + m->line + 1), len,
+                       m->text, (function->result_bits + 3) / 4, (unsigned long long) m->model.result,
+                       fpu_testfloat_flags_from_model(m->model.flags));
+        }
+        vectors    += k->vectors;
+        mismatches += k->mismatches;
+        malformed  += k->malformed;
+        line_base  += k->lines;
+    }
+
+    printf("%s %s : %llu vectors, %llu mismatches, %llu malformed lines, %d threads, %.2f s, %.2f Mvectors/s\n",
+           function->name, function->rm == FPU_TESTFLOAT_RM_FIXED ? rm_names[rm] : "-", (unsigned long long) vectors,
+           (unsigned long long) mismatches, (unsigned long long) malformed, threads, seconds,
+           seconds > 0 ? vectors / seconds / 1e6 : 0.0);
+
+    if (buffer.empty() && size > 0)
+        munmap((void*) data, size);
+    return mismatches || malformed ? 1 : 0;
+}
+
+//########## GENERATION ################################################################################################
+
+// Random encoding of a floating point format, biased towards special values, values around one (cancellations of
+// additions), subnormals and fractions of few set bits (rounding boundaries)
+static uint64_t random_float(uint64_t* state, environment env)
+{
+    int      width = env.bis + 1, es = env.es + 1, ms = width - 1 - es;
+    uint64_t r     = fpu_splitmix64(state);
+    uint64_t sign  = (r >> 63) << (width - 1);
+    uint64_t emax  = fpu_low_mask(es), bias = fpu_low_mask(es - 1);
+    uint64_t frac  = fpu_splitmix64(state) & fpu_low_mask(ms);
+    uint64_t e;
+
+    switch (r & 7)
+    {
+    case 0:
+    {
+        const uint64_t specials[] = { 0, 1, fpu_low_mask(ms), 1ULL << ms, bias << ms, (emax << ms) - 1, emax << ms,
+                                      (emax << ms) | (1ULL << (ms - 1)), (emax << ms) | 1 };
+        return sign | specials[(r >> 8) % (sizeof(specials) / sizeof(specials[0]))];
+    }
+    case 1:
+        e = bias + (r >> 8) % (2 * ms + 3) - (ms + 1);
+        e = std::min(std::max(e, (uint64_t) 1), emax - 1);
+        return sign | (e << ms) | frac;
+    case 2:
+        return sign | frac;
+    case 3:
+        e = 1 + (r >> 8) % (emax - 1);
+        frac = (r >> 40) & 1 ? fpu_low_mask((r >> 32) % (ms + 1)) : (1ULL << ((r >> 32) % ms));
+        return sign | (e << ms) | frac;
+    default:
+        return fpu_splitmix64(state) & fpu_low_mask(width);
+    }
+}
+
+// Random integer, biased towards the bounds of the formats and the limits of exact conversions
+static uint64_t random_int(uint64_t* state, int bits)
+{
+    uint64_t r = fpu_splitmix64(state);
+
+    switch (r & 7)
+    {
+    case 0:
+    {
+        const uint64_t specials[] = { 0, 1, ~0ULL, 1ULL << (bits - 1), fpu_low_mask(bits - 1), (1ULL << 11) + 1,
+                                      (1ULL << 24) + 1, (1ULL << 53) + 1 };
+        return specials[(r >> 8) % (sizeof(specials) / sizeof(specials[0]))] & fpu_low_mask(bits);
+    }
+    case 1:
+        return ((r >> 63) ? -((r >> 8) & 0xFFFF) : (r >> 8) & 0xFFFF) & fpu_low_mask(bits);
+    case 2:
+        return (fpu_splitmix64(state) >> (r >> 8) % bits) & fpu_low_mask(bits);
+    default:
+        return fpu_splitmix64(state) & fpu_low_mask(bits);
+    }
+}
+
+typedef struct
+{
+    const fpu_testfloat_function* function;
+    int                           rm;
+    uint64_t                      seed;
+    uint64_t                      count;
+    uint64_t                      first_chunk;  /**< first chunk of the batch */
+    std::vector<std::string>*     buffers;      /**< lines of each chunk of the batch */
+    std::atomic<size_t>           next;
+    std::atomic<bool>             unsupported;
+} gen_state;
+
+static void gen_worker(gen_state* s)
+{
+    environment env = { 0, 0 };
+    if (s->function->operand_fmt < FPU_FMT_NUM)
+        env = fpu_fmt_get_desc(s->function->operand_fmt)->env;
+
+    for (size_t b = s->next.fetch_add(1); b < s->buffers->size(); b = s->next.fetch_add(1))
+    {
+        uint64_t     chunk = s->first_chunk + b;
+        uint64_t     first = chunk * GEN_CHUNK_VECTORS;
+        uint64_t     last  = std::min(first + GEN_CHUNK_VECTORS, s->count);
+        uint64_t     state = s->seed ^ (chunk * 0xD1B54A32D192ED03ULL);
+        std::string* out   = &(*s->buffers)[b];
+        char         line[FPU_TESTFLOAT_LINE_MAX];
+
+        out->clear();
+        out->reserve((last - first) * (s->function->noperands + 1) * (s->function->operand_bits / 4 + 1));
+        for (uint64_t i = first; i < last; i++)
+        {
+            fpu_testfloat_vector v = { { 0, 0, 0 }, 0, 0 };
+            for (int k = 0; k < s->function->noperands; k++)
+                v.operands[k] = s->function->operand_fmt < FPU_FMT_NUM ? random_float(&state, env)
+                                                                       : random_int(&state, s->function->operand_bits);
+            if (fpu_testfloat_exec(s->function, s->rm, &v) < 0)
+            {
+                s->unsupported = true;
+                return;
+            }
+            out->append(line, fpu_testfloat_format(line, s->function, &v) - line);
+        }
+    }
+}
+
+static int run_gen(const fpu_testfloat_function* function, int rm, uint64_t count, uint64_t seed, const char* path,
+                   int threads)
+{
+    FILE* out = path != NULL ? fopen(path, "w") : stdout;
+    if (out == NULL)
+    {
+        perror(path);
+        return 2;
+    }
+
+    // Batches of chunks are generated in parallel and written in order
+    uint64_t                 nchunks = (count + GEN_CHUNK_VECTORS - 1) / GEN_CHUNK_VECTORS;
+    std::vector<std::string> buffers;
+    gen_state s;
+    s.function    = function;
+    s.rm          = rm;
+    s.seed        = fpu_splitmix64(&seed);
+    s.count       = count;
+    s.buffers     = &buffers;
+    s.unsupported = false;
+
+    for (uint64_t c = 0; c < nchunks && !s.unsupported; c += buffers.size())
+    {
+        buffers.resize(std::min((uint64_t) threads * 2, nchunks - c));
+        s.first_chunk = c;
+        s.next        = 0;
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++)
+            pool.push_back(std::thread(gen_worker, &s));
+        gen_worker(&s);
+        for (size_t t = 0; t < pool.size(); t++)
+            pool[t].join();
+
+        for (size_t b = 0; b < buffers.size() && !s.unsupported; b++)
+            fwrite(buffers[b].data(), 1, buffers[b].size(), out);
+    }
+
+    bool failed = ferror(out) != 0;
+    if (path != NULL && fclose(out) != 0)
+        failed = true;
+    if (s.unsupported)
+    {
+        fprintf(stderr, "%s is not supported by the model\n", function->name);
+        return 2;
+    }
+    if (failed)
+    {
+        perror(path != NULL ? path : "stdout");
+        return 2;
+    }
+    return 0;
+}
+
+//########## MAIN ######################################################################################################
+
+int main(int argc, char** argv)
+{
+    const char* check = NULL;
+    const char* gen = NULL;
+    const char* output = NULL;
+    const char* path = NULL;
+    bool        list = false;
+    int         rm = 0;
+    int         threads = std::thread::hardware_concurrency();
+    long        show = DEFAULT_SHOW;
+    uint64_t    count = DEFAULT_COUNT, seed = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = val != NULL;
+
+        if ((arg[0] != '-' || strcmp(arg, "-") == 0) && path == NULL)
+        {
+            path = arg;
+            continue;
+        }
+        if (strcmp(arg, "--list") == 0)
+        {
+            list = true;
+            continue;
+        }
+        if (ok && strcmp(arg, "--check") == 0)
+            check = val;
+        else if (ok && strcmp(arg, "--gen") == 0)
+            gen = val;
+        else if (ok && strcmp(arg, "--rm") == 0)
+            ok = (rm = parse_rm(val)) >= 0;
+        else if (ok && strcmp(arg, "--threads") == 0)
+            ok = (threads = atoi(val)) > 0;
+        else if (ok && strcmp(arg, "--show") == 0)
+            ok = (show = atol(val)) >= 0;
+        else if (ok && strcmp(arg, "--count") == 0)
+            count = strtoull(val, NULL, 0);
+        else if (ok && strcmp(arg, "--seed") == 0)
+            seed = strtoull(val, NULL, 0);
+        else if (ok && strcmp(arg, "--output") == 0)
+            output = val;
+        else
+            ok = false;
+
+        if (!ok)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+
+    if (list)
+    {
+        int num;
+        const fpu_testfloat_function* functions = fpu_testfloat_functions(&num);
+        for (int i = 0; i < num; i++)
+            printf("%s\n", functions[i].name);
+        return 0;
+    }
+    if ((check == NULL) == (gen == NULL) || (check != NULL) != (path != NULL))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    const fpu_testfloat_function* function = fpu_testfloat_find(check != NULL ? check : gen);
+    if (function == NULL)
+    {
+        fprintf(stderr, "%s : unknown function, see --list\n", check != NULL ? check : gen);
+        return 2;
+    }
+
+    threads = fpu_mpfr_threads(threads);
+
+    if (check != NULL)
+        return run_check(function, rm, path, threads, show);
+    return run_gen(function, rm, count, seed, output, threads);
+}
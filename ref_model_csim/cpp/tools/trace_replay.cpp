@@ -0,0 +1,595 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Parallel replay of a recorded DPI trace, differences with the current model grouped by operation,
+ *                  format, rounding mode and operand class
+ *  History       :
+ */
+
+#include "fpu_exec.h"
+#include "fpu_stats.h"
+#include "fpu_store.h"
+#include "fpu_trace.h"
+#include "fpu_dpi.h"
+#include "fpu_util.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define DEFAULT_SHOW  10 /**< differences printed in record order */
+
+typedef enum
+{
+    BACKEND_NATIVE = 0,     /**< dpi_fpu_exec records through fpu_exec, with the cache and the store when enabled */
+    BACKEND_COMPUTE,        /**< dpi_fpu_exec records through fpu_exec_compute */
+    BACKEND_ALL_RM,         /**< dpi_fpu_exec records through fpu_exec_all_rm, fpu_exec_compute for the operations that do not round */
+    BACKEND_NUM
+} backend_e;
+
+static const char* backend_names[BACKEND_NUM] = { "native", "compute", "all-rm" };
+
+// Operand classes of the report, integer operands are not classified
+typedef enum
+{
+    CLS_NONE = 0, CLS_ZERO, CLS_SUBNORMAL, CLS_NORMAL, CLS_INF, CLS_QNAN, CLS_SNAN, CLS_UNBOXED, CLS_INT, CLS_NUM
+} operand_class_e;
+
+static const char* class_names[CLS_NUM] = { "-", "zero", "subnorm", "normal", "inf", "qnan", "snan", "unboxed", "int" };
+
+static const char* entry_names[FPU_STATS_ENTRY_NUM] = { "dpi", "exec", "all_rm" };
+
+// Floating point operands of each operation, an integer operand is counted as 1 and classified as CLS_INT
+static const int op_arity[FPU_OP_NUM] = { 2, 2, 2, 2, 3, 3, 3, 3, 2, 1, 2, 2, 1, 1, 1, 1, 1, 1 };
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [--backend <name>] [--threads <n>] [--show <n>] <trace>\n", name);
+    printf("  <trace>              trace recorded with +REFMODEL_TRACE, see fpu_trace.h\n");
+    printf("  --backend <name>     model of the dpi_fpu_exec records, the other records go through the entry that\n");
+    printf("                       recorded them\n");
+    printf("                         native   fpu_exec, with the cache and the store when enabled (default)\n");
+    printf("                         compute  fpu_exec_compute\n");
+    printf("                         all-rm   fpu_exec_all_rm, for the operations that round\n");
+    printf("  --threads <n>        worker threads (default: hardware threads)\n");
+    printf("  --show <n>           differences printed in record order (default %d)\n", DEFAULT_SHOW);
+    printf("The exit status is 1 when a record differs.\n");
+}
+
+//########## TRACE FILE ################################################################################################
+
+typedef struct
+{
+    size_t   offset;            /**< offset of the block header in the file */
+    uint64_t first;             /**< index of the first record of the block */
+    uint32_t nrecords;          /**< records of the block, fewer than recorded if the block is truncated */
+} block_ref;
+
+typedef struct
+{
+    const uint8_t*          data;
+    size_t                  size;
+    const fpu_trace_header* header;
+    std::vector<block_ref>  blocks;
+    uint64_t                nrecords;
+} trace_map;
+
+// Map a trace and index its blocks
+static bool trace_map_open(trace_map* t, const char* path)
+{
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0)
+    {
+        perror(path);
+        if (fd >= 0)
+            close(fd);
+        return false;
+    }
+    t->size = st.st_size;
+    if (t->size < sizeof(fpu_trace_header))
+    {
+        fprintf(stderr, "%s : not a trace\n", path);
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(NULL, t->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        perror(path);
+        return false;
+    }
+    madvise(data, t->size, MADV_SEQUENTIAL);
+    t->data   = (const uint8_t*) data;
+    t->header = (const fpu_trace_header*) data;
+
+    if (t->header->magic != FPU_TRACE_MAGIC || t->header->version != FPU_TRACE_VERSION ||
+        t->header->record_size != sizeof(fpu_trace_record))
+    {
+        fprintf(stderr, "%s : not a trace of version %d\n", path, FPU_TRACE_VERSION);
+        return false;
+    }
+
+    bool   compressed = t->header->flags & FPU_TRACE_COMPRESSED;
+    size_t offset     = sizeof(fpu_trace_header);
+    t->nrecords = 0;
+    while (offset + sizeof(fpu_trace_block) <= t->size)
+    {
+        // Compressed payloads have any size, block headers are not aligned
+        fpu_trace_block b;
+        memcpy(&b, t->data + offset, sizeof(b));
+        size_t available = t->size - offset - sizeof(fpu_trace_block);
+        if (!compressed && b.nbytes != b.nrecords * sizeof(fpu_trace_record))
+            break;
+        if (b.nbytes > available)
+        {
+            // Trace of a simulation that did not end, the complete records of the block are kept
+            if (compressed || available < sizeof(fpu_trace_record))
+                break;
+            b.nrecords = available / sizeof(fpu_trace_record);
+            fprintf(stderr, "%s : last block truncated, %u records kept\n", path, b.nrecords);
+        }
+        block_ref ref = { offset, t->nrecords, b.nrecords };
+        t->blocks.push_back(ref);
+        t->nrecords += b.nrecords;
+        offset += sizeof(fpu_trace_block) + b.nbytes;
+    }
+    if (offset < t->size)
+        fprintf(stderr, "%s : truncated or corrupted block at offset %zu, ignored with the rest of the file\n", path, offset);
+    return true;
+}
+
+//########## REPLAY ####################################################################################################
+
+static inline environment make_env(int bis, int es)
+{
+    environment env;
+    env.bis = bis;
+    env.es  = es;
+    return env;
+}
+
+// Label of a format : name of the FPU format, or width:exponent bits
+static void env_label(char* s, size_t size, environment env)
+{
+    int fmt = fpu_fmt_from_env(env);
+    if (fmt >= 0)
+        snprintf(s, size, "%s", fpu_fmt_name(fmt));
+    else
+        snprintf(s, size, "%d:%d", env.bis + 1, env.es + 1);
+}
+
+// Class of an encoding of the format env, read on the low bits of value
+static int operand_class(uint64_t value, environment env)
+{
+    int      width    = env.bis + 1;
+    int      exp_bits = env.es + 1;
+    int      man_bits = width - 1 - exp_bits;
+    uint64_t exp      = (value >> man_bits) & ((1ULL << exp_bits) - 1);
+    uint64_t man      = value & ((1ULL << man_bits) - 1);
+
+    if (exp == 0)
+        return man == 0 ? CLS_ZERO : CLS_SUBNORMAL;
+    if (exp != (1ULL << exp_bits) - 1)
+        return CLS_NORMAL;
+    if (man == 0)
+        return CLS_INF;
+    return (man >> (man_bits - 1)) ? CLS_QNAN : CLS_SNAN;
+}
+
+// Operands read by the operation of a record, bit k for operand_a, operand_b and imm. The additions of the opcode
+// entries read operand_b and imm.
+static int operand_mask(const fpu_trace_record* r)
+{
+    if (r->entry != FPU_STATS_DPI && (r->op == FPU_OP_FADD || r->op == FPU_OP_FSUB))
+        return 0x6;
+    return (1 << op_arity[r->op]) - 1;
+}
+
+static inline bool is_int_operand(int op)
+{
+    return op == FPU_OP_FCVT_I2F || op == FPU_OP_FMV_X2F;
+}
+
+static inline uint64_t sv_value(const svBitVecVal* v, int width)
+{
+    return width > 32 ? ((uint64_t) v[1] << 32) | v[0] : v[0];
+}
+
+static inline void sv_set(svBitVecVal* v, uint64_t value)
+{
+    v[0] = (uint32_t) value;
+    v[1] = (uint32_t) (value >> 32);
+}
+
+// Replay a per-operation record through its dpi_* entry, the result is read on the width recorded by fpu_trace
+static int replay_dpi(const fpu_trace_record* r, uint64_t* result)
+{
+    svBitVecVal a[2], b[2], c[2];
+    svBitVecVal res[4] = { 0, 0, 0, 0 };
+    env_t       dst = { (short) r->dst_bis, (char) r->dst_es };
+    env_t       src = { (short) r->src_bis, (char) r->src_es };
+    int         width = r->dst_bis + 1;
+    int         is_signed = r->aux & 1, int_format = (r->aux >> 1) & 1;
+    int         flags;
+
+    sv_set(a, r->operand_a);
+    sv_set(b, r->operand_b);
+    sv_set(c, r->imm);
+
+    switch (r->op)
+    {
+    case FPU_OP_FADD:     flags = dpi_fadd(res, a, b, r->rm, &dst);     break;
+    case FPU_OP_FSUB:     flags = dpi_fsub(res, a, b, r->rm, &dst);     break;
+    case FPU_OP_FMUL:     flags = dpi_fmul(res, a, b, r->rm, &dst);     break;
+    case FPU_OP_FDIV:     flags = dpi_fdiv(res, a, b, r->rm, &dst);     break;
+    case FPU_OP_FMADD:    flags = dpi_fma(res, a, b, c, r->rm, &dst);   break;
+    case FPU_OP_FMSUB:    flags = dpi_fms(res, a, b, c, r->rm, &dst);   break;
+    case FPU_OP_FNMADD:   flags = dpi_fnma(res, a, b, c, r->rm, &dst);  break;
+    case FPU_OP_FNMSUB:   flags = dpi_fnms(res, a, b, c, r->rm, &dst);  break;
+    case FPU_OP_FSQRT:    flags = dpi_fsqrt(res, a, r->rm, &dst);       break;
+    case FPU_OP_FMIN_MAX: flags = dpi_fmin_max(res, a, b, r->rm, &dst); break;
+    case FPU_OP_FSGNJ:    flags = dpi_fsgnj(res, a, b, r->rm, &dst);    break;
+    case FPU_OP_FCMP:
+        flags = dpi_fcmp(res, a, b, r->rm, &dst);
+        width = 32;
+        break;
+    case FPU_OP_FCLASS:
+        flags = dpi_fclass(res, a, &dst);
+        width = 32;
+        break;
+    case FPU_OP_FMV_F2X:
+        flags = dpi_fmv_f2x(res, a, &dst, r->aux);
+        width = 32 * r->aux;
+        break;
+    case FPU_OP_FCVT_F2I:
+        flags = dpi_fcvt_f2i(res, a, r->rm, &dst, is_signed, int_format);
+        width = int_format ? 64 : 32;
+        break;
+    case FPU_OP_FCVT_I2F:
+        flags = dpi_fcvt_i2f(res, a, r->rm, &dst, is_signed, int_format);
+        break;
+    case FPU_OP_FCVT_F2F:
+        flags = dpi_fcvt_f2f(res, a, r->rm, &src, &dst);
+        break;
+    default:
+        *result = 0;
+        return -1;
+    }
+    *result = sv_value(res, width);
+    return flags;
+}
+
+// Replay an opcode record with the backend, dpi_fpu_exec_all_rm records always go through fpu_exec_all_rm
+static int replay_exec(const fpu_trace_record* r, int backend, uint64_t* result)
+{
+    int xlen = 32 * (r->aux & 0xf);
+    int flen = 32 * (r->aux >> 4);
+
+    if (r->entry == FPU_STATS_EXEC_ALL_RM || (backend == BACKEND_ALL_RM && r->rm < FPU_RM_NUM))
+    {
+        fpu_all_rm_record all;
+        if (fpu_exec_all_rm(&all, r->op, r->operand_a, r->operand_b, r->imm, r->fmt, xlen, flen) == 0)
+        {
+            *result = all.result[r->rm];
+            return all.flags[r->rm];
+        }
+        // Not supported, or the operation does not round
+        if (r->entry == FPU_STATS_EXEC_ALL_RM)
+        {
+            *result = 0;
+            return -1;
+        }
+    }
+
+    if (backend == BACKEND_NATIVE)
+        return fpu_exec(result, r->op, r->operand_a, r->operand_b, r->imm, r->fmt, r->rm, xlen, flen);
+    return fpu_exec_compute(result, r->op, r->operand_a, r->operand_b, r->imm, r->fmt, r->rm, xlen, flen);
+}
+
+//########## DIFFERENCES ###############################################################################################
+
+// Group of the report
+typedef struct
+{
+    int         entry, op, rm;
+    environment dst, src;
+    int         cls[3];
+} group_key;
+
+static bool operator<(const group_key& x, const group_key& y)
+{
+    int kx[10] = { x.entry, x.op, x.dst.bis, x.dst.es, x.src.bis, x.src.es, x.rm, x.cls[0], x.cls[1], x.cls[2] };
+    int ky[10] = { y.entry, y.op, y.dst.bis, y.dst.es, y.src.bis, y.src.es, y.rm, y.cls[0], y.cls[1], y.cls[2] };
+    return std::lexicographical_compare(kx, kx + 10, ky, ky + 10);
+}
+
+typedef struct
+{
+    uint64_t         index;     /**< index of the record in the trace */
+    fpu_trace_record record;
+    uint64_t         result;    /**< result of the replay */
+    int              flags;
+} difference;
+
+typedef struct
+{
+    uint64_t                     records;
+    uint64_t                     differences;
+    uint64_t                     unsupported;   /**< records the model no longer supports, counted as differences */
+    std::map<group_key, uint64_t> groups;
+    std::vector<difference>      first;         /**< first differences of the worker, in record order */
+} worker_result;
+
+static group_key make_key(const fpu_trace_record* r)
+{
+    group_key key;
+    key.entry = r->entry;
+    key.op    = r->op;
+    key.rm    = r->rm;
+
+    // Source format and NaN-box check of the operands, as in fpu_exec
+    environment src;
+    uint64_t    box = 0;
+    if (r->entry == FPU_STATS_DPI)
+    {
+        key.dst = make_env(r->dst_bis, r->dst_es);
+        src     = make_env(r->src_bis, r->src_es);
+    }
+    else
+    {
+        int src_fmt = (r->op == FPU_OP_FCVT_F2F) ? (int) (r->imm & 0x7) : r->fmt;
+        int xlen    = 32 * (r->aux & 0xf);
+        key.dst = fpu_fmt_get_desc(r->fmt)->env;
+        src     = fpu_fmt_get_desc(src_fmt)->env;
+        if (src.bis + 1 < xlen && r->op != FPU_OP_FMV_F2X)
+            box = (xlen == 64 ? ~0ULL : (1ULL << xlen) - 1) & ~((1ULL << (src.bis + 1)) - 1);
+    }
+    key.src = src;
+
+    uint64_t operands[3] = { r->operand_a, r->operand_b, r->imm };
+    for (int k = 0; k < 3; k++)
+    {
+        if (r->op >= FPU_OP_NUM || !((operand_mask(r) >> k) & 1))
+            key.cls[k] = CLS_NONE;
+        else if (is_int_operand(r->op))
+            key.cls[k] = CLS_INT;
+        else if (src.bis == 0)
+            key.cls[k] = CLS_NONE;
+        else if ((operands[k] & box) != box)
+            key.cls[k] = CLS_UNBOXED;
+        else
+            key.cls[k] = operand_class(operands[k], src);
+    }
+    return key;
+}
+
+static void worker(const trace_map* t, int backend, size_t show, std::atomic<size_t>* next, worker_result* out)
+{
+    std::vector<fpu_trace_record> decoded(t->header->block_records);
+    bool compressed = t->header->flags & FPU_TRACE_COMPRESSED;
+
+    for (size_t k = (*next)++; k < t->blocks.size(); k = (*next)++)
+    {
+        fpu_trace_block b;
+        memcpy(&b, t->data + t->blocks[k].offset, sizeof(b));
+        const uint8_t*          payload = t->data + t->blocks[k].offset + sizeof(b);
+        const fpu_trace_record* records = (const fpu_trace_record*) payload;
+
+        b.nrecords = t->blocks[k].nrecords;
+        if (b.nrecords == 0)
+            continue;
+        if (compressed)
+        {
+            if (decoded.size() < b.nrecords)
+                decoded.resize(b.nrecords);
+            if (fpu_trace_decode(&decoded[0], b.nrecords, payload, b.nbytes) != 0)
+            {
+                fprintf(stderr, "block at offset %zu cannot be decoded, skipped\n", t->blocks[k].offset);
+                continue;
+            }
+            records = &decoded[0];
+        }
+
+        for (uint32_t i = 0; i < b.nrecords; i++)
+        {
+            const fpu_trace_record* r = &records[i];
+            uint64_t result = 0;
+            int      flags = (r->entry == FPU_STATS_DPI) ? replay_dpi(r, &result) : replay_exec(r, backend, &result);
+
+            out->records++;
+            if (flags == r->flags && (flags < 0 || result == r->result))
+                continue;
+
+            out->differences++;
+            if (flags < 0)
+                out->unsupported++;
+            out->groups[make_key(r)]++;
+            if (out->first.size() < show)
+            {
+                difference d = { t->blocks[k].first + i, *r, result, flags };
+                out->first.push_back(d);
+            }
+        }
+    }
+}
+
+//########## REPORT ####################################################################################################
+
+static void print_header(const fpu_trace_header* h)
+{
+    printf("trace  : %s, hash %016llx, MPFR %s, GMP %s, %s\n", h->model, (unsigned long long) h->model_hash, h->mpfr,
+           h->gmp, h->build);
+    printf("replay : %s, hash %016llx, MPFR %s, GMP %s\n", fpu_store_model_version(),
+           (unsigned long long) fpu_store_model_hash(), mpfr_get_version(), gmp_version);
+    if (h->model_hash != fpu_store_model_hash())
+        printf("         the model changed since the recording\n");
+}
+
+static void print_difference(const difference* d)
+{
+    const fpu_trace_record* r = &d->record;
+    char dst[16], src[16];
+
+    env_label(dst, sizeof(dst), r->entry == FPU_STATS_DPI ? make_env(r->dst_bis, r->dst_es) : fpu_fmt_get_desc(r->fmt)->env);
+    env_label(src, sizeof(src), make_env(r->src_bis, r->src_es));
+    printf("  #%llu %s %s %s%s%s rm %d : %016llx %016llx %016llx -> %016llx %02x, replay %016llx %02x"
+           " (trans_id %llu, time %llu, thread %u)\n",
+           (unsigned long long) d->index, entry_names[r->entry], fpu_op_name(r->op), r->entry == FPU_STATS_DPI &&
+           r->op == FPU_OP_FCVT_F2F ? src : "", r->entry == FPU_STATS_DPI && r->op == FPU_OP_FCVT_F2F ? ">" : "", dst,
+           r->rm, (unsigned long long) r->operand_a, (unsigned long long) r->operand_b, (unsigned long long) r->imm,
+           (unsigned long long) r->result, r->flags & 0xff, (unsigned long long) d->result, d->flags & 0xff,
+           (unsigned long long) r->trans_id, (unsigned long long) r->sim_time, r->thread);
+}
+
+static void print_groups(const std::map<group_key, uint64_t>& groups)
+{
+    std::vector<std::pair<uint64_t, group_key> > sorted;
+    for (std::map<group_key, uint64_t>::const_iterator it = groups.begin(); it != groups.end(); ++it)
+        sorted.push_back(std::make_pair(it->second, it->first));
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const std::pair<uint64_t, group_key>& x, const std::pair<uint64_t, group_key>& y) { return x.first > y.first; });
+
+    printf("\n%-10s %-10s %-13s %2s  %-8s %-8s %-8s %12s\n", "entry", "op", "fmt", "rm", "a", "b", "c", "differences");
+    for (size_t k = 0; k < sorted.size(); k++)
+    {
+        const group_key& g = sorted[k].second;
+        char dst[16], src[16], fmt[40];
+        env_label(dst, sizeof(dst), g.dst);
+        env_label(src, sizeof(src), g.src);
+        if (g.src.bis != g.dst.bis || g.src.es != g.dst.es)
+            snprintf(fmt, sizeof(fmt), "%s>%s", src, dst);
+        else
+            snprintf(fmt, sizeof(fmt), "%s", dst);
+        printf("%-10s %-10s %-13s %2d  %-8s %-8s %-8s %12llu\n", entry_names[g.entry], fpu_op_name(g.op), fmt, g.rm,
+               class_names[g.cls[0]], class_names[g.cls[1]], class_names[g.cls[2]], (unsigned long long) sorted[k].first);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int         backend = BACKEND_NATIVE;
+    int         threads = std::thread::hardware_concurrency();
+    long        show = DEFAULT_SHOW;
+    const char* path = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = val != NULL;
+
+        if (arg[0] != '-' && path == NULL)
+        {
+            path = arg;
+            continue;
+        }
+        if (ok && strcmp(arg, "--threads") == 0)
+            ok = (threads = atoi(val)) > 0;
+        else if (ok && strcmp(arg, "--show") == 0)
+            ok = (show = atol(val)) >= 0;
+        else if (ok && strcmp(arg, "--backend") == 0)
+        {
+            for (backend = 0; backend < BACKEND_NUM && strcmp(val, backend_names[backend]) != 0; backend++)
+                ;
+            ok = backend < BACKEND_NUM;
+        }
+        else
+            ok = false;
+
+        if (!ok)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+    if (path == NULL)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // The replayed dpi_* calls must not be recorded
+    fpu_trace_close();
+
+    threads = fpu_mpfr_threads(threads);
+
+    trace_map trace;
+    if (!trace_map_open(&trace, path))
+        return 2;
+    print_header(trace.header);
+
+    if ((size_t) threads > trace.blocks.size())
+        threads = trace.blocks.size() > 0 ? trace.blocks.size() : 1;
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    std::atomic<size_t>        next(0);
+    std::vector<worker_result> results(threads);
+    std::vector<std::thread>   pool;
+    for (int t = 1; t < threads; t++)
+        pool.push_back(std::thread(worker, &trace, backend, (size_t) show, &next, &results[t]));
+    worker(&trace, backend, show, &next, &results[0]);
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // Blocks are taken in file order, so the first differences of each worker hold the first ones of the trace
+    worker_result total = { 0, 0, 0, std::map<group_key, uint64_t>(), std::vector<difference>() };
+    for (int t = 0; t < threads; t++)
+    {
+        total.records     += results[t].records;
+        total.differences += results[t].differences;
+        total.unsupported += results[t].unsupported;
+        for (std::map<group_key, uint64_t>::const_iterator it = results[t].groups.begin(); it != results[t].groups.end(); ++it)
+            total.groups[it->first] += it->second;
+        total.first.insert(total.first.end(), results[t].first.begin(), results[t].first.end());
+    }
+    std::sort(total.first.begin(), total.first.end(), [](const difference& x, const difference& y) { return x.index < y.index; });
+    if (total.first.size() > (size_t) show)
+        total.first.resize(show);
+
+    printf("%llu records in %zu blocks, %llu differences (%llu unsupported), backend %s, %d threads, %.2f s, %.2f Mrec/s\n",
+           (unsigned long long) total.records, trace.blocks.size(), (unsigned long long) total.differences,
+           (unsigned long long) total.unsupported, backend_names[backend], threads, seconds,
+           seconds > 0 ? total.records / seconds / 1e6 : 0.0);
+    if (total.differences == 0)
+        return 0;
+
+    print_groups(total.groups);
+    if (!total.first.empty())
+        printf("\nfirst differences : #record entry op fmt rm : a b c -> recorded result flags, replay result flags\n");
+    for (size_t k = 0; k < total.first.size(); k++)
+        print_difference(&total.first[k]);
+    return 1;
+}
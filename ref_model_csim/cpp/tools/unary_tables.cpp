@@ -0,0 +1,197 @@
+/*
+ *  Copyright (c) 2025 CEA*
+ *  *Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+ *
+ *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+ *
+ *  Licensed under the Solderpad Hardware License v 2.1 (the “License”); you
+ *  may not use this file except in compliance with the License, or, at your
+ *  option, the Apache License version 2.0. You may obtain a copy of the
+ *  License at
+ *
+ *  https://solderpad.org/licenses/SHL-2.1/
+ *
+ *  Unless required by applicable law or agreed to in writing, any work
+ *  distributed under the License is distributed on an “AS IS” BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  License for the specific language governing permissions and limitations
+ *  under the License.
+ */
+/*
+ *  Authors       : agent
+ *  Creation Date : October, 2026
+ *  Description   : Check of the unary operation tables against MPFR and writer of the unary table file
+ *  History       :
+ */
+
+#include "fpu_unary_table.h"
+#include "intfp.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define MAX_REPORTED 20 /**< mismatches printed per table */
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [--input <file>] [--check] [--output <file>]\n", name);
+    printf("  --input <file>   load the tables from a file instead of building them\n");
+    printf("  --check          compare every entry of the tables with the model, and the square roots with intfp,\n");
+    printf("                   then the RMM results of the model with the RNE ones except on exact ties\n");
+    printf("  --output <file>  write the table file read through REFMODEL_UNARY_TABLES_FILE\n");
+}
+
+static long check_table(int src, int kind, int rm)
+{
+    const fpu_fmt_desc* desc = fpu_fmt_get_desc(src == UNARY_SRC_FP16 ? FPU_FMT_FP16 : src == UNARY_SRC_FP16ALT ? FPU_FMT_FP16ALT : FPU_FMT_FP8);
+    int n = 1 << desc->width;
+    long mismatches = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        uint64_t table_result, ref_result;
+        int table_flags, ref_flags;
+
+        fpu_unary_table_lookup(&table_result, &table_flags, src, kind, rm, i);
+        ref_flags = fpu_unary_table_compute(&ref_result, src, kind, rm, i);
+        bool ok = table_result == ref_result && table_flags == ref_flags;
+
+        // Independent check of the square roots computed by MPFR
+        if (kind == UNARY_SQRT)
+        {
+            uint64_t int_result;
+            int int_flags = intfp_sqrt(&int_result, i, rm, desc->env);
+            ok = ok && (ref_result & ((1ULL << desc->width) - 1)) == int_result && ref_flags == int_flags;
+        }
+
+        if (!ok && mismatches++ < MAX_REPORTED)
+            printf("  %s 0x%04x : table 0x%llx/0x%02x, model 0x%llx/0x%02x\n", fpu_unary_table_name(src, kind, rm), i,
+                   (unsigned long long) table_result, table_flags, (unsigned long long) ref_result, ref_flags);
+    }
+    return mismatches;
+}
+
+// Request of fpu_exec computing the operation of a table
+static void table_request(int src, int kind, int* op, int* fmt, uint64_t* imm)
+{
+    static const int dst_fmts[UNARY_F2I32 - UNARY_F2F_FP32] = { FPU_FMT_FP32, FPU_FMT_FP64, FPU_FMT_FP16, FPU_FMT_FP8, FPU_FMT_FP16ALT };
+    int src_fmt = src == UNARY_SRC_FP16 ? FPU_FMT_FP16 : src == UNARY_SRC_FP16ALT ? FPU_FMT_FP16ALT : FPU_FMT_FP8;
+
+    *imm = 0;
+    *fmt = src_fmt;
+    if (kind == UNARY_SQRT)
+        *op = FPU_OP_FSQRT;
+    else if (kind == UNARY_FCLASS)
+        *op = FPU_OP_FCLASS;
+    else if (kind < UNARY_F2I32)
+    {
+        // imm[2:0] is the source format
+        *op  = FPU_OP_FCVT_F2F;
+        *fmt = dst_fmts[kind - UNARY_F2F_FP32];
+        *imm = ~0x7ULL | src_fmt;
+    }
+    else
+    {
+        // imm[0] unsigned, imm[1] INT64
+        *op  = FPU_OP_FCVT_F2I;
+        *imm = ~0x3ULL | (kind - UNARY_F2I32);
+    }
+}
+
+// Every input in RMM, through fpu_exec against RNE, RDN and RUP, see fpu_exec_rmm_expected
+static long check_rmm(int src, int kind, const char* name)
+{
+    int op, fmt;
+    uint64_t imm;
+    table_request(src, kind, &op, &fmt, &imm);
+
+    int width = (src == UNARY_SRC_FP8) ? 8 : 16;
+    long mismatches = 0;
+
+    for (int i = 0; i < (1 << width); i++)
+    {
+        uint64_t a = ~((1ULL << width) - 1) | i;
+        uint64_t result, ref;
+        int flags     = fpu_exec_compute(&result, op, a, 0, imm, fmt, 4, 64, 64);
+        int ref_flags = fpu_exec_rmm_expected(&ref, op, a, 0, imm, fmt, 64, 64);
+
+        if ((result != ref || flags != ref_flags) && mismatches++ < MAX_REPORTED)
+            printf("  %s 0x%04x : model 0x%llx/0x%02x, expected 0x%llx/0x%02x\n", name, i,
+                   (unsigned long long) result, flags, (unsigned long long) ref, ref_flags);
+    }
+    return mismatches;
+}
+
+int main(int argc, char** argv)
+{
+    bool check = false;
+    const char* input  = NULL;
+    const char* output = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--check") == 0)
+            check = true;
+        else if (strcmp(argv[i], "--input") == 0 && i + 1 < argc)
+            input = argv[++i];
+        else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+            output = argv[++i];
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!check && output == NULL)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    fpu_unary_table_set_mode(UNARY_TABLE_LAZY);
+    if (input != NULL && fpu_unary_table_load(input) != 0)
+        return 1;
+
+    if (check)
+    {
+        long total = 0;
+        for (int src = 0; src < UNARY_SRC_NUM; src++)
+            for (int kind = 0; kind < UNARY_KIND_NUM; kind++)
+                for (int rm = 0; rm < FPU_UNARY_TABLE_RM_NUM; rm++)
+                {
+                    if (!fpu_unary_table_supported(src, kind, rm) || (kind == UNARY_FCLASS && rm != 0))
+                        continue;
+                    long mismatches = check_table(src, kind, rm);
+                    printf("%-24s %s\n", fpu_unary_table_name(src, kind, rm), mismatches ? "FAIL" : "ok");
+                    total += mismatches;
+                }
+        for (int src = 0; src < UNARY_SRC_NUM; src++)
+            for (int kind = 0; kind < UNARY_KIND_NUM; kind++)
+            {
+                if (kind == UNARY_FCLASS || !fpu_unary_table_supported(src, kind, 0))
+                    continue;
+                // Name of the RNE table with RMM, e.g. FP16.SQRT.RMM
+                const char* rne = fpu_unary_table_name(src, kind, 0);
+                char name[32];
+                snprintf(name, sizeof(name), "%.*sRMM", (int) strlen(rne) - 3, rne);
+
+                long mismatches = check_rmm(src, kind, name);
+                printf("%-24s %s\n", name, mismatches ? "FAIL" : "ok");
+                total += mismatches;
+            }
+        if (total != 0)
+        {
+            printf("Unary table check FAILED : %ld mismatches\n", total);
+            return 1;
+        }
+        printf("Unary table check passed\n");
+    }
+
+    if (output != NULL)
+    {
+        if (fpu_unary_table_save(output) != 0)
+            return 1;
+        printf("Unary tables written to %s\n", output);
+    }
+    return 0;
+}
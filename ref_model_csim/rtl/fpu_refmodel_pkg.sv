@@ -42,6 +42,86 @@ package fpu_refmodel_pkg;
         byte     es;  // Exponent size of floating point number
     } env_t;
 
+    // Operations of the reference model, must be kept in the same order as fpu_op_e in fpu_exec.h
+    typedef enum {
+        FPU_OP_FADD=0,
+        FPU_OP_FSUB,
+        FPU_OP_FMUL,
+        FPU_OP_FDIV,
+        FPU_OP_FMADD,
+        FPU_OP_FNMADD,
+        FPU_OP_FMSUB,
+        FPU_OP_FNMSUB,
+        FPU_OP_FCMP,
+        FPU_OP_FSQRT,
+        FPU_OP_FMIN_MAX,
+        FPU_OP_FSGNJ,
+        FPU_OP_FCVT_F2I,
+        FPU_OP_FCVT_I2F,
+        FPU_OP_FCVT_F2F,
+        FPU_OP_FCLASS,
+        FPU_OP_FMV_F2X,
+        FPU_OP_FMV_X2F,
+        FPU_OP_NUM
+    } fpu_op_e;
+
+    // Coverpoints of the coverage collector, must be kept in the same order as fpu_cov_point_e in fpu_cov.h
+    typedef enum {
+        FPU_COV_RM=0,
+        FPU_COV_SOURCES,
+        FPU_COV_RESULT,
+        FPU_COV_FLAGS,
+        FPU_COV_EXPONENT,
+        FPU_COV_ALIGNMENT,
+        FPU_COV_ROUNDING,
+        FPU_COV_POINT_NUM
+    } fpu_cov_point_e;
+
+    // Classes of the operands and results in the coverage bins, must be kept in the same order as fpu_cov_class_e
+    typedef enum {
+        FPU_COV_NEG_INF=0,
+        FPU_COV_NEG_NORMAL,
+        FPU_COV_NEG_SUBNORMAL,
+        FPU_COV_NEG_ZERO,
+        FPU_COV_POS_ZERO,
+        FPU_COV_POS_SUBNORMAL,
+        FPU_COV_POS_NORMAL,
+        FPU_COV_POS_INF,
+        FPU_COV_SNAN,
+        FPU_COV_QNAN,
+        FPU_COV_INT_ZERO,
+        FPU_COV_INT_POS,
+        FPU_COV_INT_NEG,
+        FPU_COV_INT_EXTREME,
+        FPU_COV_CLASS_NUM=16
+    } fpu_cov_class_e;
+
+    // Rounding events of the coverage bins, must be kept in the same order as fpu_cov_round_e
+    typedef enum {
+        FPU_COV_EXACT=0,
+        FPU_COV_INEXACT_EVEN,
+        FPU_COV_INEXACT_ODD,
+        FPU_COV_BINADE,
+        FPU_COV_MAX_FINITE,
+        FPU_COV_OVERFLOW_INF,
+        FPU_COV_MIN_NORMAL,
+        FPU_COV_TINY,
+        FPU_COV_ROUND_NUM
+    } fpu_cov_round_e;
+
+    localparam int FPU_COV_MAX_BINS = 4096; // Number of bins of the largest coverpoint, FPU_COV_SOURCES
+
+    // Properties of the exact result of the hard-case generator, must be kept in the same order as fpu_hard_e
+    typedef enum {
+        FPU_HARD_TIE=0,
+        FPU_HARD_ABOVE_TIE,
+        FPU_HARD_BELOW_TIE,
+        FPU_HARD_UNDERFLOW,
+        FPU_HARD_OVERFLOW,
+        FPU_HARD_CANCELLATION,
+        FPU_HARD_NUM
+    } fpu_hard_e;
+
   import uvm_pkg::*;
   import fpu_common_pkg::*;
   import ariane_pkg::*;
@@ -136,6 +216,158 @@ package fpu_refmodel_pkg;
                                            input  mpfr_rnd_e             rounding_mode,
                                            input  env_t                  src_env,
                                            input  env_t                  dst_env);
+
+  // Opcode-dispatched entry : NaN-box check, dispatch and result boxing are done by the C++ model.
+  // Returns the expected result, flags is set to the exception flags (-1 if not supported).
+  import "DPI-C" function longint dpi_fpu_exec(input  longint operation,
+                                               input  longint operand_a,
+                                               input  longint operand_b,
+                                               input  longint imm,
+                                               input  longint fmt,
+                                               input  longint rm,
+                                               input  int     xlen,
+                                               input  int     flen,
+                                               output int     flags);
+
+  // Evaluation of a request in every rounding mode, result[rm] and flags[rm] are indexed by the RTL rounding mode
+  // (RNE, RTZ, RDN, RUP, RMM). Returns -1, and flags set to -1, for operations whose rm field is not a rounding mode.
+  localparam int FPU_RM_NUM = 5;
+  import "DPI-C" function int dpi_fpu_exec_all_rm(input  longint operation,
+                                                  input  longint operand_a,
+                                                  input  longint operand_b,
+                                                  input  longint imm,
+                                                  input  longint fmt,
+                                                  input  int     xlen,
+                                                  input  int     flen,
+                                                  output longint result[FPU_RM_NUM],
+                                                  output int     flags[FPU_RM_NUM]);
+
+  // Result cache of the C++ model
+  import "DPI-C" function void    dpi_refmodel_cache_enable(input int entries);
+  import "DPI-C" function int     dpi_refmodel_cache_capacity();
+  import "DPI-C" function longint dpi_refmodel_cache_hits();
+  import "DPI-C" function longint dpi_refmodel_cache_misses();
+  import "DPI-C" function longint dpi_refmodel_cache_evictions();
+
+  // Persistent result store of the C++ model
+  import "DPI-C" function int     dpi_refmodel_store_open(input string path, input int entries);
+  import "DPI-C" function int     dpi_refmodel_store_enabled();
+  import "DPI-C" function longint dpi_refmodel_store_hits();
+  import "DPI-C" function longint dpi_refmodel_store_misses();
+  import "DPI-C" function longint dpi_refmodel_store_inserts();
+  import "DPI-C" function longint dpi_refmodel_store_evictions();
+
+  // Per-entry call statistics of the C++ model, dpi_refmodel_report prints them and writes them to json_path when
+  // it is not empty (returns -1 if it cannot be written)
+  import "DPI-C" function void    dpi_refmodel_stats_enable(input int enable);
+  import "DPI-C" function int     dpi_refmodel_stats_enabled();
+  import "DPI-C" function int     dpi_refmodel_report(input string json_path);
+
+  // Binary trace of the calls of the C++ model, dpi_refmodel_trace_context tags the next calls of the thread
+  import "DPI-C" function int     dpi_refmodel_trace_open(input string path, input int compress);
+  import "DPI-C" function void    dpi_refmodel_trace_close();
+  import "DPI-C" function void    dpi_refmodel_trace_context(input longint trans_id, input longint sim_time);
+
+  // Functional coverage of the evaluated requests. Queries take an operation, a format code and a coverpoint, -1
+  // selects every value. dpi_refmodel_cov_closure returns the percentage of the goals hit, dpi_refmodel_cov_next_unhit
+  // the first goal bin from bin on that was not hit, or -1. dpi_refmodel_cov_unhit returns the number of goals not hit,
+  // dpi_refmodel_cov_unhit_bins lists them for a single group and coverpoint and returns their number.
+  import "DPI-C" function int     dpi_refmodel_cov_open(input string path);
+  import "DPI-C" function void    dpi_refmodel_cov_enable(input int enable);
+  import "DPI-C" function int     dpi_refmodel_cov_enabled();
+  import "DPI-C" function int     dpi_refmodel_cov_save();
+  import "DPI-C" function int     dpi_refmodel_cov_load(input string path);
+  import "DPI-C" function real    dpi_refmodel_cov_closure(input int op, input int fmt, input int point);
+  import "DPI-C" function longint dpi_refmodel_cov_count(input int op, input int fmt, input int point, input int bin);
+  import "DPI-C" function int     dpi_refmodel_cov_next_unhit(input int op, input int fmt, input int point, input int bin);
+  import "DPI-C" function longint dpi_refmodel_cov_unhit(input int op, input int fmt, input int point);
+  import "DPI-C" function int     dpi_refmodel_cov_unhit_bins(input int op, input int fmt, input int point,
+                                                              output int bins[FPU_COV_MAX_BINS]);
+  import "DPI-C" function int     dpi_refmodel_cov_report(input string json_path);
+
+  // Operand generator of the fast generation mode of the sequences, see fpu_gen.h. Classes and mantissa configurations
+  // are indexed as fp_op_type_e and mant_cfg_e of fpu_txn, class 6 draws a corner value of the format.
+  import "DPI-C" function void    dpi_fpu_gen_seed(input longint seed);
+  import "DPI-C" function void    dpi_fpu_gen_weights(input int class_w[7], input int mant_w[5], input int int_w[2]);
+  import "DPI-C" function longint dpi_fpu_gen_float(input env_t env);
+  import "DPI-C" function longint dpi_fpu_gen_float_of(input env_t env, input int cls, input int mant);
+  import "DPI-C" function longint dpi_fpu_gen_corner(input env_t env, input int corner);
+  import "DPI-C" function longint dpi_fpu_gen_int();
+
+  // Hard-case generator, see fpu_hard.h : request fields of FADD, FSUB, FMUL, FDIV, the fused operations and FSQRT
+  // whose exact result has the property hard, drawn from the sequence of the operand generator. Returns -1 for the
+  // other operations.
+  import "DPI-C" function int     dpi_fpu_hard_operands(input  int     op,
+                                                        input  env_t   env,
+                                                        input  int     hard,
+                                                        output longint operand_a,
+                                                        output longint operand_b,
+                                                        output longint imm);
+
+  // Golden-vector files written by tools/golden_gen, see fpu_golden.h. dpi_fpu_golden_open maps a file generated for
+  // xlen and flen, it returns 1 if the file was generated by another version of the model and -1 if it cannot be
+  // mapped. dpi_fpu_golden_request returns the request fields of a record (op is a fpu_op_e), dpi_fpu_golden_expected
+  // its expected response, both return -1 if index is out of range.
+  import "DPI-C" function int     dpi_fpu_golden_open(input string path, input int xlen, input int flen);
+  import "DPI-C" function void    dpi_fpu_golden_close();
+  import "DPI-C" function longint dpi_fpu_golden_count();
+  import "DPI-C" function int     dpi_fpu_golden_request(input  longint index,
+                                                         output int     op,
+                                                         output longint operand_a,
+                                                         output longint operand_b,
+                                                         output longint imm,
+                                                         output int     fmt,
+                                                         output int     rm,
+                                                         output int     delay);
+  import "DPI-C" function int     dpi_fpu_golden_expected(input  longint index,
+                                                          output longint result,
+                                                          output int     flags);
+
+  // Recorded streams of driven transactions, golden-vector files without expectations. dpi_fpu_golden_recorded
+  // returns 1 if the mapped file is a recorded stream, dpi_fpu_golden_trans_id the transaction id of a record (-1 if
+  // index is out of range).
+  import "DPI-C" function int     dpi_fpu_golden_recorded();
+  import "DPI-C" function longint dpi_fpu_golden_trans_id(input longint index);
+  import "DPI-C" function int     dpi_fpu_golden_record_open(input string path, input int xlen, input int flen);
+  import "DPI-C" function void    dpi_fpu_golden_record(input int     op,
+                                                        input longint operand_a,
+                                                        input longint operand_b,
+                                                        input longint imm,
+                                                        input int     fmt,
+                                                        input int     rm,
+                                                        input longint trans_id,
+                                                        input int     delay);
+  import "DPI-C" function void    dpi_fpu_golden_record_close();
+
+  // Novelty filter of the verified requests, see fpu_novelty.h. dpi_fpu_novelty_resample returns 1 if a drawn
+  // request was already verified (by this or an earlier simulation) and must be drawn again, with a probability of
+  // percent %. dpi_fpu_novelty_insert records a request whose response matched the model and returns 1 if it was new.
+  import "DPI-C" function int     dpi_refmodel_novelty_open(input string path, input longint entries);
+  import "DPI-C" function int     dpi_refmodel_novelty_enabled();
+  import "DPI-C" function int     dpi_fpu_novelty_resample(input int     op,
+                                                           input longint operand_a,
+                                                           input longint operand_b,
+                                                           input longint imm,
+                                                           input int     fmt,
+                                                           input int     rm,
+                                                           input int     xlen,
+                                                           input int     flen,
+                                                           input int     percent);
+  import "DPI-C" function int     dpi_fpu_novelty_insert(input int     op,
+                                                         input longint operand_a,
+                                                         input longint operand_b,
+                                                         input longint imm,
+                                                         input int     fmt,
+                                                         input int     rm,
+                                                         input int     xlen,
+                                                         input int     flen);
+  import "DPI-C" function longint dpi_refmodel_novelty_lookups();
+  import "DPI-C" function longint dpi_refmodel_novelty_hits();
+  import "DPI-C" function longint dpi_refmodel_novelty_resamples();
+  import "DPI-C" function longint dpi_refmodel_novelty_inserts();
+  import "DPI-C" function longint dpi_refmodel_novelty_novel();
+  import "DPI-C" function longint dpi_refmodel_novelty_count();
+  import "DPI-C" function real    dpi_refmodel_novelty_fill();
   
     
 endpackage
\ No newline at end of file
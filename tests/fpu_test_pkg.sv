@@ -44,6 +44,9 @@ package fpu_test_pkg;
   `include "fpu_fmt_single_op_test.svh"
   `include "fpu_fmt_op_group_test.svh"
   `include "fpu_fmt_random_test.svh"
+  `include "fpu_hard_case_test.svh"
+  `include "fpu_golden_test.svh"
+  `include "fpu_replay_test.svh"
 
 endpackage: fpu_test_pkg
 